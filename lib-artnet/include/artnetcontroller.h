@@ -41,6 +41,14 @@
 #define DMX_MAX_VALUE 255
 #endif
 
+namespace artnet {
+namespace controller {
+static constexpr uint32_t KEEP_ALIVE_MIN_MILLIS = 100;
+static constexpr uint32_t KEEP_ALIVE_DEFAULT_MILLIS = 1000;
+static constexpr uint32_t KEEP_ALIVE_MAX_MILLIS = 4000;
+}  // namespace controller
+}  // namespace artnet
+
 struct TArtNetController {
 	uint32_t nIPAddressLocal;
 	uint32_t nIPAddressBroadcast;
@@ -80,6 +88,38 @@ public:
 		return m_bUnicast;
 	}
 
+	/**
+	 * Send only the slots given to HandleDmxOut, padded to an even length.
+	 */
+	void SetLengthExact(bool bLengthExact) {
+		m_bLengthExact = bLengthExact;
+	}
+	bool GetLengthExact() const {
+		return m_bLengthExact;
+	}
+
+	/**
+	 * Send a universe only when its data has changed,
+	 * unchanged universes are refreshed every nKeepAliveMillis.
+	 */
+	void SetChangedOnly(bool bChangedOnly) {
+		m_bChangedOnly = bChangedOnly;
+	}
+	bool GetChangedOnly() const {
+		return m_bChangedOnly;
+	}
+
+	void SetKeepAlive(uint32_t nKeepAliveMillis = artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS) {
+		if ((nKeepAliveMillis >= artnet::controller::KEEP_ALIVE_MIN_MILLIS) && (nKeepAliveMillis <= artnet::controller::KEEP_ALIVE_MAX_MILLIS)) {
+			m_nKeepAliveMillis = nKeepAliveMillis;
+		} else {
+			m_nKeepAliveMillis = artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS;
+		}
+	}
+	uint32_t GetKeepAlive() const {
+		return m_nKeepAliveMillis;
+	}
+
 	void SetMaster(uint32_t nMaster = DMX_MAX_VALUE) {
 		if (nMaster < DMX_MAX_VALUE) {
 			m_nMaster = nMaster;
@@ -109,13 +149,18 @@ private:
 	void HandlePoll();
 	void HandlePollReply();
 	void HandleTrigger();
-	void ActiveUniversesAdd(uint16_t nUniverse);
+	uint32_t ActiveUniversesAdd(uint16_t nUniverse);
+	uint16_t SetDmxLength(uint32_t nLength);
+	bool IsDmxUnchanged(uint32_t nActiveIndex, uint32_t nLength);
 	void ActiveUniversesClear();
 
 private:
 	struct TArtNetController m_tArtNetController;
 	bool m_bSynchronization { true };
 	bool m_bUnicast { true };
+	bool m_bLengthExact { false };
+	bool m_bChangedOnly { false };
+	uint32_t m_nKeepAliveMillis { artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS };
 	int32_t m_nHandle { -1 };
 	struct TArtNetPacket *m_pArtNetPacket;
 	struct TArtPoll m_ArtNetPoll;
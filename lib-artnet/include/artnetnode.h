@@ -43,6 +43,7 @@
 #include "artnet4handler.h"
 
 #include "lightset.h"
+#include "lightsetuniverseindex.h"
 #include "ledblink.h"
 
 namespace artnetnode {
@@ -60,6 +61,7 @@ static_assert((PAGE_SIZE == 4) || (PAGE_SIZE == 1) , "ARTNET_PAGE_SIZE");
 
 static constexpr uint32_t PAGES = ((LIGHTSET_PORTS + (PAGE_SIZE - 1)) / PAGE_SIZE);
 static constexpr auto MAX_PORTS = PAGE_SIZE * PAGES > LIGHTSET_PORTS ? LIGHTSET_PORTS : PAGE_SIZE * PAGES;
+static constexpr uint32_t RDM_INCREMENTAL_DISCOVERY_MILLIS = 30 * 1000;	///< When enabled with AtcIncOn
 
 enum class FailSafe : uint8_t {
 	LAST = 0x08, OFF= 0x09, ON = 0x0a, PLAYBACK = 0x0b, RECORD = 0x0c
@@ -149,6 +151,7 @@ struct OutputPort {
 	Source sourceB;
 	lightset::MergeMode mergeMode;
 	bool isRdmEnabled;
+	bool isRdmIncremental;			///< ArtTodControl AtcIncOn
 	artnet::PortProtocol protocol;	///< Art-Net 4
 	bool IsDataPending;				///< ArtDMX received and waiting for ArtSync
 	bool IsTransmitting;
@@ -253,11 +256,12 @@ public:
 	bool GetPortAddress(uint32_t nPortIndex, uint16_t& nAddress, lightset::PortDir dir) const;
 
 	bool GetOutputPort(const uint16_t nUniverse, uint32_t& nPortIndex) {
-		for (nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
-			if (!m_OutputPort[nPortIndex].genericPort.bIsEnabled) {
-				continue;
-			}
-			if ((m_OutputPort[nPortIndex].protocol == artnet::PortProtocol::ARTNET) && (nUniverse == m_OutputPort[nPortIndex].genericPort.nPortAddress)) {
+		uint32_t nBegin, nEnd;
+		m_OutputPortIndex.Find(nUniverse, nBegin, nEnd);
+
+		for (auto nEntry = nBegin; nEntry < nEnd; nEntry++) {
+			nPortIndex = m_OutputPortIndex.GetPortIndex(nEntry);
+			if (m_OutputPort[nPortIndex].protocol == artnet::PortProtocol::ARTNET) {
 				return true;
 			}
 		}
@@ -369,6 +373,7 @@ private:
 #endif
 
 	void GetType();
+	void HandlePacket(uint16_t nBytesReceived);
 
 	void HandlePoll();
 	void HandleDmx();
@@ -379,11 +384,21 @@ private:
 	void HandleTodRequest();
 	void HandleTodControl();
 	void HandleRdm();
+	void RdmCompleted(uint32_t nPortIndex, const uint8_t *pRdmResponse, uint32_t nIPAddress, bool bIsIdle);
+	static void StaticRdmCompleted(uint32_t nPortIndex, const uint8_t *pRdmResponse, uint32_t nIPAddress, bool bIsIdle) {
+		s_pThis->RdmCompleted(nPortIndex, pRdmResponse, nIPAddress, bIsIdle);
+	}
+	void RdmDiscoveryFinished(uint32_t nPortIndex, bool bIsTodChanged, bool bIsIdle);
+	static void StaticRdmDiscoveryFinished(uint32_t nPortIndex, bool bIsTodChanged, bool bIsIdle) {
+		s_pThis->RdmDiscoveryFinished(nPortIndex, bIsTodChanged, bIsIdle);
+	}
+	void RdmIncrementalDiscovery();
 	void HandleIpProg();
 	void HandleDmxIn();
 	void HandleTrigger();
 
 	uint16_t MakePortAddress(uint16_t nUniverse, uint32_t nPage);
+	void UpdateOutputPortIndex();
 
 	void UpdateMergeStatus(uint32_t nPortIndex);
 	void CheckMergeTimeouts(uint32_t nPortIndex);
@@ -418,6 +433,7 @@ private:
 
 	uint32_t m_nCurrentPacketMillis { 0 };
 	uint32_t m_nPreviousPacketMillis { 0 };
+	uint32_t m_nRdmIncrementalMillis { 0 };
 
 	bool m_IsRdmResponder { false };
 
@@ -427,6 +443,7 @@ private:
 	artnetnode::State m_State;
 	artnetnode::OutputPort m_OutputPort[artnetnode::MAX_PORTS];
 	artnetnode::InputPort m_InputPort[artnetnode::MAX_PORTS];
+	lightset::UniverseIndex<artnetnode::MAX_PORTS> m_OutputPortIndex;	///< Enabled output ports by Port-Address
 
 	static ArtNetNode *s_pThis;
 };
@@ -41,7 +41,8 @@ enum TArtNetPollInterval {
 enum TArtNetPollTableSizes {
 	ARTNET_POLL_TABLE_SIZE_ENRIES = 255,
 	ARTNET_POLL_TABLE_SIZE_NODE_UNIVERSES = 64,
-	ARTNET_POLL_TABLE_SIZE_UNIVERSES = 512
+	ARTNET_POLL_TABLE_SIZE_UNIVERSES = 512,
+	ARTNET_POLL_TABLE_POOL_INITIAL = 64	///< IP addresses, the pool grows when needed
 };
 
 struct TArtNetNodeEntryUniverse {
@@ -58,6 +59,10 @@ struct TArtNetNodeEntry {
 	struct TArtNetNodeEntryUniverse Universe[ARTNET_POLL_TABLE_SIZE_NODE_UNIVERSES];
 };
 
+/**
+ * The subscribers of a universe. pIpAddresses points into the shared IP address pool,
+ * it is valid until the next ArtNetPollTable::Add or ArtNetPollTable::Clean.
+ */
 struct TArtNetPollTableUniverses {
 	uint16_t nUniverse;
 	uint16_t nCount;
@@ -88,14 +93,19 @@ public:
 	void DumpTableUniverses();
 
 private:
+	uint32_t FindUniverse(uint16_t nUniverse, bool& bFound) const;
+	void GrowIpPool();
 	void ProcessUniverse(uint32_t nIpAddress, uint16_t nUniverse);
 	void RemoveIpAddress(uint16_t nUniverse, uint32_t nIpAddress);
 
 private:
 	TArtNetNodeEntry *m_pPollTable;
 	uint32_t m_nPollTableEntries{0};
-	TArtNetPollTableUniverses *m_pTableUniverses;
+	TArtNetPollTableUniverses *m_pTableUniverses;	///< Sorted by universe
 	uint32_t m_nTableUniversesEntries{0};
+	uint32_t *m_pIpPool;							///< The subscribers, grouped per universe in m_pTableUniverses order
+	uint32_t m_nIpPoolSize{ARTNET_POLL_TABLE_POOL_INITIAL};
+	uint32_t m_nIpPoolEntries{0};
 	TArtNetPollTableClean m_tTableClean;
 };
 
@@ -33,6 +33,16 @@
 
 class ArtNetRdm {
 public:
+	/**
+	 * pRdmResponse is nullptr when there is no response.
+	 * bIsIdle is true when there are no more pending requests for the port.
+	 */
+	typedef void (*RdmCompleted)(uint32_t nPortIndex, const uint8_t *pRdmResponse, uint32_t nIPAddress, bool bIsIdle);
+	/**
+	 * bIsTodChanged is true when UIDs were added or removed.
+	 */
+	typedef void (*DiscoveryFinished)(uint32_t nPortIndex, bool bIsTodChanged, bool bIsIdle);
+
 	virtual ~ArtNetRdm() {}
 
 	virtual void Full(uint32_t nPortIndex)=0;
@@ -40,6 +50,38 @@ public:
 	virtual void Copy(uint32_t nPortIndex, uint8_t *)=0;
 
 	virtual const uint8_t *Handler(uint32_t nPortIndex, const uint8_t *)=0;
+
+	/**
+	 * Asynchronous transactions, driven by Run().
+	 * Returns false when not supported, the caller then uses Handler.
+	 */
+	virtual bool Request(__attribute__((unused)) uint32_t nPortIndex, __attribute__((unused)) const uint8_t *pRdmData, __attribute__((unused)) uint32_t nIPAddress) {
+		return false;
+	}
+
+	/**
+	 * Background discovery, driven by Run().
+	 * Returns false when not supported, the caller then uses Full.
+	 */
+	virtual bool Discovery(__attribute__((unused)) uint32_t nPortIndex, __attribute__((unused)) bool bIncremental) {
+		return false;
+	}
+
+	virtual void DiscoveryStop(__attribute__((unused)) uint32_t nPortIndex) {}
+
+	virtual void Run() {}
+
+	void SetRdmCompleted(RdmCompleted pRdmCompleted) {
+		m_pRdmCompleted = pRdmCompleted;
+	}
+
+	void SetDiscoveryFinished(DiscoveryFinished pDiscoveryFinished) {
+		m_pDiscoveryFinished = pDiscoveryFinished;
+	}
+
+protected:
+	RdmCompleted m_pRdmCompleted { nullptr };
+	DiscoveryFinished m_pDiscoveryFinished { nullptr };
 };
 
 #endif /* ARTNETRDM_H_ */
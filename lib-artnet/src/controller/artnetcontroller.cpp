@@ -45,6 +45,31 @@
 
 static uint16_t s_ActiveUniverses[ARTNET_POLL_TABLE_SIZE_UNIVERSES] __attribute__ ((aligned (4)));
 
+struct ActiveUniverseState {
+	uint32_t nHash;
+	uint32_t nLastSendMillis;
+	uint16_t nLength;
+	bool bSent;
+};
+
+static ActiveUniverseState s_ActiveUniversesState[ARTNET_POLL_TABLE_SIZE_UNIVERSES];
+
+static constexpr uint32_t ACTIVE_UNIVERSES_FULL = ARTNET_POLL_TABLE_SIZE_UNIVERSES;	///< Returned by ActiveUniversesAdd
+
+/**
+ * FNV-1a, seeded with the length
+ */
+static uint32_t hash(const uint8_t *pData, uint32_t nLength) {
+	uint32_t nHash = 2166136261U ^ nLength;
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		nHash ^= pData[i];
+		nHash *= 16777619U;
+	}
+
+	return nHash;
+}
+
 ArtNetController *ArtNetController::s_pThis;
 
 using namespace artnet;
@@ -121,21 +146,16 @@ void ArtNetController::Stop() {
 
 void ArtNetController::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData, uint32_t nLength, uint8_t nPortIndex) {
 	DEBUG_ENTRY
+	assert(nLength <= artnet::DMX_LENGTH);
 
-	ActiveUniversesAdd(nUniverse);
+	const auto nActiveIndex = ActiveUniversesAdd(nUniverse);
+
+	if (__builtin_expect((nActiveIndex != ACTIVE_UNIVERSES_FULL), 1)) {
+		s_ActiveUniversesState[nActiveIndex].nLength = static_cast<uint16_t>(nLength);
+	}
 
 	m_pArtDmx->Physical = nPortIndex & 0xFF;
 	m_pArtDmx->PortAddress = nUniverse;
-	m_pArtDmx->LengthHi = static_cast<uint8_t>((nLength & 0xFF00) >> 8);
-	m_pArtDmx->Length = static_cast<uint8_t>(nLength & 0xFF);
-
-	// The sequence number is used to ensure that ArtDmx packets are used in the correct order.
-	// This field is incremented in the range 0x01 to 0xff to allow the receiving node to resequence packets.
-	m_pArtDmx->Sequence++;
-
-	if (m_pArtDmx->Sequence == 0) {
-		m_pArtDmx->Sequence = 1;
-	}
 
 	if (__builtin_expect((m_nMaster == DMX_MAX_VALUE), 1)) {
 		memcpy(m_pArtDmx->Data, pDmxData, nLength);
@@ -147,6 +167,8 @@ void ArtNetController::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData,
 		}
 	}
 
+	const auto nSize = SetDmxLength(nLength);
+
 	uint32_t nCount = 0;
 	auto IpAddresses = const_cast<struct TArtNetPollTableUniverses*>(GetIpAddress(nUniverse));
 
@@ -159,11 +181,24 @@ void ArtNetController::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData,
 		}
 	}
 
+	if (m_bChangedOnly && (nActiveIndex != ACTIVE_UNIVERSES_FULL) && IsDmxUnchanged(nActiveIndex, nLength)) {
+		DEBUG_EXIT
+		return;
+	}
+
+	// The sequence number is used to ensure that ArtDmx packets are used in the correct order.
+	// This field is incremented in the range 0x01 to 0xff to allow the receiving node to resequence packets.
+	m_pArtDmx->Sequence++;
+
+	if (m_pArtDmx->Sequence == 0) {
+		m_pArtDmx->Sequence = 1;
+	}
+
 	// If the number of universe subscribers exceeds 40 for a given universe, the transmitting device may broadcast.
 
 	if (m_bUnicast && (nCount <= 40)) {
 		for (uint32_t nIndex = 0; nIndex < nCount; nIndex++) {
-			Network::Get()->SendTo(m_nHandle, m_pArtDmx, sizeof(struct TArtDmx), IpAddresses->pIpAddresses[nIndex], artnet::UDP_PORT);
+			Network::Get()->SendTo(m_nHandle, m_pArtDmx, nSize, IpAddresses->pIpAddresses[nIndex], artnet::UDP_PORT);
 		}
 
 		m_bDmxHandled = true;
@@ -173,7 +208,7 @@ void ArtNetController::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData,
 	}
 
 	if (!m_bUnicast || (nCount > 40)) {
-		Network::Get()->SendTo(m_nHandle, m_pArtDmx, sizeof(struct TArtDmx), m_tArtNetController.nIPAddressBroadcast, artnet::UDP_PORT);
+		Network::Get()->SendTo(m_nHandle, m_pArtDmx, nSize, m_tArtNetController.nIPAddressBroadcast, artnet::UDP_PORT);
 
 		m_bDmxHandled = true;
 	}
@@ -189,14 +224,22 @@ void ArtNetController::HandleSync() {
 }
 
 void ArtNetController::HandleBlackout() {
-	m_pArtDmx->LengthHi = (512 & 0xFF00) >> 8;
-	m_pArtDmx->Length = (512 & 0xFF);
+	memset(m_pArtDmx->Data, 0, artnet::DMX_LENGTH);
 
-	memset(m_pArtDmx->Data, 0, 512);
+	const auto nCurrentMillis = Hardware::Get()->Millis();
 
 	for (uint32_t nIndex = 0; nIndex < m_nActiveUniverses; nIndex++) {
 		m_pArtDmx->PortAddress = s_ActiveUniverses[nIndex];
 
+		auto& state = s_ActiveUniversesState[nIndex];
+		const auto nSize = SetDmxLength(m_bLengthExact ? state.nLength : artnet::DMX_LENGTH);
+
+		if (m_bChangedOnly) {
+			// The nodes are now holding zeros, an all zero frame does not need to be sent again.
+			state.nHash = hash(m_pArtDmx->Data, state.nLength);
+			state.nLastSendMillis = nCurrentMillis;
+		}
+
 		uint32_t nCount = 0;
 		const auto *IpAddresses = GetIpAddress(s_ActiveUniverses[nIndex]);
 
@@ -218,7 +261,7 @@ void ArtNetController::HandleBlackout() {
 			}
 
 			for (uint32_t nIndex = 0; nIndex < nCount; nIndex++) {
-				Network::Get()->SendTo(m_nHandle, m_pArtDmx, sizeof(struct TArtDmx), IpAddresses->pIpAddresses[nIndex], artnet::UDP_PORT);
+				Network::Get()->SendTo(m_nHandle, m_pArtDmx, nSize, IpAddresses->pIpAddresses[nIndex], artnet::UDP_PORT);
 			}
 
 			continue;
@@ -233,7 +276,7 @@ void ArtNetController::HandleBlackout() {
 				m_pArtDmx->Sequence = 1;
 			}
 
-			Network::Get()->SendTo(m_nHandle, m_pArtDmx, sizeof(struct TArtDmx), m_tArtNetController.nIPAddressBroadcast, artnet::UDP_PORT);
+			Network::Get()->SendTo(m_nHandle, m_pArtDmx, nSize, m_tArtNetController.nIPAddressBroadcast, artnet::UDP_PORT);
 		}
 
 	}
@@ -317,62 +360,103 @@ void ArtNetController::Run() {
 
 void ArtNetController::ActiveUniversesClear() {
 	memset(s_ActiveUniverses, 0, sizeof(s_ActiveUniverses));
+	memset(s_ActiveUniversesState, 0, sizeof(s_ActiveUniversesState));
 	m_nActiveUniverses = 0;
 }
 
-void ArtNetController::ActiveUniversesAdd(uint16_t nUniverse) {
-	DEBUG_ENTRY
-	DEBUG_PRINTF("nUniverse=%d", static_cast<int>(nUniverse));
-
-	int32_t nLow = 0;
-	int32_t nMid = 0;
-	auto nHigh = static_cast<int32_t>(m_nActiveUniverses);
-
-	if (m_nActiveUniverses == (sizeof(s_ActiveUniverses) / sizeof(s_ActiveUniverses[0]))) {
-		assert(0);
-		return;
-	}
-
-	while (nLow <= nHigh) {
+/**
+ * Returns the index of nUniverse in the sorted s_ActiveUniverses,
+ * the universe is inserted when it is not active yet.
+ * Returns ACTIVE_UNIVERSES_FULL when the table is full, the universe is then sent without being tracked.
+ */
+uint32_t ArtNetController::ActiveUniversesAdd(uint16_t nUniverse) {
+	uint32_t nLow = 0;
+	auto nHigh = m_nActiveUniverses;
 
-		nMid = nLow + ((nHigh - nLow) / 2);
-		const uint32_t nMidValue = s_ActiveUniverses[nMid];
+	while (nLow < nHigh) {
+		const auto nMid = nLow + ((nHigh - nLow) / 2);
+		const auto nMidValue = s_ActiveUniverses[nMid];
 
 		if (nMidValue < nUniverse) {
 			nLow = nMid + 1;
 		} else if (nMidValue > nUniverse) {
-			nHigh = nMid - 1;
+			nHigh = nMid;
 		} else {
-			DEBUG_EXIT
-			return;
+			return nMid;
 		}
 	}
 
-	DEBUG_PRINTF("nLow=%d, nMid=%d, nHigh=%d", nLow, nMid, nHigh);
+	if (m_nActiveUniverses == (sizeof(s_ActiveUniverses) / sizeof(s_ActiveUniverses[0]))) {
+		DEBUG_PUTS("Active universes table is full");
+		return ACTIVE_UNIVERSES_FULL;
+	}
+
+	DEBUG_PRINTF("nUniverse=%u, nLow=%u", nUniverse, nLow);
 
-	if ((nHigh != -1) && (m_nActiveUniverses != static_cast<uint32_t>(nHigh))) {
+	const auto nMove = m_nActiveUniverses - nLow;
 
-		auto p16 = reinterpret_cast<uint16_t*>(s_ActiveUniverses);
+	memmove(&s_ActiveUniverses[nLow + 1], &s_ActiveUniverses[nLow], nMove * sizeof(s_ActiveUniverses[0]));
+	memmove(&s_ActiveUniversesState[nLow + 1], &s_ActiveUniversesState[nLow], nMove * sizeof(s_ActiveUniversesState[0]));
 
-		assert(nLow >= 0);
+	s_ActiveUniverses[nLow] = nUniverse;
+	s_ActiveUniversesState[nLow].nLastSendMillis = 0;
+	s_ActiveUniversesState[nLow].nHash = 0;
+	s_ActiveUniversesState[nLow].nLength = 0;
+	s_ActiveUniversesState[nLow].bSent = false;
+
+	m_nActiveUniverses++;
+
+	return nLow;
+}
 
-		//TODO Can we make i unsigned ?
-		for (uint32_t i = m_nActiveUniverses; i >= static_cast<uint32_t>(nLow); i--) {
-			p16[i + 1] = p16[i];
+/**
+ * Sets the ArtDmx length fields and returns the number of bytes to send.
+ * In length exact mode only the slots are sent, padded to an even length (2 - 512).
+ */
+uint16_t ArtNetController::SetDmxLength(uint32_t nLength) {
+	if (!m_bLengthExact) {
+		m_pArtDmx->LengthHi = static_cast<uint8_t>((nLength & 0xFF00) >> 8);
+		m_pArtDmx->Length = static_cast<uint8_t>(nLength & 0xFF);
+		return sizeof(struct TArtDmx);
+	}
+
+	if (nLength < 2) {
+		m_pArtDmx->Data[1] = 0;
+		if (nLength == 0) {
+			m_pArtDmx->Data[0] = 0;
 		}
+		nLength = 2;
+	} else if ((nLength & 0x1) == 0x1) {
+		m_pArtDmx->Data[nLength] = 0;
+		nLength++;
+	}
 
-		s_ActiveUniverses[nLow] = nUniverse;
+	m_pArtDmx->LengthHi = static_cast<uint8_t>((nLength & 0xFF00) >> 8);
+	m_pArtDmx->Length = static_cast<uint8_t>(nLength & 0xFF);
 
-		DEBUG_PRINTF(">m< nUniverse=%u, nLow=%d", nUniverse, nLow);
-	} else {
-		s_ActiveUniverses[m_nActiveUniverses] = nUniverse;
+	return static_cast<uint16_t>(sizeof(struct TArtDmx) - artnet::DMX_LENGTH + nLength);
+}
 
-		DEBUG_PRINTF(">a< nUniverse=%u, nMid=%d", nUniverse, nMid);
+/**
+ * Changed only mode: true when the data equals the data last sent for this universe
+ * and the keep-alive interval has not expired.
+ * A hash collision delays the update until the next keep-alive.
+ */
+bool ArtNetController::IsDmxUnchanged(uint32_t nActiveIndex, uint32_t nLength) {
+	auto& state = s_ActiveUniversesState[nActiveIndex];
+
+	const auto nHash = hash(m_pArtDmx->Data, nLength);
+	const auto nCurrentMillis = Hardware::Get()->Millis();
+
+	if (state.bSent && (state.nHash == nHash) && ((nCurrentMillis - state.nLastSendMillis) < m_nKeepAliveMillis)) {
+		return true;
 	}
 
-	m_nActiveUniverses++;
+	state.nHash = nHash;
+	state.nLastSendMillis = nCurrentMillis;
+	state.bSent = true;
 
-	DEBUG_EXIT
+	return false;
 }
 
 void ArtNetController::Print() {
@@ -385,4 +469,10 @@ void ArtNetController::Print() {
 	if (!m_bSynchronization) {
 		puts(" Synchronization is disabled");
 	}
+	if (m_bLengthExact) {
+		puts(" Length exact");
+	}
+	if (m_bChangedOnly) {
+		printf(" Changed only, keep-alive %u ms\n", m_nKeepAliveMillis);
+	}
 }
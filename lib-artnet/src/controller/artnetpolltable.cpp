@@ -63,10 +63,8 @@ ArtNetPollTable::ArtNetPollTable() {
 
 	memset(m_pTableUniverses, 0, sizeof(TArtNetPollTableUniverses[ARTNET_POLL_TABLE_SIZE_UNIVERSES]));
 
-	for (uint32_t nIndex = 0; nIndex < ARTNET_POLL_TABLE_SIZE_UNIVERSES; nIndex++) {
-		m_pTableUniverses[nIndex].pIpAddresses = new uint32_t[ARTNET_POLL_TABLE_SIZE_ENRIES];
-		assert(m_pTableUniverses[nIndex].pIpAddresses != nullptr);
-	}
+	m_pIpPool = new uint32_t[m_nIpPoolSize];
+	assert(m_pIpPool != nullptr);
 
 //	DEBUG_PRINTF("TArtNetNodeEntry[%d] = %u bytes [%u Kb]", ARTNET_POLL_TABLE_SIZE_ENRIES, (sizeof(TArtNetNodeEntry[ARTNET_POLL_TABLE_SIZE_ENRIES])), (sizeof(TArtNetNodeEntry[ARTNET_POLL_TABLE_SIZE_ENRIES])) / 1024);
 //	DEBUG_PRINTF("TArtNetPollTableUniverses[%d] = %u bytes [%u Kb]", ARTNET_POLL_TABLE_SIZE_UNIVERSES, (sizeof(TArtNetPollTableUniverses[ARTNET_POLL_TABLE_SIZE_UNIVERSES])), (sizeof(TArtNetPollTableUniverses[ARTNET_POLL_TABLE_SIZE_UNIVERSES])) / 1024);
@@ -77,10 +75,8 @@ ArtNetPollTable::ArtNetPollTable() {
 }
 
 ArtNetPollTable::~ArtNetPollTable() {
-	for (uint32_t nIndex = 0; nIndex < ARTNET_POLL_TABLE_SIZE_UNIVERSES; nIndex++) {
-		delete[] m_pTableUniverses[nIndex].pIpAddresses;
-		m_pTableUniverses[nIndex].pIpAddresses = nullptr;
-	}
+	delete[] m_pIpPool;
+	m_pIpPool = nullptr;
 
 	delete[] m_pTableUniverses;
 	m_pTableUniverses = nullptr;
@@ -89,143 +85,163 @@ ArtNetPollTable::~ArtNetPollTable() {
 	m_pPollTable = nullptr;
 }
 
-const struct TArtNetPollTableUniverses *ArtNetPollTable::GetIpAddress(uint16_t nUniverse) const {
-	if (m_nTableUniversesEntries == 0) {
-		return nullptr;
-	}
+/**
+ * Binary search, returns the entry of nUniverse or the position where it should be inserted.
+ */
+uint32_t ArtNetPollTable::FindUniverse(uint16_t nUniverse, bool& bFound) const {
+	uint32_t nLow = 0;
+	uint32_t nHigh = m_nTableUniversesEntries;
 
-	// FIXME Universe lookup
-	for (uint32_t nEntry = 0; nEntry < m_nTableUniversesEntries; nEntry++) {
-		TArtNetPollTableUniverses *pTableUniverses = &m_pTableUniverses[nEntry];
-		assert(pTableUniverses != nullptr);
+	while (nLow < nHigh) {
+		const auto nMid = (nLow + nHigh) / 2;
 
-		if (pTableUniverses->nUniverse == nUniverse) {
-			return &m_pTableUniverses[nEntry];
+		if (m_pTableUniverses[nMid].nUniverse < nUniverse) {
+			nLow = nMid + 1;
+		} else {
+			nHigh = nMid;
 		}
 	}
 
-	return nullptr;
+	bFound = (nLow < m_nTableUniversesEntries) && (m_pTableUniverses[nLow].nUniverse == nUniverse);
+	return nLow;
 }
 
+const struct TArtNetPollTableUniverses *ArtNetPollTable::GetIpAddress(uint16_t nUniverse) const {
+	bool bFound;
+	const auto nEntry = FindUniverse(nUniverse, bFound);
 
-void ArtNetPollTable::RemoveIpAddress(uint16_t nUniverse, uint32_t nIpAddress) {
-	if (m_nTableUniversesEntries == 0) {
-		return;
+	if (bFound) {
+		return &m_pTableUniverses[nEntry];
 	}
 
-	uint32_t nEntry = 0;
+	return nullptr;
+}
 
-	// FIXME Universe lookup
-	for (nEntry = 0; nEntry < m_nTableUniversesEntries; nEntry++) {
-		TArtNetPollTableUniverses *pTableUniverses = &m_pTableUniverses[nEntry];
-		assert(pTableUniverses != nullptr);
+void ArtNetPollTable::GrowIpPool() {
+	DEBUG_ENTRY
 
-		if (pTableUniverses->nUniverse == nUniverse) {
-			break;
-		}
+	const auto nIpPoolSize = m_nIpPoolSize * 2;
+	auto *pIpPool = new uint32_t[nIpPoolSize];
+	assert(pIpPool != nullptr);
+
+	memcpy(pIpPool, m_pIpPool, m_nIpPoolEntries * sizeof(uint32_t));
+
+	for (uint32_t nEntry = 0; nEntry < m_nTableUniversesEntries; nEntry++) {
+		m_pTableUniverses[nEntry].pIpAddresses = pIpPool + (m_pTableUniverses[nEntry].pIpAddresses - m_pIpPool);
 	}
 
-	if (nEntry == m_nTableUniversesEntries) {
-		// Universe not found
+	delete[] m_pIpPool;
+
+	m_pIpPool = pIpPool;
+	m_nIpPoolSize = nIpPoolSize;
+
+	DEBUG_PRINTF("m_nIpPoolSize=%u", m_nIpPoolSize);
+	DEBUG_EXIT
+}
+
+void ArtNetPollTable::RemoveIpAddress(uint16_t nUniverse, uint32_t nIpAddress) {
+	bool bFound;
+	const auto nEntry = FindUniverse(nUniverse, bFound);
+
+	if (!bFound) {
 		return;
 	}
 
-	TArtNetPollTableUniverses *pTableUniverses = &m_pTableUniverses[nEntry];
+	auto *pTableUniverses = &m_pTableUniverses[nEntry];
 	assert(pTableUniverses->nCount > 0);
 
-	uint32_t nIpAddressIndex = 0;
+	uint32_t nIpAddressIndex;
 
-	// FIXME IP lookup
 	for (nIpAddressIndex = 0; nIpAddressIndex < pTableUniverses->nCount; nIpAddressIndex++) {
 		if (pTableUniverses->pIpAddresses[nIpAddressIndex] == nIpAddress) {
 			break;
 		}
 	}
 
-	uint32_t *p32 = pTableUniverses->pIpAddresses;
-	int32_t i;
-
-	for (i = static_cast<int32_t>(nIpAddressIndex); i < static_cast<int32_t>(pTableUniverses->nCount) - 1; i++) {
-		p32[i] = p32[i + 1];
+	if (nIpAddressIndex == pTableUniverses->nCount) {
+		return;
 	}
 
-	p32[i] = 0;
+	auto *pIpAddress = &pTableUniverses->pIpAddresses[nIpAddressIndex];
+	const auto nOffset = static_cast<uint32_t>(pIpAddress - m_pIpPool);
+
+	memmove(pIpAddress, pIpAddress + 1, (m_nIpPoolEntries - nOffset - 1) * sizeof(uint32_t));
+	m_nIpPoolEntries--;
+
+	for (auto i = nEntry + 1; i < m_nTableUniversesEntries; i++) {
+		m_pTableUniverses[i].pIpAddresses--;
+	}
 
 	pTableUniverses->nCount--;
 
 	if (pTableUniverses->nCount == 0) {
 		DEBUG_PRINTF("Delete Universe -> m_nTableUniversesEntries=%u, nEntry=%u", m_nTableUniversesEntries, nEntry);
 
-		TArtNetPollTableUniverses *p = m_pTableUniverses;
-
-		for (i = static_cast<int32_t>(nEntry); i < static_cast<int32_t>(m_nTableUniversesEntries) - 1; i++) {
-			p[i].nUniverse = p[i + 1].nUniverse;
-			p[i].nCount = p[i + 1].nCount;
-			p[i].pIpAddresses = p[i + 1].pIpAddresses;
-		}
-
-		p[i].nUniverse = 0;
-		p[i].nCount = 0;
-
 		m_nTableUniversesEntries--;
+		memmove(pTableUniverses, pTableUniverses + 1, (m_nTableUniversesEntries - nEntry) * sizeof(struct TArtNetPollTableUniverses));
 	}
 }
 
 void ArtNetPollTable::ProcessUniverse(uint32_t nIpAddress, uint16_t nUniverse) {
 	DEBUG_ENTRY
 
-	if (ARTNET_POLL_TABLE_SIZE_UNIVERSES == m_nTableUniversesEntries) {
-		DEBUG_PUTS("m_pTableUniverses is full");
-		DEBUG_EXIT
-		return;
-	}
-
-	// FIXME Universe lookup
-	bool bFoundUniverse = false;
-	uint32_t nEntry = 0;
+	bool bFound;
+	const auto nEntry = FindUniverse(nUniverse, bFound);
 
-	for (nEntry = 0; nEntry < m_nTableUniversesEntries; nEntry++) {
-		TArtNetPollTableUniverses *pTableUniverses = &m_pTableUniverses[nEntry];
-		assert(pTableUniverses != nullptr);
-
-		if (pTableUniverses->nUniverse == nUniverse) {
-			bFoundUniverse = true;
-			DEBUG_PRINTF("Universe found %u", nUniverse);
-			break;
-		}
-	}
+	if (bFound) {
+		const auto *pTableUniverses = &m_pTableUniverses[nEntry];
 
-	TArtNetPollTableUniverses *pTableUniverses = &m_pTableUniverses[nEntry];
-
-	bool bFoundIp = false;
-	uint32_t nCount = 0;
-
-	if (bFoundUniverse) {
-		// FIXME IP lookup
-		for (nCount = 0; nCount < pTableUniverses->nCount; nCount++) {
+		for (uint32_t nCount = 0; nCount < pTableUniverses->nCount; nCount++) {
 			if (pTableUniverses->pIpAddresses[nCount] == nIpAddress) {
-				bFoundIp = true;
 				DEBUG_PUTS("IP found");
-				break;
+				DEBUG_EXIT
+				return;
 			}
 		}
+
+		if (pTableUniverses->nCount == ARTNET_POLL_TABLE_SIZE_ENRIES) {
+			DEBUG_PUTS("New IP does not fit");
+			DEBUG_EXIT
+			return;
+		}
 	} else {
-		// New universe
-		pTableUniverses->nUniverse = nUniverse;
+		if (ARTNET_POLL_TABLE_SIZE_UNIVERSES == m_nTableUniversesEntries) {
+			DEBUG_PUTS("m_pTableUniverses is full");
+			DEBUG_EXIT
+			return;
+		}
+
+		const auto *pIpAddresses = (nEntry < m_nTableUniversesEntries) ? m_pTableUniverses[nEntry].pIpAddresses : &m_pIpPool[m_nIpPoolEntries];
+
+		memmove(&m_pTableUniverses[nEntry + 1], &m_pTableUniverses[nEntry], (m_nTableUniversesEntries - nEntry) * sizeof(struct TArtNetPollTableUniverses));
 		m_nTableUniversesEntries++;
+
+		m_pTableUniverses[nEntry].nUniverse = nUniverse;
+		m_pTableUniverses[nEntry].nCount = 0;
+		m_pTableUniverses[nEntry].pIpAddresses = const_cast<uint32_t *>(pIpAddresses);
+
 		DEBUG_PRINTF("New Universe %d", static_cast<int>(nUniverse));
 	}
 
-	if (!bFoundIp) {
-		if (pTableUniverses->nCount < ARTNET_POLL_TABLE_SIZE_ENRIES) {
-			pTableUniverses->pIpAddresses[pTableUniverses->nCount] = nIpAddress;
-			pTableUniverses->nCount++;
-			DEBUG_PUTS("It is a new IP for the Universe");
-		} else {
-			DEBUG_PUTS("New IP does not fit");
-		}
+	if (m_nIpPoolEntries == m_nIpPoolSize) {
+		GrowIpPool();
+	}
+
+	auto *pTableUniverses = &m_pTableUniverses[nEntry];
+	auto *pIpAddress = &pTableUniverses->pIpAddresses[pTableUniverses->nCount];
+	const auto nOffset = static_cast<uint32_t>(pIpAddress - m_pIpPool);
+
+	memmove(pIpAddress + 1, pIpAddress, (m_nIpPoolEntries - nOffset) * sizeof(uint32_t));
+	m_nIpPoolEntries++;
+
+	for (auto i = nEntry + 1; i < m_nTableUniversesEntries; i++) {
+		m_pTableUniverses[i].pIpAddresses++;
 	}
 
+	*pIpAddress = nIpAddress;
+	pTableUniverses->nCount++;
+
+	DEBUG_PUTS("It is a new IP for the Universe");
 	DEBUG_EXIT
 }
 
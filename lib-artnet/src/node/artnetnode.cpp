@@ -278,6 +278,10 @@ void ArtNetNode::GetType() {
 void ArtNetNode::Run() {
 	uint16_t nForeignPort;
 
+	if (m_pArtNetRdm != nullptr) {
+		m_pArtNetRdm->Run();
+	}
+
 	const auto nBytesReceived = Network::Get()->RecvFrom(m_nHandle, &(m_ArtNetPacket.ArtPacket), sizeof(m_ArtNetPacket.ArtPacket), &m_ArtNetPacket.IPAddressFrom, &nForeignPort);
 
 	m_nCurrentPacketMillis = Hardware::Get()->Millis();
@@ -301,6 +305,11 @@ void ArtNetNode::Run() {
 			m_State.nReceivingDmx &= static_cast<uint8_t>(~(1U << static_cast<uint8_t>(lightset::PortDir::OUTPUT)));
 		}
 
+		if ((m_pArtNetRdm != nullptr) && ((m_nCurrentPacketMillis - m_nRdmIncrementalMillis) >= artnetnode::RDM_INCREMENTAL_DISCOVERY_MILLIS)) {
+			m_nRdmIncrementalMillis = m_nCurrentPacketMillis;
+			RdmIncrementalDiscovery();
+		}
+
 		if (m_pArtNetDmx != nullptr) {
 			HandleDmxIn();
 		}
@@ -324,6 +333,43 @@ void ArtNetNode::Run() {
 		return;
 	}
 
+	HandlePacket(nBytesReceived);
+
+	/*
+	 * Drain the datagrams that are already received, before the DMX input and the LED are handled.
+	 */
+	while (Network::Get()->RecvBatch(m_nHandle) != 0) {
+		const auto nBytes = Network::Get()->RecvFrom(m_nHandle, &(m_ArtNetPacket.ArtPacket), sizeof(m_ArtNetPacket.ArtPacket), &m_ArtNetPacket.IPAddressFrom, &nForeignPort);
+
+		if (nBytes == 0) {
+			break;
+		}
+
+		HandlePacket(nBytes);
+	}
+
+	if (m_pArtNetDmx != nullptr) {
+		HandleDmxIn();
+	}
+
+	if ((((m_Node.Status1 & Status1::INDICATOR_MASK) == Status1::INDICATOR_NORMAL_MODE)) && (LedBlink::Get()->GetMode() != ledblink::Mode::FAST)) {
+		if (artnet::VERSION > 3) {
+			if (m_State.nReceivingDmx != 0) {
+				m_pArtNet4Handler->SetLedBlinkMode(ledblink::Mode::DATA);
+			} else {
+				m_pArtNet4Handler->SetLedBlinkMode(ledblink::Mode::NORMAL);
+			}
+		} else {
+			if (m_State.nReceivingDmx != 0) {
+				LedBlink::Get()->SetMode(ledblink::Mode::DATA);
+			} else {
+				LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
+			}
+		}
+	}
+}
+
+void ArtNetNode::HandlePacket(uint16_t nBytesReceived) {
 	m_ArtNetPacket.nLength = nBytesReceived;
 	m_nPreviousPacketMillis = m_nCurrentPacketMillis;
 
@@ -388,24 +434,4 @@ void ArtNetNode::Run() {
 		// Just skip ... no error
 		break;
 	}
-
-	if (m_pArtNetDmx != nullptr) {
-		HandleDmxIn();
-	}
-
-	if ((((m_Node.Status1 & Status1::INDICATOR_MASK) == Status1::INDICATOR_NORMAL_MODE)) && (LedBlink::Get()->GetMode() != ledblink::Mode::FAST)) {
-		if (artnet::VERSION > 3) {
-			if (m_State.nReceivingDmx != 0) {
-				m_pArtNet4Handler->SetLedBlinkMode(ledblink::Mode::DATA);
-			} else {
-				m_pArtNet4Handler->SetLedBlinkMode(ledblink::Mode::NORMAL);
-			}
-		} else {
-			if (m_State.nReceivingDmx != 0) {
-				LedBlink::Get()->SetMode(ledblink::Mode::DATA);
-			} else {
-				LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
-			}
-		}
-	}
 }
@@ -45,6 +45,16 @@ uint16_t ArtNetNode::MakePortAddress(uint16_t nUniverse, uint32_t nPage) {
 	return artnet::make_port_address(m_Node.NetSwitch[nPage], m_Node.SubSwitch[nPage], nUniverse);
 }
 
+void ArtNetNode::UpdateOutputPortIndex() {
+	m_OutputPortIndex.Clear();
+
+	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
+		if (m_OutputPort[nPortIndex].genericPort.bIsEnabled) {
+			m_OutputPortIndex.Add(m_OutputPort[nPortIndex].genericPort.nPortAddress, nPortIndex);
+		}
+	}
+}
+
 int ArtNetNode::SetUniverse(uint32_t nPortIndex, lightset::PortDir dir, uint16_t nUniverse) {
 	const auto nPage = nPortIndex / artnetnode::PAGE_SIZE;
 	assert(nPage < artnetnode::PAGES);
@@ -77,6 +87,7 @@ int ArtNetNode::SetUniverseSwitch(uint32_t nPortIndex, lightset::PortDir dir, ui
 			m_InputPort[nPortIndex].genericPort.nStatus = GoodInput::DISABLED;
 			m_State.nActiveInputPorts = static_cast<uint8_t>(m_State.nActiveInputPorts - 1);
 		}
+		UpdateOutputPortIndex();
 		return ARTNET_EOK;
 	}
 
@@ -114,6 +125,8 @@ int ArtNetNode::SetUniverseSwitch(uint32_t nPortIndex, lightset::PortDir dir, ui
 		}
 	}
 
+	UpdateOutputPortIndex();
+
 	if ((m_pArtNet4Handler != nullptr) && (m_State.status != Status::ON)) {
 		m_pArtNet4Handler->SetPort(nPortIndex, dir);
 	}
@@ -163,6 +176,8 @@ void ArtNetNode::SetSubnetSwitch(uint8_t nAddress, uint32_t nPage) {
 		m_OutputPort[nPortIndex].genericPort.nPortAddress = MakePortAddress(m_OutputPort[nPortIndex].genericPort.nPortAddress, nPage);
 	}
 
+	UpdateOutputPortIndex();
+
 	if ((m_pArtNetStore != nullptr) && (m_State.status == Status::ON)) {
 		m_pArtNetStore->SaveSubnetSwitch(nPage, nAddress);
 	}
@@ -182,6 +197,8 @@ void ArtNetNode::SetNetSwitch(uint8_t nAddress, uint32_t nPage) {
 		m_OutputPort[nPortIndex].genericPort.nPortAddress = MakePortAddress(m_OutputPort[nPortIndex].genericPort.nPortAddress, nPage);
 	}
 
+	UpdateOutputPortIndex();
+
 	if ((m_pArtNetStore != nullptr) && (m_State.status == Status::ON)) {
 		m_pArtNetStore->SaveNetSwitch(nPage, nAddress);
 	}
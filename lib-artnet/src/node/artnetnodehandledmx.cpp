@@ -83,9 +83,13 @@ void ArtNetNode::HandleDmx() {
 	auto nDmxSlots = static_cast<uint16_t>( ((pArtDmx->LengthHi << 8) & 0xff00) | pArtDmx->Length);
 	nDmxSlots = std::min(nDmxSlots, artnet::DMX_LENGTH);
 
-	for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
+	uint32_t nBegin, nEnd;
+	m_OutputPortIndex.Find(pArtDmx->PortAddress, nBegin, nEnd);
 
-		if (m_OutputPort[nPortIndex].genericPort.bIsEnabled && (m_OutputPort[nPortIndex].protocol == PortProtocol::ARTNET) && (pArtDmx->PortAddress == m_OutputPort[nPortIndex].genericPort.nPortAddress)) {
+	for (auto nEntry = nBegin; nEntry < nEnd; nEntry++) {
+		const auto nPortIndex = m_OutputPortIndex.GetPortIndex(nEntry);
+
+		if (m_OutputPort[nPortIndex].protocol == PortProtocol::ARTNET) {
 
 			auto ipA = m_OutputPort[nPortIndex].sourceA.nIp;
 			auto ipB = m_OutputPort[nPortIndex].sourceB.nIp;
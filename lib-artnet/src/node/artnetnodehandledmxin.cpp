@@ -27,6 +27,7 @@
  */
 
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <cassert>
 
@@ -58,6 +59,8 @@ void ArtNetNode::SetDestinationIp(uint32_t nPortIndex, uint32_t nDestinationIp)
 }
 
 void ArtNetNode::HandleDmxIn() {
+	Network::Get()->SendBatchBegin();
+
 	for (uint32_t i = 0; i < artnetnode::MAX_PORTS; i++) {
 		if (!m_InputPort[i].genericPort.bIsEnabled) {
 			continue;
@@ -68,23 +71,31 @@ void ArtNetNode::HandleDmxIn() {
 		const auto *pDmxData = m_pArtNetDmx->Handler(i, nLength, nUpdatesPerSecond);
 
 		if (pDmxData != nullptr) {
-			m_ArtDmx.Sequence = static_cast<uint8_t>(1U + m_InputPort[i].nSequenceNumber++);
-			m_ArtDmx.Physical = static_cast<uint8_t>(i);
-			m_ArtDmx.PortAddress = m_InputPort[i].genericPort.nPortAddress;
+			const auto nSequence = static_cast<uint8_t>(1U + m_InputPort[i].nSequenceNumber++);
 
-			memcpy(m_ArtDmx.Data, pDmxData, nLength);
+			// The ArtDmx is built in the transmit buffer, m_ArtDmx holds the fixed header fields
+			auto *pArtDmx = static_cast<TArtDmx *>(Network::Get()->SendBegin(m_nHandle, m_InputPort[i].nDestinationIp, artnet::UDP_PORT));
 
-			if ((nLength & 0x1) == 0x1) {
-				m_ArtDmx.Data[nLength] = 0x00;
-				nLength++;
-			}
+			if (pArtDmx != nullptr) {
+				memcpy(pArtDmx, &m_ArtDmx, offsetof(struct TArtDmx, Sequence));
+				pArtDmx->Sequence = nSequence;
+				pArtDmx->Physical = static_cast<uint8_t>(i);
+				pArtDmx->PortAddress = m_InputPort[i].genericPort.nPortAddress;
 
-			m_ArtDmx.LengthHi = static_cast<uint8_t>((nLength & 0xFF00) >> 8);
-			m_ArtDmx.Length = static_cast<uint8_t>(nLength & 0xFF);
+				memcpy(pArtDmx->Data, pDmxData, nLength);
 
-			m_InputPort[i].genericPort.nStatus = GoodInput::DATA_RECIEVED;
+				if ((nLength & 0x1) == 0x1) {
+					pArtDmx->Data[nLength] = 0x00;
+					nLength++;
+				}
 
-			Network::Get()->SendTo(m_nHandle, &m_ArtDmx, sizeof(struct TArtDmx), m_InputPort[i].nDestinationIp, artnet::UDP_PORT);
+				pArtDmx->LengthHi = static_cast<uint8_t>((nLength & 0xFF00) >> 8);
+				pArtDmx->Length = static_cast<uint8_t>(nLength & 0xFF);
+
+				Network::Get()->SendCommit(static_cast<uint16_t>(sizeof(struct TArtDmx) - artnet::DMX_LENGTH + nLength));
+			}
+
+			m_InputPort[i].genericPort.nStatus = GoodInput::DATA_RECIEVED;
 
 			if ((s_ReceivingMask & (1U << i)) != (1U << i)) {
 				s_ReceivingMask |= (1U << i);
@@ -104,4 +115,6 @@ void ArtNetNode::HandleDmxIn() {
 			}
 		}
 	}
+
+	Network::Get()->SendBatchEnd();
 }
@@ -73,18 +73,35 @@ void ArtNetNode::HandleTodControl() {
 		}
 
 		if ((portAddress == m_OutputPort[i].genericPort.nPortAddress) && m_OutputPort[i].genericPort.bIsEnabled) {
-			if (m_OutputPort[i].IsTransmitting && (!m_IsRdmResponder)) {
-				m_pLightSet->Stop(i);
-			}
+			switch (pArtTodControl->Command) {
+			case 0x01:	// AtcFlush
+				if (m_OutputPort[i].IsTransmitting && (!m_IsRdmResponder)) {
+					m_pLightSet->Stop(i);
+				}
 
-			if (pArtTodControl->Command == 0x01) {	// AtcFlush
-				m_pArtNetRdm->Full(i);
-			}
+				if (m_pArtNetRdm->Discovery(i, false)) {
+					break;	// The TOD is sent, and DMX is started again, in RdmDiscoveryFinished
+				}
 
-			SendTod(i);
+				m_pArtNetRdm->Full(i);
+				SendTod(i);
 
-			if (m_OutputPort[i].IsTransmitting && (!m_IsRdmResponder)) {
-				m_pLightSet->Start(i);
+				if (m_OutputPort[i].IsTransmitting && (!m_IsRdmResponder)) {
+					m_pLightSet->Start(i);
+				}
+				break;
+			case 0x02:	// AtcEnd
+				m_pArtNetRdm->DiscoveryStop(i);
+				SendTod(i);
+				break;
+			case 0x03:	// AtcIncOn
+			case 0x04:	// AtcIncOff
+				m_OutputPort[i].isRdmIncremental = (pArtTodControl->Command == 0x03);
+				SendTod(i);
+				break;
+			default:	// AtcNone
+				SendTod(i);
+				break;
 			}
 		}
 	}
@@ -154,6 +171,8 @@ void ArtNetNode::SetRdmHandler(ArtNetRdm *pArtNetTRdm, bool IsResponder) {
 	m_pArtNetRdm = pArtNetTRdm;
 
 	if (pArtNetTRdm != nullptr) {
+		pArtNetTRdm->SetRdmCompleted(ArtNetNode::StaticRdmCompleted);
+		pArtNetTRdm->SetDiscoveryFinished(ArtNetNode::StaticRdmDiscoveryFinished);
 		m_IsRdmResponder = IsResponder;
 		m_Node.Status1 |= Status1::RDM_CAPABLE;
 	} else {
@@ -187,6 +206,10 @@ void ArtNetNode::HandleRdm() {
 
 			}
 
+			if (m_pArtNetRdm->Request(i, pArtRdm->RdmPacket, m_ArtNetPacket.IPAddressFrom)) {
+				continue;	// DMX is started again in RdmCompleted
+			}
+
 			const auto *pRdmResponse = const_cast<uint8_t*>(m_pArtNetRdm->Handler(i, pArtRdm->RdmPacket));
 
 			if (pRdmResponse != nullptr) {
@@ -211,6 +234,79 @@ void ArtNetNode::HandleRdm() {
 	DEBUG_EXIT
 }
 
+/**
+ * Called from m_pArtNetRdm->Run(), before the next packet is received,
+ * so m_ArtNetPacket can be used for the reply.
+ */
+void ArtNetNode::RdmCompleted(uint32_t nPortIndex, const uint8_t *pRdmResponse, uint32_t nIPAddress, bool bIsIdle) {
+	assert(nPortIndex < artnetnode::MAX_PORTS);
+
+	if (pRdmResponse != nullptr) {
+		auto *pArtRdm = &(m_ArtNetPacket.ArtPacket.ArtRdm);
+		const auto nPortAddress = m_OutputPort[nPortIndex].genericPort.nPortAddress;
+
+		memcpy(pArtRdm->Id, artnet::NODE_ID, sizeof(pArtRdm->Id));
+		pArtRdm->OpCode = OP_RDM;
+		pArtRdm->ProtVerHi = 0;
+		pArtRdm->ProtVerLo = artnet::PROTOCOL_REVISION;
+		pArtRdm->RdmVer = 0x01;
+		pArtRdm->Filler2 = 0;
+		pArtRdm->Spare1 = 0;
+		pArtRdm->Spare2 = 0;
+		pArtRdm->Spare3 = 0;
+		pArtRdm->Spare4 = 0;
+		pArtRdm->Spare5 = 0;
+		pArtRdm->Spare6 = 0;
+		pArtRdm->Spare7 = 0;
+		pArtRdm->Net = static_cast<uint8_t>(nPortAddress >> 8);
+		pArtRdm->Command = 0;	// ArProcess
+		pArtRdm->Address = static_cast<uint8_t>(nPortAddress);
+
+		const auto nMessageLength = static_cast<uint16_t>(pRdmResponse[2] + 1);
+		memcpy(pArtRdm->RdmPacket, &pRdmResponse[1], nMessageLength);
+
+		const auto nLength = sizeof(struct TArtRdm) - sizeof(pArtRdm->RdmPacket) + nMessageLength;
+
+		Network::Get()->SendTo(m_nHandle, pArtRdm, static_cast<uint16_t>(nLength), nIPAddress, artnet::UDP_PORT);
+	} else {
+		DEBUG_PUTS("No RDM response");
+	}
+
+	if (bIsIdle && m_OutputPort[nPortIndex].IsTransmitting && (!m_IsRdmResponder)) {
+		m_pLightSet->Start(nPortIndex); // Start DMX if was running
+	}
+}
+
+/**
+ * Called from m_pArtNetRdm->Run(), see RdmCompleted.
+ */
+void ArtNetNode::RdmDiscoveryFinished(uint32_t nPortIndex, bool bIsTodChanged, bool bIsIdle) {
+	DEBUG_PRINTF("nPortIndex=%u, bIsTodChanged=%d", nPortIndex, bIsTodChanged);
+	assert(nPortIndex < artnetnode::MAX_PORTS);
+
+	if (bIsTodChanged) {
+		SendTod(nPortIndex);
+	}
+
+	if (bIsIdle && m_OutputPort[nPortIndex].IsTransmitting && (!m_IsRdmResponder)) {
+		m_pLightSet->Start(nPortIndex); // Start DMX if was running
+	}
+}
+
+void ArtNetNode::RdmIncrementalDiscovery() {
+	for (uint32_t i = 0; i < artnetnode::MAX_PORTS; i++) {
+		if (!(m_OutputPort[i].isRdmEnabled && m_OutputPort[i].isRdmIncremental && m_OutputPort[i].genericPort.bIsEnabled)) {
+			continue;
+		}
+
+		if (m_pArtNetRdm->Discovery(i, true)) {
+			if (m_OutputPort[i].IsTransmitting && (!m_IsRdmResponder)) {
+				m_pLightSet->Stop(i);
+			}
+		}
+	}
+}
+
 void ArtNetNode::SetRdmUID(const uint8_t *pUid, bool bSupportsLLRP) {
 	memcpy(m_Node.DefaultUidResponder, pUid, sizeof(m_Node.DefaultUidResponder));
 	if (bSupportsLLRP) {
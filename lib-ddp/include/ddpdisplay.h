@@ -79,7 +79,7 @@ public:
 	void SetCount(uint32_t nCount, uint32_t nChannelsPerPixel, uint32_t nActivePorts) {
 		m_nCount = nCount;
 		m_nStripDataLength = nCount * nChannelsPerPixel;
-		m_nLightSetDataMaxLength = (nChannelsPerPixel == 4 ? 512U : 510U);
+		m_nLightSetDataMaxLength = (512U / nChannelsPerPixel) * nChannelsPerPixel;
 		m_nActivePorts = std::min(nActivePorts, ddpdisplay::configuration::pixel::MAX_PORTS);
 	}
 
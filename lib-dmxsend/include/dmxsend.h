@@ -36,6 +36,7 @@ public:
 	void Stop(uint32_t nPortIndex) override;
 
 	void SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength) override;
+	void SetDataRange(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) override;
 
 	void Blackout(bool bBlackout) override;
 	void FullOn() override;
@@ -44,6 +45,7 @@ public:
 
 private:
 	static uint8_t s_nStarted;
+	static uint8_t s_nForceUpdate;
 };
 
 #endif /* DMXSEND_H_ */
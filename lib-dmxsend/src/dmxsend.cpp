@@ -35,6 +35,7 @@
 #include "debug.h"
 
 uint8_t DmxSend::s_nStarted;
+uint8_t DmxSend::s_nForceUpdate;
 
 static constexpr bool is_started(const uint8_t v, const uint32_t p) {
 	return (v & (1U << p)) == (1U << p);
@@ -52,6 +53,7 @@ void DmxSend::Start(uint32_t nPortIndex) {
 	}
 
 	s_nStarted = static_cast<uint8_t>(s_nStarted | (1U << nPortIndex));
+	s_nForceUpdate = static_cast<uint8_t>(s_nForceUpdate | (1U << nPortIndex));
 
 	Dmx::Get()->SetPortDirection(nPortIndex, dmx::PortDirection::OUTP, true);
 
@@ -91,10 +93,27 @@ void DmxSend::SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLengt
 	Dmx::Get()->SetPortSendDataWithoutSC(nPortIndex, pData, nLength);
 }
 
+void DmxSend::SetDataRange(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) {
+	assert(nPortIndex < CHAR_BIT);
+
+	/*
+	 * The DMX output keeps transmitting the last buffer.
+	 * When no slot has changed, there is nothing to copy.
+	 */
+	if ((nFirst > nLast) && !is_started(s_nForceUpdate, nPortIndex)) {
+		return;
+	}
+
+	s_nForceUpdate = static_cast<uint8_t>(s_nForceUpdate & ~(1U << nPortIndex));
+
+	SetData(nPortIndex, pData, nLength);
+}
+
 void DmxSend::Blackout(__attribute__((unused)) bool bBlackout){
 	DEBUG_ENTRY
 
 	Dmx::Get()->Blackout();
+	s_nForceUpdate = 0xFF;
 
 	DEBUG_EXIT
 }
@@ -103,6 +122,7 @@ void DmxSend::FullOn(){
 	DEBUG_ENTRY
 
 	Dmx::Get()->FullOn();
+	s_nForceUpdate = 0xFF;
 
 	DEBUG_EXIT
 }
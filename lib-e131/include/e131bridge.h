@@ -37,6 +37,7 @@
 
 #include "lightset.h"
 #include "lightsetdata.h"
+#include "lightsetuniverseindex.h"
 
 namespace e131bridge {
 #if !defined(LIGHTSET_PORTS)
@@ -120,14 +121,14 @@ public:
 	bool GetUniverse(uint32_t nPortIndex, uint16_t &nUniverse, lightset::PortDir tDir) const;
 
 	bool GetOutputPort(const uint16_t nUniverse, uint32_t& nPortIndex) {
-		for (nPortIndex = 0; nPortIndex < e131bridge::MAX_PORTS; nPortIndex++) {
-			if (!m_OutputPort[nPortIndex].genericPort.bIsEnabled) {
-				continue;
-			}
-			if (m_OutputPort[nPortIndex].genericPort.nUniverse == nUniverse) {
-				return true;
-			}
+		uint32_t nBegin, nEnd;
+		m_OutputPortIndex.Find(nUniverse, nBegin, nEnd);
+
+		if (nBegin != nEnd) {
+			nPortIndex = m_OutputPortIndex.GetPortIndex(nBegin);
+			return true;
 		}
+
 		return false;
 	}
 
@@ -268,10 +269,12 @@ private:
 	bool isIpCidMatch(const struct e131bridge::Source *) const;
 	void UpdateMergeStatus(const uint32_t nPortIndex);
 
+	void HandlePacket();
 	void HandleDmx();
 	void HandleSynchronization();
 
 	void LeaveUniverse(uint32_t nPortIndex, uint16_t nUniverse);
+	void UpdateOutputPortIndex();
 
 	// Input
 	void HandleDmxIn();
@@ -305,6 +308,7 @@ private:
 	e131bridge::State m_State;
 	e131bridge::OutputPort m_OutputPort[e131bridge::MAX_PORTS];
 	e131bridge::InputPort m_InputPort[e131bridge::MAX_PORTS];
+	lightset::UniverseIndex<e131bridge::MAX_PORTS> m_OutputPortIndex;	///< Enabled output ports by universe
 
 	static E131Bridge *s_pThis;
 };
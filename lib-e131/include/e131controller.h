@@ -41,6 +41,7 @@ enum {
 
 struct TE131ControllerState {
 	bool bIsRunning;
+	bool bFrameOpen;
 	uint16_t nActiveUniverses;
 	uint32_t DiscoveryTime;
 	uint8_t nPriority;
@@ -99,6 +100,9 @@ private:
 	void FillDiscoveryPacket();
 	void FillSynchronizationPacket();
 	void SendDiscoveryPacket();
+	void SetDataLength(uint32_t nLength);
+	void FrameBegin();
+	void FrameEnd();
 	uint8_t GetSequenceNumber(uint16_t nUniverse, uint32_t &nMulticastIpAddress);
 
 private:
@@ -112,6 +116,8 @@ private:
 	uint8_t m_Cid[e131::CID_LENGTH];
 	char m_SourceName[e131::SOURCE_NAME_LENGTH];
 	uint32_t m_nMaster { DMX_MAX_VALUE };
+	uint32_t m_nDataLength { 0 };
+	uint32_t m_nUniverseIndex { 0 };
 
 	static E131Controller *s_pThis;
 };
@@ -104,6 +104,7 @@ E131Controller::E131Controller() {
 E131Controller::~E131Controller() {
 	DEBUG_ENTRY
 
+	FrameEnd();
 	Network::Get()->End(e131::UDP_PORT);
 
 	if (m_pE131SynchronizationPacket != nullptr) {
@@ -128,6 +129,7 @@ void E131Controller::Start() {
 	DEBUG_ENTRY
 
 	FillDataPacket();
+	m_nDataLength = 0;
 	FillDiscoveryPacket();
 	FillSynchronizationPacket();
 
@@ -137,10 +139,13 @@ void E131Controller::Start() {
 }
 
 void E131Controller::Stop() {
+	FrameEnd();
 	m_State.bIsRunning = false;
 }
 
 void E131Controller::Run() {
+	FrameEnd();
+
 	if (__builtin_expect((m_State.bIsRunning), 1)) {
 		m_nCurrentPacketMillis = Hardware::Get()->Millis();
 		SendDiscoveryPacket();
@@ -203,19 +208,52 @@ void E131Controller::FillSynchronizationPacket() {
 	m_pE131SynchronizationPacket->FrameLayer.UniverseNumber = __builtin_bswap16(m_State.SynchronizationPacket.nUniverseNumber);
 }
 
-void E131Controller::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData, uint32_t nLength) {
-	uint32_t nIp;
+void E131Controller::SetDataLength(uint32_t nLength) {
+	if (nLength == m_nDataLength) {
+		return;
+	}
+
+	m_nDataLength = nLength;
 
 	// Root Layer (See Section 5)
 	m_pE131DataPacket->RootLayer.FlagsLength = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (DATA_ROOT_LAYER_LENGTH(1U + nLength))));
 
 	// E1.31 Framing Layer (See Section 6)
 	m_pE131DataPacket->FrameLayer.FLagsLength = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (DATA_FRAME_LAYER_LENGTH(1U + nLength))));
-	m_pE131DataPacket->FrameLayer.SequenceNumber = GetSequenceNumber(nUniverse, nIp);
-	m_pE131DataPacket->FrameLayer.Universe = __builtin_bswap16(nUniverse);
 
 	// Data Layer
 	m_pE131DataPacket->DMPLayer.FlagsLength = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (DATA_LAYER_LENGTH(1U + nLength))));
+	m_pE131DataPacket->DMPLayer.PropertyValueCount = __builtin_bswap16(static_cast<uint16_t>(1 + nLength));
+}
+
+/*
+ * The universes of a frame are staged with HandleDmxOut and sent back-to-back in one batch.
+ * The batch is closed by HandleSync, which adds the synchronization packet, or else by Run.
+ */
+void E131Controller::FrameBegin() {
+	if (!m_State.bFrameOpen) {
+		m_State.bFrameOpen = true;
+		Network::Get()->SendBatchBegin();
+	}
+}
+
+void E131Controller::FrameEnd() {
+	if (m_State.bFrameOpen) {
+		m_State.bFrameOpen = false;
+		Network::Get()->SendBatchEnd();
+	}
+}
+
+void E131Controller::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData, uint32_t nLength) {
+	uint32_t nIp;
+
+	FrameBegin();
+
+	// The template holds everything but the length fields, the sequence number and the universe
+	SetDataLength(nLength);
+
+	m_pE131DataPacket->FrameLayer.SequenceNumber = GetSequenceNumber(nUniverse, nIp);
+	m_pE131DataPacket->FrameLayer.Universe = __builtin_bswap16(nUniverse);
 
 	if (__builtin_expect((m_nMaster == DMX_MAX_VALUE), 1)) {
 		memcpy(&m_pE131DataPacket->DMPLayer.PropertyValues[1], pDmxData, nLength);
@@ -227,8 +265,6 @@ void E131Controller::HandleDmxOut(uint16_t nUniverse, const uint8_t *pDmxData, u
 		}
 	}
 
-	m_pE131DataPacket->DMPLayer.PropertyValueCount = __builtin_bswap16(static_cast<uint16_t>(1 + nLength));
-
 	Network::Get()->SendTo(m_nHandle, m_pE131DataPacket, static_cast<uint16_t>(DATA_PACKET_SIZE(1U + nLength)), nIp, e131::UDP_PORT);
 }
 
@@ -237,33 +273,24 @@ void E131Controller::HandleSync() {
 		m_pE131SynchronizationPacket->FrameLayer.SequenceNumber = m_State.SynchronizationPacket.nSequenceNumber++;
 		Network::Get()->SendTo(m_nHandle, m_pE131SynchronizationPacket, SYNCHRONIZATION_PACKET_SIZE, m_State.SynchronizationPacket.nIpAddress, e131::UDP_PORT);
 	}
+
+	FrameEnd();
 }
 
 void E131Controller::HandleBlackout() {
-	// Root Layer (See Section 5)
-	m_pE131DataPacket->RootLayer.FlagsLength = __builtin_bswap16((0x07 << 12) | (DATA_ROOT_LAYER_LENGTH(513)));
-
-	// E1.31 Framing Layer (See Section 6)
-	m_pE131DataPacket->FrameLayer.FLagsLength = __builtin_bswap16((0x07 << 12) | (DATA_FRAME_LAYER_LENGTH(513)));
+	FrameBegin();
 
-	// Data Layer
-	m_pE131DataPacket->DMPLayer.FlagsLength = __builtin_bswap16((0x07 << 12) | (DATA_LAYER_LENGTH(513)));
-	m_pE131DataPacket->DMPLayer.PropertyValueCount = __builtin_bswap16(513);
+	SetDataLength(512);
 	memset(&m_pE131DataPacket->DMPLayer.PropertyValues[1], 0, 512);
 
 	for (uint32_t nIndex = 0; nIndex < m_State.nActiveUniverses; nIndex++) {
-		uint32_t nIp;
-		uint16_t nUniverse = s_SequenceNumbers[nIndex].nUniverse;
-
-		m_pE131DataPacket->FrameLayer.SequenceNumber = GetSequenceNumber(nUniverse, nIp);
-		m_pE131DataPacket->FrameLayer.Universe = __builtin_bswap16(nUniverse);
+		m_pE131DataPacket->FrameLayer.SequenceNumber = ++s_SequenceNumbers[nIndex].nSequenceNumber;
+		m_pE131DataPacket->FrameLayer.Universe = __builtin_bswap16(s_SequenceNumbers[nIndex].nUniverse);
 
-		Network::Get()->SendTo(m_nHandle, m_pE131DataPacket, DATA_PACKET_SIZE(513), nIp, e131::UDP_PORT);
+		Network::Get()->SendTo(m_nHandle, m_pE131DataPacket, DATA_PACKET_SIZE(513), s_SequenceNumbers[nIndex].nIpAddress, e131::UDP_PORT);
 	}
 
-	if (m_State.SynchronizationPacket.nUniverseNumber != 0) {
-		HandleSync();
-	}
+	HandleSync();
 }
 
 const uint8_t *E131Controller::GetSoftwareVersion() {
@@ -312,6 +339,21 @@ void E131Controller::SendDiscoveryPacket() {
 uint8_t E131Controller::GetSequenceNumber(uint16_t nUniverse, uint32_t &nMulticastIpAddress) {
 	assert(sizeof(struct TSequenceNumbers) == sizeof(uint64_t));
 
+	/*
+	 * A frame sends the universes in the same order each time, the next one is tried first
+	 */
+	auto nNext = m_nUniverseIndex + 1;
+
+	if (nNext >= m_State.nActiveUniverses) {
+		nNext = 0;
+	}
+
+	if ((m_State.nActiveUniverses != 0) && (s_SequenceNumbers[nNext].nUniverse == nUniverse)) {
+		m_nUniverseIndex = nNext;
+		nMulticastIpAddress = s_SequenceNumbers[nNext].nIpAddress;
+		return ++s_SequenceNumbers[nNext].nSequenceNumber;
+	}
+
 	int32_t nLow = 0;
 	int32_t nMid = 0;
 	int32_t nHigh = m_State.nActiveUniverses;
@@ -328,6 +370,7 @@ uint8_t E131Controller::GetSequenceNumber(uint16_t nUniverse, uint32_t &nMultica
 			nHigh = nMid - 1;
 		} else {
 			DEBUG_PRINTF("Found nUniverse=%u", nUniverse);
+			m_nUniverseIndex = static_cast<uint32_t>(nMid);
 			nMulticastIpAddress = s_SequenceNumbers[nMid].nIpAddress;
 			s_SequenceNumbers[nMid].nSequenceNumber++;
 			return s_SequenceNumbers[nMid].nSequenceNumber;
@@ -348,6 +391,7 @@ uint8_t E131Controller::GetSequenceNumber(uint16_t nUniverse, uint32_t &nMultica
 		s_SequenceNumbers[nLow].nSequenceNumber = 0;
 
 		nMulticastIpAddress = s_SequenceNumbers[nLow].nIpAddress;
+		m_nUniverseIndex = static_cast<uint32_t>(nLow);
 
 		DEBUG_PRINTF(">m< nUniverse=%u, nLow=%d", nUniverse, nLow);
 	} else {
@@ -355,6 +399,7 @@ uint8_t E131Controller::GetSequenceNumber(uint16_t nUniverse, uint32_t &nMultica
 		s_SequenceNumbers[nMid].nUniverse = nUniverse;
 
 		nMulticastIpAddress = s_SequenceNumbers[nMid].nIpAddress;
+		m_nUniverseIndex = static_cast<uint32_t>(nMid);
 
 		DEBUG_PRINTF(">a< nUniverse=%u, nMid=%d", nUniverse, nMid);
 	}
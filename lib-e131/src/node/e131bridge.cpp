@@ -188,6 +188,16 @@ void E131Bridge::LeaveUniverse(uint32_t nPortIndex, uint16_t nUniverse) {
 	DEBUG_EXIT
 }
 
+void E131Bridge::UpdateOutputPortIndex() {
+	m_OutputPortIndex.Clear();
+
+	for (uint32_t nPortIndex = 0; nPortIndex < e131bridge::MAX_PORTS; nPortIndex++) {
+		if (m_OutputPort[nPortIndex].genericPort.bIsEnabled) {
+			m_OutputPortIndex.Add(m_OutputPort[nPortIndex].genericPort.nUniverse, nPortIndex);
+		}
+	}
+}
+
 void E131Bridge::SetUniverse(uint32_t nPortIndex, lightset::PortDir dir, uint16_t nUniverse) {
 	assert(nPortIndex < e131bridge::MAX_PORTS);
 	assert(dir <= lightset::PortDir::DISABLE);
@@ -226,6 +236,7 @@ void E131Bridge::SetUniverse(uint32_t nPortIndex, lightset::PortDir dir, uint16_
 			}
 		}
 
+		UpdateOutputPortIndex();
 		return;
 	}
 
@@ -246,6 +257,8 @@ void E131Bridge::SetUniverse(uint32_t nPortIndex, lightset::PortDir dir, uint16_
 	Network::Get()->JoinGroup(m_nHandle, universe_to_multicast_ip(nUniverse));
 
 	m_OutputPort[nPortIndex].genericPort.nUniverse = nUniverse;
+
+	UpdateOutputPortIndex();
 }
 
 bool E131Bridge::GetUniverse(uint32_t nPortIndex, uint16_t &nUniverse, lightset::PortDir portDir) const {
@@ -347,18 +360,15 @@ void E131Bridge::HandleDmx() {
 	const auto *pDmxData = &m_E131.E131Packet.Data.DMPLayer.PropertyValues[1];
 	const auto nDmxSlots = __builtin_bswap16(m_E131.E131Packet.Data.DMPLayer.PropertyValueCount) - 1U;
 
-	for (uint32_t nPortIndex = 0; nPortIndex < e131bridge::MAX_PORTS; nPortIndex++) {
-		if (!m_OutputPort[nPortIndex].genericPort.bIsEnabled) {
-			continue;
-		}
+	// Frame layer
+	// 8.2 Association of Multicast Addresses and Universe
+	// Note: The identity of the universe shall be determined by the universe number in the
+	// packet and not assumed from the multicast address.
+	uint32_t nBegin, nEnd;
+	m_OutputPortIndex.Find(__builtin_bswap16(m_E131.E131Packet.Data.FrameLayer.Universe), nBegin, nEnd);
 
-		// Frame layer
-		// 8.2 Association of Multicast Addresses and Universe
-		// Note: The identity of the universe shall be determined by the universe number in the
-		// packet and not assumed from the multicast address.
-		if (m_E131.E131Packet.Data.FrameLayer.Universe != __builtin_bswap16(m_OutputPort[nPortIndex].genericPort.nUniverse)) {
-			continue;
-		}
+	for (auto nEntry = nBegin; nEntry < nEnd; nEntry++) {
+		const auto nPortIndex = m_OutputPortIndex.GetPortIndex(nEntry);
 
 		auto *pSourceA = &m_OutputPort[nPortIndex].sourceA;
 		auto *pSourceB = &m_OutputPort[nPortIndex].sourceB;
@@ -680,6 +690,35 @@ void E131Bridge::Run() {
 		return;
 	}
 
+	HandlePacket();
+
+	/*
+	 * Drain the datagrams that are already received, before the DMX input and the LED are handled.
+	 */
+	while (Network::Get()->RecvBatch(m_nHandle) != 0) {
+		if (Network::Get()->RecvFrom(m_nHandle, &m_E131.E131Packet, sizeof(m_E131.E131Packet), &m_E131.IPAddressFrom, &nForeignPort) == 0) {
+			break;
+		}
+
+		HandlePacket();
+	}
+
+	if (m_pE131DmxIn != nullptr) {
+		HandleDmxIn();
+		SendDiscoveryPacket();
+	}
+
+	// The ledblink::Mode::FAST is for RDM Identify (Art-Net 4)
+	if (m_bEnableDataIndicator && (LedBlink::Get()->GetMode() != ledblink::Mode::FAST)) {
+		if (m_State.nReceivingDmx != 0) {
+			LedBlink::Get()->SetMode(ledblink::Mode::DATA);
+		} else {
+			LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
+		}
+	}
+}
+
+void E131Bridge::HandlePacket() {
 	if (__builtin_expect((!IsValidRoot()), 0)) {
 		return;
 	}
@@ -709,18 +748,4 @@ void E131Bridge::Run() {
 			DEBUG_PRINTF("Not supported Root Vector : 0x%x", nRootVector);
 		}
 	}
-
-	if (m_pE131DmxIn != nullptr) {
-		HandleDmxIn();
-		SendDiscoveryPacket();
-	}
-
-	// The ledblink::Mode::FAST is for RDM Identify (Art-Net 4)
-	if (m_bEnableDataIndicator && (LedBlink::Get()->GetMode() != ledblink::Mode::FAST)) {
-		if (m_State.nReceivingDmx != 0) {
-			LedBlink::Get()->SetMode(ledblink::Mode::DATA);
-		} else {
-			LedBlink::Get()->SetMode(ledblink::Mode::NORMAL);
-		}
-	}
 }
@@ -65,6 +65,8 @@ void E131Bridge::FillDataPacket() {
 void E131Bridge::HandleDmxIn() {
 	assert(m_pE131DataPacket != nullptr);
 
+	Network::Get()->SendBatchBegin();
+
 	for (uint32_t i = 0 ; i < e131bridge::MAX_PORTS; i++) {
 		if (m_InputPort[i].genericPort.bIsEnabled) {
 			uint32_t nLength;
@@ -81,10 +83,16 @@ void E131Bridge::HandleDmxIn() {
 				m_pE131DataPacket->FrameLayer.Universe = __builtin_bswap16(m_InputPort[i].genericPort.nUniverse);
 				// Data Layer
 				m_pE131DataPacket->DMPLayer.FlagsLength = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (DATA_LAYER_LENGTH(nLength))));
-				memcpy(m_pE131DataPacket->DMPLayer.PropertyValues, pDmxData, nLength);
 				m_pE131DataPacket->DMPLayer.PropertyValueCount = __builtin_bswap16(static_cast<uint16_t>(nLength));
 
-				Network::Get()->SendTo(m_nHandle, m_pE131DataPacket, static_cast<uint16_t>(DATA_PACKET_SIZE(nLength)), m_InputPort[i].nMulticastIp, e131::UDP_PORT);
+				// The headers are copied from m_pE131DataPacket, the DMX data goes straight into the transmit buffer
+				auto *pPacket = static_cast<uint8_t *>(Network::Get()->SendBegin(m_nHandle, m_InputPort[i].nMulticastIp, e131::UDP_PORT));
+
+				if (pPacket != nullptr) {
+					memcpy(pPacket, m_pE131DataPacket, DATA_PACKET_SIZE(0));
+					memcpy(&pPacket[DATA_PACKET_SIZE(0)], pDmxData, nLength);
+					Network::Get()->SendCommit(static_cast<uint16_t>(DATA_PACKET_SIZE(nLength)));
+				}
 
 				if ((s_ReceivingMask & (1U << i)) != (1U << i)) {
 					s_ReceivingMask |= (1U << i);
@@ -102,4 +110,6 @@ void E131Bridge::HandleDmxIn() {
 			}
 		}
 	}
+
+	Network::Get()->SendBatchEnd();
 }
@@ -49,10 +49,14 @@
 	#define CTL0_SPEED_MASK		3
 
 #define TX_CTL0_TX_EN				(1U << 31)
+#define TX_CTL1_TX_MD				(1 << 1)	///< Store and forward, needed for the checksum insertion
 #define TX_CTL1_TX_DMA_EN			(1 << 30)
 
+#define TX_DESC_CHECKSUM_IP_HEADER	(1U << 27)	///< CHECKSUM_CTL 01: IPv4 header only
+
 #define RX_CTL0_RX_EN				(1U << 31)
 #define RX_CTL1_RX_DMA_EN			(1 << 30)
+#define RX_CTL1_RX_DMA_START		(1U << 31)
 
 #define RX_FRM_FLT_RX_ALL_MULTICAST	(1 << 16)
 
@@ -87,6 +91,8 @@ struct coherent_region {
 	char txbuffer[TX_TOTAL_BUFSIZE] __aligned(ARM_DMA_ALIGN);
 	uint32_t rx_currdescnum;
 	uint32_t tx_currdescnum;
+	uint64_t rx_held;	// Descriptors handed out by emac_hold_pkt
+	bool rx_hold;		// The current descriptor will be held
 };
 
 static struct coherent_region *p_coherent_region = 0;
@@ -221,6 +227,8 @@ static void _rx_descs_init(void) {
 
 	H3_EMAC->RX_DMA_DESC = (uintptr_t)&desc_table_p[0];
 	p_coherent_region->rx_currdescnum = 0;
+	p_coherent_region->rx_held = 0;
+	p_coherent_region->rx_hold = false;
 }
 
 static void _tx_descs_init(void) {
@@ -249,6 +257,11 @@ __attribute__((hot)) int emac_eth_recv(uint8_t **packetp) {
 	struct emac_dma_desc *desc_p = &p_coherent_region->rx_chain[desc_num];
 	int length;
 
+	/* The ring has wrapped around to a descriptor that is still held */
+	if (__builtin_expect((p_coherent_region->rx_held & (1ULL << desc_num)) != 0, 0)) {
+		return -1;
+	}
+
 	status = desc_p->status;
 
 	/* Check for DMA own bit */
@@ -275,17 +288,66 @@ __attribute__((hot)) int emac_eth_recv(uint8_t **packetp) {
 	return -1;
 }
 
-void emac_eth_send(void *packet, int len) {
+/*
+ * The number of descriptors, including the current one, that are filled by the DMA.
+ */
+uint32_t emac_eth_recv_backlog(void) {
+	const uint32_t dma_desc_num = (H3_EMAC->RX_CUR_DESC - (uint32_t)(uintptr_t) &p_coherent_region->rx_chain[0]) / sizeof(struct emac_dma_desc);
+
+	if (dma_desc_num == p_coherent_region->rx_currdescnum) {
+		/* Either empty or the ring is full */
+		return (p_coherent_region->rx_chain[dma_desc_num].status & (1U << 31)) ? 0 : CONFIG_RX_DESCR_NUM;
+	}
+
+	if (dma_desc_num > p_coherent_region->rx_currdescnum) {
+		return dma_desc_num - p_coherent_region->rx_currdescnum;
+	}
+
+	return CONFIG_RX_DESCR_NUM + dma_desc_num - p_coherent_region->rx_currdescnum;
+}
+
+/*
+ * The number of descriptors the DMA fills before it reaches desc_num.
+ * Zero when the DMA is at desc_num, e.g. suspended on a held descriptor.
+ */
+uint32_t emac_rx_dma_distance(uint32_t desc_num) {
+	const uint32_t dma_desc_num = (H3_EMAC->RX_CUR_DESC - (uint32_t)(uintptr_t) &p_coherent_region->rx_chain[0]) / sizeof(struct emac_dma_desc);
+
+	assert(desc_num < CONFIG_RX_DESCR_NUM);
+
+	if (desc_num >= dma_desc_num) {
+		return desc_num - dma_desc_num;
+	}
+
+	return CONFIG_RX_DESCR_NUM + desc_num - dma_desc_num;
+}
+
+/*
+ * The frame buffer of the current TX descriptor.
+ * The frame is built in place and sent with emac_eth_send_dma.
+ */
+uint8_t *emac_eth_send_get_dma_buffer(void) {
+	return (uint8_t *)(uintptr_t) p_coherent_region->tx_chain[p_coherent_region->tx_currdescnum].buf_addr;
+}
+
+void emac_eth_send_dma(int len) {
 	uint32_t value;
 	uint32_t desc_num = p_coherent_region->tx_currdescnum;
 	struct emac_dma_desc *desc_p = &p_coherent_region->tx_chain[desc_num];
+#ifdef DEBUG_DUMP
 	uintptr_t data_start = (uintptr_t) desc_p->buf_addr;
+#endif
+
+	assert(len <= CONFIG_ETH_BUFSIZE);
 
 	desc_p->st = (uint32_t)len;
 	/* Mandatory undocumented bit */
 	desc_p->st |= (1U << 24);
+#if defined (CONFIG_EMAC_TX_CHECKSUM_OFFLOAD)
+	/* The IPv4 header checksum is inserted by the EMAC */
+	desc_p->st |= TX_DESC_CHECKSUM_IP_HEADER;
+#endif
 
-	h3_memcpy((void *) data_start, packet, (size_t)len);
 #ifdef DEBUG_DUMP
 	debug_dump((void *) data_start, (uint16_t) len);
 #endif
@@ -311,12 +373,50 @@ void emac_eth_send(void *packet, int len) {
 	H3_EMAC->TX_CTL1 = value;
 }
 
+void emac_eth_send(void *packet, int len) {
+	h3_memcpy(emac_eth_send_get_dma_buffer(), packet, (size_t)len);
+	emac_eth_send_dma(len);
+}
+
+/*
+ * The current descriptor is not given back to the DMA by emac_free_pkt.
+ * It must be released with emac_release_pkt, using the returned descriptor number.
+ */
+uint32_t emac_hold_pkt(void) {
+	const uint32_t desc_num = p_coherent_region->rx_currdescnum;
+
+	assert(!p_coherent_region->rx_hold);
+	assert((p_coherent_region->rx_held & (1ULL << desc_num)) == 0);
+
+	p_coherent_region->rx_held |= (1ULL << desc_num);
+	p_coherent_region->rx_hold = true;
+
+	return desc_num;
+}
+
+void emac_release_pkt(uint32_t desc_num) {
+	assert(desc_num < CONFIG_RX_DESCR_NUM);
+	assert((p_coherent_region->rx_held & (1ULL << desc_num)) != 0);
+
+	p_coherent_region->rx_held &= ~(1ULL << desc_num);
+
+	/* Make the descriptor valid again */
+	p_coherent_region->rx_chain[desc_num].status |= (1U << 31);
+
+	/* Resume the DMA, it is suspended when it ran into a held descriptor */
+	H3_EMAC->RX_CTL1 |= RX_CTL1_RX_DMA_START;
+}
+
 void emac_free_pkt(void) {
 	uint32_t desc_num = p_coherent_region->rx_currdescnum;
 	struct emac_dma_desc *desc_p = &p_coherent_region->rx_chain[desc_num];
 
-	/* Make the current descriptor valid again */
-	desc_p->status |= (1U << 31);
+	if (p_coherent_region->rx_hold) {
+		p_coherent_region->rx_hold = false;
+	} else {
+		/* Make the current descriptor valid again */
+		desc_p->status |= (1U << 31);
+	}
 
 	/* Move to next desc and wrap-around condition. */
 	if (++desc_num >= CONFIG_RX_DESCR_NUM) {
@@ -410,6 +510,9 @@ void __attribute__((cold)) emac_start(uint8_t paddr[]) {
 
 	value = H3_EMAC->TX_CTL1;
 	value |= TX_CTL1_TX_DMA_EN;
+#if defined (CONFIG_EMAC_TX_CHECKSUM_OFFLOAD)
+	value |= TX_CTL1_TX_MD;
+#endif
 	H3_EMAC->TX_CTL1 = value;
 
 	value = H3_EMAC->RX_CTL0;
@@ -27,8 +27,10 @@
 #define H3_SMP_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef void (*start_fn_t)();
+typedef void (*work_fn_t)(void);
 extern void _init_core();
 
 #ifdef __cplusplus
@@ -38,6 +40,31 @@ extern "C" {
 extern uint32_t smp_get_core_number(void);
 extern void smp_start_core(uint32_t, start_fn_t);
 
+/*
+ * Runs work_fn in a loop on the core. The core must not be running yet.
+ * Requires ARM_ALLOW_MULTI_CORE, then the DRAM is shareable and the L1 caches are coherent.
+ */
+extern bool smp_work_start(uint32_t core_number, work_fn_t work_fn);
+extern bool smp_is_core_running(uint32_t core_number);
+
+extern void CleanAndInvalidateDataCacheRange(const void *p, uint32_t length);
+
+/*
+ * Only needed for data in cacheable memory that is read by a DMA controller,
+ * the data shared between the cores is kept coherent by the SCU.
+ */
+inline static void smp_cache_flush_range(const void *p, uint32_t length) {
+	CleanAndInvalidateDataCacheRange(p, length);
+}
+
+inline static void smp_wait_event(void) {
+	asm volatile ("wfe" ::: "memory");
+}
+
+inline static void smp_send_event(void) {
+	asm volatile ("dsb\n\tsev" ::: "memory");
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,100 @@
+/**
+ * @file h3_smp_ring.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef H3_SMP_RING_H_
+#define H3_SMP_RING_H_
+
+/*
+ * Single producer, single consumer ring between two cores.
+ * The items are fixed size records, the number of items must be a power of 2.
+ *
+ * Producer: p = smp_ring_write_begin(); fill *p; smp_ring_write_end();
+ * Consumer: p = smp_ring_read_begin(); use *p; smp_ring_read_end();
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "h3_smp.h"
+
+#include "arm/synchronize.h"
+
+#define SMP_RING_CACHE_LINE	64
+
+struct smp_ring {
+	volatile uint32_t head __attribute__ ((aligned (SMP_RING_CACHE_LINE)));	///< Written by the producer only
+	volatile uint32_t tail __attribute__ ((aligned (SMP_RING_CACHE_LINE)));	///< Written by the consumer only
+	uint32_t mask __attribute__ ((aligned (SMP_RING_CACHE_LINE)));
+	uint32_t item_size;
+	uint8_t *items;
+};
+
+inline static void smp_ring_init(struct smp_ring *ring, uint8_t *items, uint32_t item_size, uint32_t item_count) {
+	ring->head = 0;
+	ring->tail = 0;
+	ring->mask = item_count - 1;
+	ring->item_size = item_size;
+	ring->items = items;
+	dmb();
+}
+
+inline static bool smp_ring_is_empty(const struct smp_ring *ring) {
+	return ring->head == ring->tail;
+}
+
+inline static void *smp_ring_write_begin(struct smp_ring *ring) {
+	const uint32_t head = ring->head;
+
+	if ((head - ring->tail) > ring->mask) {
+		return 0;
+	}
+
+	return &ring->items[(head & ring->mask) * ring->item_size];
+}
+
+inline static void smp_ring_write_end(struct smp_ring *ring) {
+	dmb();
+	ring->head = ring->head + 1;
+	smp_send_event();
+}
+
+inline static void *smp_ring_read_begin(struct smp_ring *ring) {
+	const uint32_t tail = ring->tail;
+
+	if (ring->head == tail) {
+		return 0;
+	}
+
+	dmb();
+
+	return &ring->items[(tail & ring->mask) * ring->item_size];
+}
+
+inline static void smp_ring_read_end(struct smp_ring *ring) {
+	dmb();
+	ring->tail = ring->tail + 1;
+}
+
+#endif /* H3_SMP_RING_H_ */
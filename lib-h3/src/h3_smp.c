@@ -36,6 +36,14 @@
 
 static volatile bool core_is_started;
 static start_fn_t start_fn;
+static work_fn_t work_fn[H3_CPU_COUNT];
+static bool core_is_running[H3_CPU_COUNT];
+
+uint32_t smp_get_core_number(void) {
+	uint32_t mpidr;
+	asm volatile ("mrc p15, 0, %0, c0, c0, 5" : "=r" (mpidr));
+	return mpidr & H3_CPUS_MASK;
+}
 
 void smp_core_main(void) {
 	start_fn_t temp_fn = start_fn;
@@ -68,5 +76,32 @@ void smp_start_core(uint32_t core_number, start_fn_t start) {
 		dmb();
 	}
 
+	core_is_running[core_number] = true;
+
 	h3_spinlock_unlock(0);
 }
+
+static void smp_work_loop(void) {
+	const work_fn_t fn = work_fn[smp_get_core_number()];
+
+	for (;;) {
+		fn();
+	}
+}
+
+bool smp_is_core_running(uint32_t core_number) {
+	return (core_number == 0) || ((core_number < H3_CPU_COUNT) && core_is_running[core_number]);
+}
+
+bool smp_work_start(uint32_t core_number, work_fn_t fn) {
+	if (smp_is_core_running(core_number) || (core_number >= H3_CPU_COUNT) || (fn == 0)) {
+		return false;
+	}
+
+	work_fn[core_number] = fn;
+	dmb();
+
+	smp_start_core(core_number, smp_work_loop);
+
+	return true;
+}
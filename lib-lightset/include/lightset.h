@@ -170,6 +170,10 @@ public:
 	virtual void Start(uint32_t nPortIndex)= 0;
 	virtual void Stop(uint32_t nPortIndex)= 0;
 	virtual void SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength)= 0;
+	// Optional, only the slots nFirst..nLast (inclusive) have changed since the previous call. nFirst > nLast is no change.
+	virtual void SetDataRange(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, __attribute__((unused)) uint32_t nFirst, __attribute__((unused)) uint32_t nLast) {
+		SetData(nPortIndex, pData, nLength);
+	}
 	// Optional
 	virtual void Blackout(__attribute__((unused)) bool bBlackout) {}
 	virtual void FullOn() {}
@@ -80,6 +80,15 @@ public:
 		}
 	}
 
+	void SetDataRange(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) override {
+		if ((nPortIndex < 32) && (m_pA != nullptr)) {
+			return m_pA->SetDataRange(nPortIndex, pData, nLength, nFirst, nLast);
+		}
+		if (m_pB != nullptr) {
+			return m_pB->SetDataRange(nPortIndex & 0x3, pData, nLength, nFirst, nLast);
+		}
+	}
+
 	void Blackout(bool bBlackout) override {
 		if (m_pA != nullptr) {
 			m_pA->Blackout(bBlackout);
@@ -32,6 +32,7 @@
 #include <cassert>
 
 #include "lightset.h"
+#include "lightsetmerge.h"
 
 #if defined (GD32)
 # include "gd32.h"
@@ -90,47 +91,50 @@ private:
 		assert(nPortIndex < PORTS);
 		assert(pData != nullptr);
 
-		memcpy(m_OutputPort[nPortIndex].sourceA.data, pData, nLength);
+		auto& outputPort = m_OutputPort[nPortIndex];
 
-		m_OutputPort[nPortIndex].nLength = nLength;
+		outputPort.nLength = nLength;
 
 		if (mergeMode == MergeMode::HTP) {
-			for (uint32_t i = 0; i < nLength; i++) {
-				const auto data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-				m_OutputPort[nPortIndex].data[i] = data;
-			}
-
+			merge::htp(outputPort.sourceA.data, outputPort.data, pData, outputPort.sourceB.data, nLength, outputPort.nFirst, outputPort.nLast);
 			return;
 		}
 
-		memcpy(m_OutputPort[nPortIndex].data, pData, nLength);
+		merge::ltp(outputPort.sourceA.data, outputPort.data, pData, nLength, outputPort.nFirst, outputPort.nLast);
 	}
 
 	void IMergeSourceB(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, MergeMode mergeMode) {
 		assert(nPortIndex < PORTS);
 		assert(pData != nullptr);
 
-		memcpy(m_OutputPort[nPortIndex].sourceB.data, pData, nLength);
+		auto& outputPort = m_OutputPort[nPortIndex];
 
-		m_OutputPort[nPortIndex].nLength = nLength;
+		outputPort.nLength = nLength;
 
 		if (mergeMode == MergeMode::HTP) {
-			for (uint32_t i = 0; i < nLength; i++) {
-				const auto data = std::max(m_OutputPort[nPortIndex].sourceA.data[i], m_OutputPort[nPortIndex].sourceB.data[i]);
-				m_OutputPort[nPortIndex].data[i] = data;
-			}
-
+			merge::htp(outputPort.sourceB.data, outputPort.data, pData, outputPort.sourceA.data, nLength, outputPort.nFirst, outputPort.nLast);
 			return;
 		}
 
-		memcpy(m_OutputPort[nPortIndex].data, pData, nLength);
+		merge::ltp(outputPort.sourceB.data, outputPort.data, pData, nLength, outputPort.nFirst, outputPort.nLast);
 	}
 
-	void IOutput(LightSet *pLightSet, uint32_t nPortIndex) const {
+	void IOutput(LightSet *pLightSet, uint32_t nPortIndex) {
 		assert(pLightSet != nullptr);
 		assert(nPortIndex < PORTS);
 
-		pLightSet->SetData(nPortIndex, m_OutputPort[nPortIndex].data, m_OutputPort[nPortIndex].nLength);
+		auto& outputPort = m_OutputPort[nPortIndex];
+
+		if (outputPort.nLength != outputPort.nLengthOutput) {
+			outputPort.nLengthOutput = outputPort.nLength;
+			outputPort.nFirst = 0;
+			outputPort.nLast = dmx::UNIVERSE_SIZE - 1;
+		}
+
+		pLightSet->SetDataRange(nPortIndex, outputPort.data, outputPort.nLength, outputPort.nFirst, std::min(outputPort.nLast, outputPort.nLength - 1));
+
+		outputPort.nFirst = dmx::UNIVERSE_SIZE;
+		outputPort.nLast = 0;
 	}
 
 	void IOutputClear(LightSet *pLightSet, uint32_t nPortIndex) {
@@ -139,6 +143,8 @@ private:
 
 		memset(m_OutputPort[nPortIndex].data, 0, dmx::UNIVERSE_SIZE);
 		m_OutputPort[nPortIndex].nLength = dmx::UNIVERSE_SIZE;
+		m_OutputPort[nPortIndex].nFirst = 0;
+		m_OutputPort[nPortIndex].nLast = dmx::UNIVERSE_SIZE - 1;
 		IOutput(pLightSet, nPortIndex);
 	}
 
@@ -163,6 +169,9 @@ private:
 		Source sourceB;
 		uint8_t data[dmx::UNIVERSE_SIZE];
 		uint32_t nLength;
+		uint32_t nLengthOutput;
+		uint32_t nFirst;	///< First slot changed since the last output
+		uint32_t nLast;		///< Last slot changed since the last output, nFirst > nLast is no change
 	};
 
 	OutputPort m_OutputPort[PORTS];
@@ -0,0 +1,175 @@
+/**
+ * @file lightsetmerge.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETMERGE_H_
+#define LIGHTSETMERGE_H_
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * The bare-metal Raspberry Pi builds use -nostdinc, arm_neon.h is not available there.
+ */
+#if defined (__ARM_NEON) && !defined (RPI2)
+# define LIGHTSET_MERGE_NEON
+#endif
+
+#if defined (LIGHTSET_MERGE_NEON)
+# include <arm_neon.h>
+#elif defined (__AVX2__)
+# include <immintrin.h>
+#elif defined (__SSE2__)
+# include <emmintrin.h>
+#endif
+
+namespace lightset {
+namespace merge {
+
+/**
+ * Extends the changed range nFirst..nLast (inclusive) with nBegin..nEnd.
+ * An empty range has nFirst > nLast.
+ */
+inline void mark(uint32_t& nFirst, uint32_t& nLast, const uint32_t nBegin, const uint32_t nEnd) {
+	if (nBegin < nFirst) {
+		nFirst = nBegin;
+	}
+	if (nEnd > nLast) {
+		nLast = nEnd;
+	}
+}
+
+/**
+ * HTP merge fused with the copy into the shadow buffer.
+ *
+ * pShadow[i] = pSource[i]
+ * pOutput[i] = max(pSource[i], pOther[i])
+ *
+ * The slots of pOutput that are modified are added to nFirst..nLast.
+ * The SIMD paths mark whole blocks, so the range can be slightly wider.
+ */
+inline void htp(uint8_t *__restrict__ pShadow, uint8_t *__restrict__ pOutput, const uint8_t *__restrict__ pSource, const uint8_t *__restrict__ pOther, const uint32_t nLength, uint32_t& nFirst, uint32_t& nLast) {
+	uint32_t i = 0;
+
+#if defined (LIGHTSET_MERGE_NEON)
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto source = vld1q_u8(&pSource[i]);
+		const auto output = vmaxq_u8(source, vld1q_u8(&pOther[i]));
+		const auto diff = vreinterpretq_u64_u8(veorq_u8(output, vld1q_u8(&pOutput[i])));
+		if ((vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1)) != 0) {
+			mark(nFirst, nLast, i, i + 15);
+		}
+		vst1q_u8(&pShadow[i], source);
+		vst1q_u8(&pOutput[i], output);
+	}
+#elif defined (__AVX2__) || defined (__SSE2__)
+# if defined (__AVX2__)
+	for (; (i + 32) <= nLength; i += 32) {
+		const auto source = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pSource[i]));
+		const auto output = _mm256_max_epu8(source, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOther[i])));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(output, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&pOutput[i])))) != -1) {
+			mark(nFirst, nLast, i, i + 31);
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pShadow[i]), source);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(&pOutput[i]), output);
+	}
+# endif
+	for (; (i + 16) <= nLength; i += 16) {
+		const auto source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pSource[i]));
+		const auto output = _mm_max_epu8(source, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOther[i])));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(output, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pOutput[i])))) != 0xFFFF) {
+			mark(nFirst, nLast, i, i + 15);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pShadow[i]), source);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&pOutput[i]), output);
+	}
+#endif
+
+	for (; (i + 4) <= nLength; i += 4) {
+		const auto s0 = pSource[i + 0];
+		const auto s1 = pSource[i + 1];
+		const auto s2 = pSource[i + 2];
+		const auto s3 = pSource[i + 3];
+		const auto o0 = pOther[i + 0];
+		const auto o1 = pOther[i + 1];
+		const auto o2 = pOther[i + 2];
+		const auto o3 = pOther[i + 3];
+		const auto m0 = s0 > o0 ? s0 : o0;
+		const auto m1 = s1 > o1 ? s1 : o1;
+		const auto m2 = s2 > o2 ? s2 : o2;
+		const auto m3 = s3 > o3 ? s3 : o3;
+		if ((pOutput[i + 0] != m0) || (pOutput[i + 1] != m1) || (pOutput[i + 2] != m2) || (pOutput[i + 3] != m3)) {
+			mark(nFirst, nLast, i, i + 3);
+		}
+		pShadow[i + 0] = s0;
+		pShadow[i + 1] = s1;
+		pShadow[i + 2] = s2;
+		pShadow[i + 3] = s3;
+		pOutput[i + 0] = m0;
+		pOutput[i + 1] = m1;
+		pOutput[i + 2] = m2;
+		pOutput[i + 3] = m3;
+	}
+
+	for (; i < nLength; i++) {
+		const auto s = pSource[i];
+		const auto o = pOther[i];
+		const auto m = s > o ? s : o;
+		if (pOutput[i] != m) {
+			mark(nFirst, nLast, i, i);
+		}
+		pShadow[i] = s;
+		pOutput[i] = m;
+	}
+}
+
+/**
+ * LTP, the source is copied into both the shadow buffer and the output.
+ * The slots of pOutput that are modified are added to nFirst..nLast.
+ */
+inline void ltp(uint8_t *__restrict__ pShadow, uint8_t *__restrict__ pOutput, const uint8_t *__restrict__ pSource, const uint32_t nLength, uint32_t& nFirst, uint32_t& nLast) {
+	uint32_t nBegin = 0;
+
+	while ((nBegin < nLength) && (pOutput[nBegin] == pSource[nBegin])) {
+		nBegin++;
+	}
+
+	if (nBegin != nLength) {
+		auto nEnd = nLength - 1;
+
+		while (pOutput[nEnd] == pSource[nEnd]) {
+			nEnd--;
+		}
+
+		mark(nFirst, nLast, nBegin, nEnd);
+		memcpy(&pOutput[nBegin], &pSource[nBegin], 1 + nEnd - nBegin);
+	}
+
+	memcpy(pShadow, pSource, nLength);
+}
+
+}  // namespace merge
+}  // namespace lightset
+
+#endif /* LIGHTSETMERGE_H_ */
@@ -0,0 +1,106 @@
+/**
+ * @file lightsetuniverseindex.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef LIGHTSETUNIVERSEINDEX_H_
+#define LIGHTSETUNIVERSEINDEX_H_
+
+#include <cstdint>
+#include <cassert>
+
+namespace lightset {
+/**
+ * Universe to output port index, sorted by universe.
+ * It is rebuilt when the port configuration changes, the lookup is a binary search.
+ */
+template<uint32_t nMaxPorts>
+class UniverseIndex {
+	static_assert(nMaxPorts <= 256, "nPortIndex is stored as uint8_t");
+public:
+	void Clear() {
+		m_nEntries = 0;
+	}
+
+	void Add(uint16_t nUniverse, uint32_t nPortIndex) {
+		assert(m_nEntries < nMaxPorts);
+		assert(nPortIndex < nMaxPorts);
+
+		auto i = m_nEntries++;
+
+		while ((i > 0) && (m_Entries[i - 1].nUniverse > nUniverse)) {
+			m_Entries[i] = m_Entries[i - 1];
+			i--;
+		}
+
+		m_Entries[i].nUniverse = nUniverse;
+		m_Entries[i].nPortIndex = static_cast<uint8_t>(nPortIndex);
+	}
+
+	/**
+	 * The entries nBegin..nEnd (exclusive) belong to nUniverse
+	 */
+	void Find(uint16_t nUniverse, uint32_t& nBegin, uint32_t& nEnd) const {
+		uint32_t nLow = 0;
+		uint32_t nHigh = m_nEntries;
+
+		while (nLow < nHigh) {
+			const auto nMid = (nLow + nHigh) / 2;
+			if (m_Entries[nMid].nUniverse < nUniverse) {
+				nLow = nMid + 1;
+			} else {
+				nHigh = nMid;
+			}
+		}
+
+		nBegin = nLow;
+
+		while ((nLow < m_nEntries) && (m_Entries[nLow].nUniverse == nUniverse)) {
+			nLow++;
+		}
+
+		nEnd = nLow;
+	}
+
+	uint32_t GetPortIndex(uint32_t nEntry) const {
+		assert(nEntry < m_nEntries);
+		return m_Entries[nEntry].nPortIndex;
+	}
+
+	uint32_t GetEntries() const {
+		return m_nEntries;
+	}
+
+private:
+	struct Entry {
+		uint16_t nUniverse;
+		uint8_t nPortIndex;
+	};
+
+	Entry m_Entries[nMaxPorts];
+	uint32_t m_nEntries { 0 };
+};
+}  // namespace lightset
+
+#endif /* LIGHTSETUNIVERSEINDEX_H_ */
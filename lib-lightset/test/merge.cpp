@@ -0,0 +1,192 @@
+/**
+ * @file merge.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Compares lightset::merge::htp/ltp with the scalar merge they replace,
+ * and times both for a full universe.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+#include "lightsetmerge.h"
+
+static constexpr uint32_t MAX_LENGTH = 512;
+
+/*
+ * The merge of lightset::Data before the kernels
+ */
+static void reference_htp(uint8_t *pShadow, uint8_t *pOutput, const uint8_t *pSource, const uint8_t *pOther, uint32_t nLength) {
+	memcpy(pShadow, pSource, nLength);
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		pOutput[i] = std::max(pShadow[i], pOther[i]);
+	}
+}
+
+static uint32_t s_errors;
+
+static void check(const char *pName, uint32_t nOffset, uint32_t nLength, bool isOk) {
+	if (!isOk) {
+		if (s_errors < 10) {
+			printf("%s offset=%u length=%u\n", pName, nOffset, nLength);
+		}
+		s_errors++;
+	}
+}
+
+/*
+ * Every slot that changed is within nFirst..nLast, and the range is within the length.
+ */
+static bool is_marked(const uint8_t *pBefore, const uint8_t *pAfter, uint32_t nLength, uint32_t nFirst, uint32_t nLast) {
+	for (uint32_t i = 0; i < nLength; i++) {
+		if ((pBefore[i] != pAfter[i]) && ((i < nFirst) || (i > nLast))) {
+			return false;
+		}
+	}
+
+	return (nFirst > nLast) || (nLast < nLength);
+}
+
+static void random_fill(uint8_t *pData, uint32_t nLength) {
+	const auto nMode = static_cast<uint32_t>(rand()) % 3;
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		if (nMode == 0) {
+			pData[i] = static_cast<uint8_t>(rand());
+		} else if (nMode == 1) {
+			pData[i] = static_cast<uint8_t>(rand() % 4);	// Mostly equal to the other source
+		} else {
+			pData[i] = (rand() % 64) == 0 ? static_cast<uint8_t>(rand()) : pData[i];	// A few slots change
+		}
+	}
+}
+
+static void test(uint32_t nOffset, uint32_t nLength) {
+	static uint8_t source[MAX_LENGTH + 64];
+	static uint8_t other[MAX_LENGTH + 64];
+	static uint8_t shadow[MAX_LENGTH + 64];
+	static uint8_t output[MAX_LENGTH + 64];
+	static uint8_t before[MAX_LENGTH + 64];
+	static uint8_t expectedShadow[MAX_LENGTH + 64];
+	static uint8_t expectedOutput[MAX_LENGTH + 64];
+
+	random_fill(&source[nOffset], nLength);
+	random_fill(&other[nOffset], nLength);
+	random_fill(&output[nOffset], nLength);
+	memcpy(before, &output[nOffset], nLength);
+
+	reference_htp(expectedShadow, expectedOutput, &source[nOffset], &other[nOffset], nLength);
+
+	uint32_t nFirst = UINT32_MAX;
+	uint32_t nLast = 0;
+
+	lightset::merge::htp(&shadow[nOffset], &output[nOffset], &source[nOffset], &other[nOffset], nLength, nFirst, nLast);
+
+	check("htp shadow", nOffset, nLength, memcmp(&shadow[nOffset], expectedShadow, nLength) == 0);
+	check("htp output", nOffset, nLength, memcmp(&output[nOffset], expectedOutput, nLength) == 0);
+	check("htp range", nOffset, nLength, is_marked(before, &output[nOffset], nLength, nFirst, nLast));
+
+	random_fill(&source[nOffset], nLength);
+	memcpy(before, &output[nOffset], nLength);
+
+	nFirst = UINT32_MAX;
+	nLast = 0;
+
+	lightset::merge::ltp(&shadow[nOffset], &output[nOffset], &source[nOffset], nLength, nFirst, nLast);
+
+	check("ltp shadow", nOffset, nLength, memcmp(&shadow[nOffset], &source[nOffset], nLength) == 0);
+	check("ltp output", nOffset, nLength, memcmp(&output[nOffset], &source[nOffset], nLength) == 0);
+	check("ltp range", nOffset, nLength, is_marked(before, &output[nOffset], nLength, nFirst, nLast));
+}
+
+typedef void (*merge_t)(uint8_t *pShadow, uint8_t *pOutput, const uint8_t *pSource, const uint8_t *pOther);
+
+static void scalar(uint8_t *pShadow, uint8_t *pOutput, const uint8_t *pSource, const uint8_t *pOther) {
+	reference_htp(pShadow, pOutput, pSource, pOther, MAX_LENGTH);
+}
+
+static void kernel(uint8_t *pShadow, uint8_t *pOutput, const uint8_t *pSource, const uint8_t *pOther) {
+	uint32_t nFirst = UINT32_MAX;
+	uint32_t nLast = 0;
+
+	lightset::merge::htp(pShadow, pOutput, pSource, pOther, MAX_LENGTH, nFirst, nLast);
+}
+
+/*
+ * Nanoseconds per merge of a full universe, the source changes every call.
+ */
+static double timing(merge_t merge) {
+	static constexpr uint32_t ROUNDS = 200000;
+	static uint8_t sources[4][MAX_LENGTH];
+	static uint8_t other[MAX_LENGTH];
+	static uint8_t shadow[MAX_LENGTH];
+	static uint8_t output[MAX_LENGTH];
+
+	for (uint32_t n = 0; n < 4; n++) {
+		random_fill(sources[n], MAX_LENGTH);
+	}
+
+	random_fill(other, MAX_LENGTH);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t n = 0; n < ROUNDS; n++) {
+		merge(shadow, output, sources[n & 3], other);
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / ROUNDS;
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	srand(1);
+
+	for (uint32_t nOffset = 0; nOffset < 16; nOffset++) {
+		for (uint32_t nLength = 0; nLength <= MAX_LENGTH; nLength++) {
+			test(nOffset, nLength);
+		}
+	}
+
+	for (uint32_t n = 0; n < 100000; n++) {
+		test(static_cast<uint32_t>(rand()) % 64, static_cast<uint32_t>(rand()) % (MAX_LENGTH + 1));
+	}
+
+	const auto nScalar = timing(scalar);
+	const auto nKernel = timing(kernel);
+
+	printf("%s: %u slots, scalar %.1f ns, kernel %.1f ns (%.2fx)\n", argv[0], MAX_LENGTH, nScalar, nKernel, nScalar / nKernel);
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
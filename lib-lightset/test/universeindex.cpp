@@ -0,0 +1,216 @@
+/**
+ * @file universeindex.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Replays a capture of 64 universes through the linear port dispatch
+ * that ArtNetNode::HandleDmx and E131Bridge::HandleDmx used before,
+ * and through lightset::UniverseIndex. Both must select the same output ports.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+
+#include "lightsetuniverseindex.h"
+
+static constexpr uint32_t MAX_PORTS = 64;			// LightSet64with4
+static constexpr uint32_t CAPTURE_UNIVERSES = 64;
+static constexpr uint32_t CAPTURE_FRAMES = 44;		// One second at the DMX refresh rate
+static constexpr uint32_t CAPTURE_PACKETS = CAPTURE_UNIVERSES * CAPTURE_FRAMES;
+
+struct Port {
+	uint16_t nUniverse;
+	bool bIsEnabled;
+};
+
+static Port s_Ports[MAX_PORTS];
+static lightset::UniverseIndex<MAX_PORTS> s_Index;
+static uint16_t s_Capture[CAPTURE_PACKETS];
+
+/*
+ * As UpdateOutputPortIndex in the nodes
+ */
+static void update_index() {
+	s_Index.Clear();
+
+	for (uint32_t nPortIndex = 0; nPortIndex < MAX_PORTS; nPortIndex++) {
+		if (s_Ports[nPortIndex].bIsEnabled) {
+			s_Index.Add(s_Ports[nPortIndex].nUniverse, nPortIndex);
+		}
+	}
+}
+
+static uint32_t dispatch_linear(uint16_t nUniverse, uint8_t *pPorts) {
+	uint32_t nPorts = 0;
+
+	for (uint32_t nPortIndex = 0; nPortIndex < MAX_PORTS; nPortIndex++) {
+		if (s_Ports[nPortIndex].bIsEnabled && (s_Ports[nPortIndex].nUniverse == nUniverse)) {
+			pPorts[nPorts++] = static_cast<uint8_t>(nPortIndex);
+		}
+	}
+
+	return nPorts;
+}
+
+static uint32_t dispatch_indexed(uint16_t nUniverse, uint8_t *pPorts) {
+	uint32_t nBegin, nEnd;
+	s_Index.Find(nUniverse, nBegin, nEnd);
+
+	uint32_t nPorts = 0;
+
+	for (auto nEntry = nBegin; nEntry < nEnd; nEntry++) {
+		pPorts[nPorts++] = static_cast<uint8_t>(s_Index.GetPortIndex(nEntry));
+	}
+
+	return nPorts;
+}
+
+/*
+ * The ports are on consecutive universes from nBase, some share a universe, some are disabled.
+ * The controller sends 64 universes from nBase, a few are not subscribed.
+ */
+static void configure(uint16_t nBase, uint32_t nDisabled, uint32_t nShared) {
+	for (uint32_t nPortIndex = 0; nPortIndex < MAX_PORTS; nPortIndex++) {
+		s_Ports[nPortIndex].nUniverse = static_cast<uint16_t>(nBase + nPortIndex);
+		s_Ports[nPortIndex].bIsEnabled = true;
+	}
+
+	for (uint32_t i = 0; i < nDisabled; i++) {
+		s_Ports[static_cast<uint32_t>(rand()) % MAX_PORTS].bIsEnabled = false;
+	}
+
+	for (uint32_t i = 0; i < nShared; i++) {
+		s_Ports[static_cast<uint32_t>(rand()) % MAX_PORTS].nUniverse = static_cast<uint16_t>(nBase + static_cast<uint32_t>(rand()) % MAX_PORTS);
+	}
+
+	update_index();
+
+	for (uint32_t nFrame = 0; nFrame < CAPTURE_FRAMES; nFrame++) {
+		for (uint32_t i = 0; i < CAPTURE_UNIVERSES; i++) {
+			s_Capture[nFrame * CAPTURE_UNIVERSES + i] = static_cast<uint16_t>(nBase + i);
+		}
+	}
+}
+
+static uint32_t s_errors;
+
+static void check(uint16_t nUniverse) {
+	uint8_t linear[MAX_PORTS];
+	uint8_t indexed[MAX_PORTS];
+
+	const auto nLinear = dispatch_linear(nUniverse, linear);
+	const auto nIndexed = dispatch_indexed(nUniverse, indexed);
+
+	bool isOk = (nLinear == nIndexed);
+
+	for (uint32_t i = 0; isOk && (i < nLinear); i++) {
+		isOk = (linear[i] == indexed[i]);
+	}
+
+	if (!isOk) {
+		if (s_errors < 10) {
+			printf("universe=%u: linear %u ports, indexed %u ports\n", nUniverse, nLinear, nIndexed);
+		}
+		s_errors++;
+	}
+}
+
+typedef uint32_t (*dispatch_t)(uint16_t nUniverse, uint8_t *pPorts);
+
+/*
+ * Nanoseconds per packet of the capture
+ */
+static double timing(dispatch_t dispatch) {
+	static constexpr uint32_t ROUNDS = 500;
+	uint8_t ports[MAX_PORTS];
+	uint32_t nDispatched = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t n = 0; n < ROUNDS; n++) {
+		for (uint32_t i = 0; i < CAPTURE_PACKETS; i++) {
+			nDispatched += dispatch(s_Capture[i], ports);
+		}
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	if (nDispatched == 0) {
+		s_errors++;
+	}
+
+	return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / (ROUNDS * CAPTURE_PACKETS);
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	srand(1);
+
+	/* Port configurations, every universe of the capture and the ones around it */
+	for (uint32_t n = 0; n < 1000; n++) {
+		const auto nBase = static_cast<uint16_t>(static_cast<uint32_t>(rand()) % (0x8000 - MAX_PORTS));
+
+		configure(nBase, static_cast<uint32_t>(rand()) % 16, static_cast<uint32_t>(rand()) % 16);
+
+		for (uint32_t nUniverse = (nBase > 0 ? nBase - 1U : 0); nUniverse <= (nBase + MAX_PORTS); nUniverse++) {
+			check(static_cast<uint16_t>(nUniverse));
+		}
+
+		check(0);
+		check(0x7FFF);
+	}
+
+	/* All ports on one universe, no port enabled */
+	configure(1, 0, 0);
+
+	for (uint32_t nPortIndex = 0; nPortIndex < MAX_PORTS; nPortIndex++) {
+		s_Ports[nPortIndex].nUniverse = 1;
+	}
+
+	update_index();
+	check(1);
+	check(2);
+
+	for (uint32_t nPortIndex = 0; nPortIndex < MAX_PORTS; nPortIndex++) {
+		s_Ports[nPortIndex].bIsEnabled = false;
+	}
+
+	update_index();
+	check(1);
+
+	/* The replay */
+	configure(1, 4, 4);
+
+	const auto nLinear = timing(dispatch_linear);
+	const auto nIndexed = timing(dispatch_indexed);
+
+	printf("%s: %u ports, %u packets, linear %.1f ns, indexed %.1f ns per packet (%.2fx)\n", argv[0], MAX_PORTS, CAPTURE_PACKETS, nLinear, nIndexed, nLinear / nIndexed);
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
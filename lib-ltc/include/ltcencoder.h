@@ -55,12 +55,19 @@ private:
 	bool GetParity(uint32_t nValue);
 	void SetPolarity(uint32_t nType);
 	uint8_t ReverseBits(uint8_t nBits);
+	void BuildFragments();
+	void EncodeNibbles(uint32_t nFirst, uint32_t nLast);
 
 private:
 	uint8_t *m_pLtcBits{nullptr};
 	int16_t *m_pBuffer{nullptr};
+	int16_t *m_pFragments{nullptr};
 	uint32_t m_nBufferSize;
 	uint32_t m_nType{0xFF};
+	uint32_t m_nFragmentsType{0xFF};
+	uint32_t m_nEncodedType{0xFF};
+	uint8_t m_Encoded[10];	///< The LTC frame that is in m_pBuffer
+	uint8_t m_Level[21];	///< Level at the start of each nibble, 1 is high
 
 	static LtcEncoder *s_pThis;
 };
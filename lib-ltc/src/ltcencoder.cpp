@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 
 #include "ltcencoder.h"
@@ -46,6 +47,9 @@
 
 #define SYNC_WORD_VALUE			0x3FFD
 
+#define NIBBLES					(2 * FORMAT_SIZE_BYTES)
+#define FRAGMENT_SIZE_MAX		(4 * 25)	///< 4 bits of the largest table
+
 struct TLtcFormatTemplate {
 	union TLtcFormat {
 		uint8_t bytes[FORMAT_SIZE_BYTES];
@@ -104,6 +108,11 @@ LtcEncoder::LtcEncoder() : m_nBufferSize(SAMPLE_RATE / 24) {
 	m_pBuffer = new int16_t[m_nBufferSize];
 	assert(m_pBuffer != nullptr);
 
+	m_pFragments = new int16_t[2 * 16 * FRAGMENT_SIZE_MAX];
+	assert(m_pFragments != nullptr);
+
+	m_Level[0] = 0;	// Rising first
+
 	DEBUG_PRINTF("m_pBuffer=%p", reinterpret_cast<void *>(m_pBuffer));
 
 	auto *p = reinterpret_cast<struct TLtcFormatTemplate*>(m_pLtcBits);
@@ -116,6 +125,9 @@ LtcEncoder::LtcEncoder() : m_nBufferSize(SAMPLE_RATE / 24) {
 }
 
 LtcEncoder::~LtcEncoder() {
+	delete [] m_pFragments;
+	m_pFragments = nullptr;
+
 	delete [] m_pBuffer;
 	m_pBuffer = nullptr;
 
@@ -204,43 +216,100 @@ void LtcEncoder::SetPolarity(uint32_t nType) {
 	}
 }
 
+/*
+ * The biphase mark waveform of a nibble only depends on its value and on the level it starts with.
+ * The 2 x 16 waveform fragments are built once per frame rate.
+ */
+void LtcEncoder::BuildFragments() {
+	const auto nSize = sTables[m_nType].nSize;
+
+	for (uint32_t nLevel = 0; nLevel < 2; nLevel++) {
+		for (uint32_t nNibble = 0; nNibble < 16; nNibble++) {
+			auto *pDst = &m_pFragments[((nLevel << 4) + nNibble) * FRAGMENT_SIZE_MAX];
+			auto bHigh = (nLevel != 0);
+
+			for (uint32_t nMask = 0x8; nMask != 0; nMask >>= 1) {
+				uint32_t nIdx;
+
+				if (nNibble & nMask) {	// '1', transition in the middle, ends at the level it started with
+					nIdx = bHigh ? 2 : 3;
+				} else {				// '0', no transition in the middle
+					nIdx = bHigh ? 1 : 0;
+					bHigh = !bHigh;
+				}
+
+				memcpy(pDst, sTables[m_nType].Samples[nIdx], nSize * sizeof(int16_t));
+				pDst += nSize;
+			}
+		}
+	}
+
+	m_nFragmentsType = m_nType;
+}
+
+void LtcEncoder::EncodeNibbles(uint32_t nFirst, uint32_t nLast) {
+	const auto *p = reinterpret_cast<struct TLtcFormatTemplate*>(m_pLtcBits);
+	const auto nFragmentSize = 4 * sTables[m_nType].nSize;
+
+	auto nLevel = m_Level[nFirst];
+
+	for (uint32_t nIndex = nFirst; nIndex <= nLast; nIndex++) {
+		const auto nByte = p->Format.bytes[nIndex >> 1];
+		const auto nNibble = static_cast<uint32_t>((nIndex & 0x1) ? (nByte & 0xF) : (nByte >> 4));
+
+		m_Level[nIndex] = nLevel;
+
+		memcpy(&m_pBuffer[nIndex * nFragmentSize], &m_pFragments[((static_cast<uint32_t>(nLevel) << 4) + nNibble) * FRAGMENT_SIZE_MAX], nFragmentSize * sizeof(int16_t));
+
+		// Each '0' flips the level at the end of the bit
+		nLevel = static_cast<uint8_t>(nLevel ^ (__builtin_popcount(~nNibble & 0xF) & 0x1));
+	}
+
+	m_Level[nLast + 1] = nLevel;
+}
+
+/*
+ * Only the nibbles from the first to the last one that changed since the previous frame are encoded again.
+ * The level at the start of the first changed nibble depends on the unchanged nibbles before it only.
+ * The polarity bit keeps the number of 0 bits in a frame even, so the nibbles after the last changed one
+ * start at the same level as before.
+ */
 void LtcEncoder::Encode() {
-	const struct TLtcFormatTemplate *p = reinterpret_cast<struct TLtcFormatTemplate*>(m_pLtcBits);
+	const auto *p = reinterpret_cast<struct TLtcFormatTemplate*>(m_pLtcBits);
 
-	int16_t *dst = m_pBuffer;
-	uint32_t nIdx;
+	if (__builtin_expect((m_nType != m_nFragmentsType), 0)) {
+		BuildFragments();
+	}
 
-	uint32_t nIdxPrevious = 1; // Force rising first
+	if (__builtin_expect((m_nType != m_nEncodedType), 0)) {
+		m_nEncodedType = m_nType;
+		memcpy(m_Encoded, p->Format.bytes, FORMAT_SIZE_BYTES);
+		EncodeNibbles(0, NIBBLES - 1);
+		return;
+	}
 
-	for (uint32_t nBytesIndex = 0; nBytesIndex < FORMAT_SIZE_BYTES; nBytesIndex++) {
-		uint32_t w = p->Format.bytes[nBytesIndex];
+	uint32_t nFirst = 0;
 
-		for (uint32_t mask = 0x80; mask != 0; mask >>= 1) {
-			if (mask & w) {	// '1'
-				if ((nIdxPrevious == 0) || (nIdxPrevious == 2)) {
-					nIdx = 2;
-				} else {
-					nIdx = 3;
-				}
-			} else { // '0'
-				if ((nIdxPrevious == 0) || (nIdxPrevious == 2)) {
-					nIdx = 1;
-				} else {
-					nIdx = 0;
-				}
-			}
+	while ((nFirst < FORMAT_SIZE_BYTES) && (p->Format.bytes[nFirst] == m_Encoded[nFirst])) {
+		nFirst++;
+	}
 
-			nIdxPrevious = nIdx;
+	if (nFirst == FORMAT_SIZE_BYTES) {
+		return;
+	}
 
-			const int16_t *src = sTables[m_nType].Samples[nIdx];
+	auto nLast = static_cast<uint32_t>(FORMAT_SIZE_BYTES - 1);
 
-			for (uint32_t i = 0; i < sTables[m_nType].nSize; i ++) {
-				*dst = *src;
-				dst++;
-				src++;
-			}
-		}
+	while (p->Format.bytes[nLast] == m_Encoded[nLast]) {
+		nLast--;
 	}
+
+	const auto nFirstNibble = (2 * nFirst) + (((p->Format.bytes[nFirst] ^ m_Encoded[nFirst]) & 0xF0) == 0 ? 1U : 0U);
+	const auto nLastNibble = (2 * nLast) + (((p->Format.bytes[nLast] ^ m_Encoded[nLast]) & 0x0F) != 0 ? 1U : 0U);
+
+	memcpy(&m_Encoded[nFirst], &p->Format.bytes[nFirst], 1 + nLast - nFirst);
+
+	EncodeNibbles(nFirstNibble, nLastNibble);
 }
 
 uint32_t LtcEncoder::GetBufferSize() {
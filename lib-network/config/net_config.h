@@ -31,7 +31,16 @@
 # if defined (H3)
 #  define HOST_NAME_PREFIX				"allwinner_"
 #  define UDP_MAX_PORTS_ALLOWED			16
+#  define UDP_RX_MAX_ENTRIES			32	/* Per port, must be a power of 2 */
+#  define UDP_RX_MAX_HELD				40	/* Must be less than the number of EMAC RX descriptors (48) */
+#  define UDP_RX_MAX_HELD_PORT			8	/* Per port, the other datagrams are copied */
+#  define UDP_RX_MAX_COPY				2	/* Per port, copy buffers */
+#  define UDP_RX_EVICT_DISTANCE			8	/* A held descriptor this close to the RX DMA is copied out */
+#  define NET_RX_BATCH_MAX				8	/* Frames handled per net_handle() call */
+#  define NET_RX_BATCH_BUDGET_US		250
 #  define IGMP_MAX_JOINS_ALLOWED		(4 + (8 * 4)) /* 8 outputs x 4 Universes */
+#  define ARP_MAX_RECORDS				64	/* Must be a power of 2 */
+#  define ARP_PENDING_MAX				8	/* Datagrams waiting for ARP resolution */
 # elif defined (GD32)
 #  define HOST_NAME_PREFIX				"gigadevice_"
 #  if !defined (UDP_MAX_PORTS_ALLOWED)
@@ -40,6 +49,33 @@
 #  if !defined (IGMP_MAX_JOINS_ALLOWED)
 #   define IGMP_MAX_JOINS_ALLOWED		(4 + (8 * 4)) /* 8 outputs x 4 Universes */
 #  endif
+#  if !defined (UDP_RX_MAX_ENTRIES)
+#   define UDP_RX_MAX_ENTRIES			16
+#  endif
+#  if !defined (UDP_RX_MAX_HELD)
+#   define UDP_RX_MAX_HELD				(UDP_RX_MAX_ENTRIES)
+#  endif
+#  if !defined (UDP_RX_MAX_HELD_PORT)
+#   define UDP_RX_MAX_HELD_PORT			4
+#  endif
+#  if !defined (UDP_RX_MAX_COPY)
+#   define UDP_RX_MAX_COPY				2
+#  endif
+#  if !defined (UDP_RX_EVICT_DISTANCE)
+#   define UDP_RX_EVICT_DISTANCE		4
+#  endif
+#  if !defined (NET_RX_BATCH_MAX)
+#   define NET_RX_BATCH_MAX				4
+#  endif
+#  if !defined (NET_RX_BATCH_BUDGET_US)
+#   define NET_RX_BATCH_BUDGET_US		250
+#  endif
+#  if !defined (ARP_MAX_RECORDS)
+#   define ARP_MAX_RECORDS				16
+#  endif
+#  if !defined (ARP_PENDING_MAX)
+#   define ARP_PENDING_MAX				2
+#  endif
 # else
 #  error
 # endif
@@ -51,6 +87,46 @@
 # error
 #endif
 
+#if !defined (UDP_RX_MAX_ENTRIES) || ((UDP_RX_MAX_ENTRIES & (UDP_RX_MAX_ENTRIES - 1)) != 0)
+# error
+#endif
+
+#if !defined (UDP_RX_MAX_HELD)
+# error
+#endif
+
+#if !defined (UDP_RX_MAX_HELD_PORT) || (UDP_RX_MAX_HELD_PORT > UDP_RX_MAX_HELD)
+# error
+#endif
+
+#if !defined (UDP_RX_MAX_COPY) || (UDP_RX_MAX_COPY == 0) || (UDP_RX_MAX_COPY > 32)
+# error
+#endif
+
+#if !defined (UDP_RX_EVICT_DISTANCE)
+# error
+#endif
+
+#if !defined (NET_RX_BATCH_MAX) || (NET_RX_BATCH_MAX == 0)
+# error
+#endif
+
+#if !defined (ARP_MAX_RECORDS) || ((ARP_MAX_RECORDS & (ARP_MAX_RECORDS - 1)) != 0)
+# error
+#endif
+
+#if !defined (ARP_TTL_SECONDS)
+# define ARP_TTL_SECONDS				300	/* An entry is refreshed after this time */
+#endif
+
+#if !defined (ARP_PENDING_MAX)
+# error
+#endif
+
+#if !defined (NET_RX_BATCH_BUDGET_US)
+# error
+#endif
+
 #if !defined (IGMP_MAX_JOINS_ALLOWED)
 # error
 #endif
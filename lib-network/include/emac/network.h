@@ -67,14 +67,52 @@ public:
 		return udp_recv(static_cast<uint8_t>(nHandle), reinterpret_cast<uint8_t*>(pBuffer), nLength, from_ip, from_port);
 	}
 
+	/**
+	 * Zero-copy, *ppBuffer is valid until RecvRelease or the next RecvFrom for nHandle.
+	 */
 	uint16_t RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort) {
 		return udp_recv2(static_cast<uint8_t>(nHandle), reinterpret_cast<const uint8_t **>(ppBuffer), pFromIp, pFromPort);
 	}
 
+	void RecvRelease(int32_t nHandle) {
+		udp_recv2_release(static_cast<uint8_t>(nHandle));
+	}
+
+	/**
+	 * The number of datagrams for nHandle that are already queued and not read yet.
+	 */
+	uint32_t RecvBatch(int32_t nHandle) {
+		return udp_recv_pending(static_cast<uint8_t>(nHandle));
+	}
+
+	uint32_t GetRxOverflow(int32_t nHandle) {
+		return udp_get_rx_overflow(static_cast<uint8_t>(nHandle));
+	}
+
 	void SendTo(int32_t nHandle, const void *pBuffer, uint16_t nLength, uint32_t to_ip, uint16_t remote_port) {
 		udp_send(static_cast<uint8_t>(nHandle), reinterpret_cast<const uint8_t*>(pBuffer), nLength, to_ip, remote_port);
 	}
 
+	/**
+	 * Zero-copy send. The returned buffer is in the EMAC TX descriptor, the headers are filled in by SendCommit.
+	 * There must be no other network calls before SendCommit.
+	 * An unresolved destination gets a pending buffer, that is sent when the ARP reply comes in.
+	 * Returns nullptr when there is no pending buffer available.
+	 */
+	void *SendBegin(int32_t nHandle, uint32_t nToIp, uint16_t nRemotePort) {
+		return udp_send_begin(static_cast<uint8_t>(nHandle), nToIp, nRemotePort);
+	}
+
+	void SendCommit(uint16_t nLength) {
+		udp_send_commit(nLength);
+	}
+
+	/**
+	 * Each datagram goes straight into its own TX descriptor, there is nothing to batch.
+	 */
+	void SendBatchBegin() {}
+	void SendBatchEnd() {}
+
 	/*
 	 * Experimental TCP
 	 */
@@ -91,7 +91,14 @@ public:
 
 	uint16_t RecvFrom(int32_t nHandle, void *pBuffer, uint16_t nLength, uint32_t *pFromIp, uint16_t *pFromPort);
 	uint16_t RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort);
+	uint32_t RecvBatch(__attribute__((unused)) int32_t nHandle) {
+		return 0;
+	}
 	void SendTo(int32_t nHandle, const void *pBuffer, uint16_t nLength, uint32_t nToIp, uint16_t nRemotePort) ;
+	void *SendBegin(int32_t nHandle, uint32_t nToIp, uint16_t nRemotePort);
+	void SendCommit(uint16_t nLength);
+	void SendBatchBegin() {}
+	void SendBatchEnd() {}
 
 	void Print() {
 	}
@@ -55,7 +55,23 @@ public:
 
 	uint16_t RecvFrom(int32_t nHandle, void *pBuffer, uint16_t nLength, uint32_t *pFromIp, uint16_t *pFromPort);
 	uint16_t RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort);
+	void RecvRelease(__attribute__((unused)) int32_t nHandle) {}
+	/**
+	 * The number of datagrams for nHandle that are already received and not read yet.
+	 * RecvFrom returns these without a system call.
+	 */
+	uint32_t RecvBatch(int32_t nHandle);
+	uint32_t GetRxOverflow(__attribute__((unused)) int32_t nHandle) {
+		return 0;
+	}
 	void SendTo(int32_t nHandle, const void *pBuffer, uint16_t nLength, uint32_t nToIp, uint16_t nRemotePort);
+	void *SendBegin(int32_t nHandle, uint32_t nToIp, uint16_t nRemotePort);
+	void SendCommit(uint16_t nLength);
+	/**
+	 * The datagrams sent between SendBatchBegin and SendBatchEnd are sent with one sendmmsg.
+	 */
+	void SendBatchBegin();
+	void SendBatchEnd();
 
 	/*
 	 * Experimental TCP
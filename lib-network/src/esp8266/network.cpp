@@ -149,6 +149,28 @@ void Network::SendTo(__attribute__((unused)) int32_t nHandle, const void *pBuffe
 	esp8266_write_bytes(reinterpret_cast<const uint8_t *>(pBuffer), nLength);
 }
 
+/*
+ * There is no zero-copy send, the datagram is built in a buffer and sent with SendTo.
+ */
+
+static uint8_t s_SendBuffer[MAX_SEGMENT_LENGTH];
+static int32_t s_nSendHandle;
+static uint32_t s_nSendToIp;
+static uint16_t s_nSendRemotePort;
+
+void *Network::SendBegin(int32_t nHandle, uint32_t nToIp, uint16_t nRemotePort) {
+	s_nSendHandle = nHandle;
+	s_nSendToIp = nToIp;
+	s_nSendRemotePort = nRemotePort;
+
+	return s_SendBuffer;
+}
+
+void Network::SendCommit(uint16_t nLength) {
+	assert(nLength <= MAX_SEGMENT_LENGTH);
+	SendTo(s_nSendHandle, s_SendBuffer, nLength, s_nSendToIp, s_nSendRemotePort);
+}
+
 bool Network::Start() {
 	struct ip_info ip_config;
 
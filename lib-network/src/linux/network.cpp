@@ -34,6 +34,13 @@
 #include <ifaddrs.h>
 #include <errno.h>
 #include <cassert>
+#if defined (__linux__)
+# include <sys/socket.h>
+/*
+ * recvmmsg and sendmmsg are Linux only
+ */
+# define NETWORK_BATCH
+#endif
 
 #include "network.h"
 
@@ -46,7 +53,9 @@
 
 #define MAX_SEGMENT_LENGTH		1400
 
+#if !defined (NETWORK_BATCH)
 static uint8_t s_ReadBuffer[MAX_SEGMENT_LENGTH];
+#endif
 
 namespace max {
 	static constexpr auto PORTS_ALLOWED = 32;
@@ -61,6 +70,96 @@ static int snHandles[max::PORTS_ALLOWED];
  * END
  */
 
+#if defined (NETWORK_BATCH)
+/**
+ * The datagrams are received with recvmmsg and sent with sendmmsg.
+ * The message vectors and buffers are allocated once, in Begin.
+ */
+namespace batch {
+static constexpr uint32_t MESSAGES = 32;
+static constexpr uint32_t SEGMENT_LENGTH = 1500;
+}  // namespace batch
+
+struct RecvBatch {
+	struct mmsghdr msgs[batch::MESSAGES];
+	struct iovec iov[batch::MESSAGES];
+	struct sockaddr_in from[batch::MESSAGES];
+	uint8_t buffers[batch::MESSAGES][batch::SEGMENT_LENGTH];
+	uint32_t nCount;
+	uint32_t nIndex;
+};
+
+static RecvBatch *s_pRecvBatch[max::PORTS_ALLOWED];
+static RecvBatch *s_pRecvBatchLast;
+static int32_t s_nRecvBatchHandle = -1;
+
+struct SendBatch {
+	struct mmsghdr msgs[batch::MESSAGES];
+	struct iovec iov[batch::MESSAGES];
+	struct sockaddr_in to[batch::MESSAGES];
+	uint8_t buffers[batch::MESSAGES][batch::SEGMENT_LENGTH];
+	int32_t nHandle;
+	uint32_t nCount;
+	bool bActive;
+};
+
+static SendBatch s_SendBatch;
+
+static RecvBatch *recv_batch_create() {
+	auto *pBatch = new RecvBatch;
+	assert(pBatch != nullptr);
+
+	memset(pBatch->msgs, 0, sizeof(pBatch->msgs));
+
+	for (uint32_t i = 0; i < batch::MESSAGES; i++) {
+		pBatch->iov[i].iov_base = pBatch->buffers[i];
+		pBatch->iov[i].iov_len = batch::SEGMENT_LENGTH;
+		pBatch->msgs[i].msg_hdr.msg_iov = &pBatch->iov[i];
+		pBatch->msgs[i].msg_hdr.msg_iovlen = 1;
+		pBatch->msgs[i].msg_hdr.msg_name = &pBatch->from[i];
+		pBatch->msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	pBatch->nCount = 0;
+	pBatch->nIndex = 0;
+
+	return pBatch;
+}
+
+static void send_batch_init() {
+	memset(s_SendBatch.msgs, 0, sizeof(s_SendBatch.msgs));
+
+	for (uint32_t i = 0; i < batch::MESSAGES; i++) {
+		s_SendBatch.iov[i].iov_base = s_SendBatch.buffers[i];
+		s_SendBatch.msgs[i].msg_hdr.msg_iov = &s_SendBatch.iov[i];
+		s_SendBatch.msgs[i].msg_hdr.msg_iovlen = 1;
+		s_SendBatch.msgs[i].msg_hdr.msg_name = &s_SendBatch.to[i];
+		s_SendBatch.msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	s_SendBatch.nHandle = -1;
+	s_SendBatch.nCount = 0;
+	s_SendBatch.bActive = false;
+}
+
+static void send_flush() {
+	uint32_t nOffset = 0;
+
+	while (nOffset < s_SendBatch.nCount) {
+		const auto nResult = sendmmsg(s_SendBatch.nHandle, &s_SendBatch.msgs[nOffset], s_SendBatch.nCount - nOffset, 0);
+
+		if (nResult <= 0) {
+			perror("sendmmsg");
+			break;
+		}
+
+		nOffset += static_cast<uint32_t>(nResult);
+	}
+
+	s_SendBatch.nCount = 0;
+}
+#endif
+
 Network *Network::s_pThis = nullptr;
 
 Network::Network() {
@@ -93,6 +192,10 @@ int Network::Init(const char *s) {
 		snHandles[i] = -1;
 	}
 
+#if defined (NETWORK_BATCH)
+	send_batch_init();
+#endif
+
 	NetworkParams params;
 	params.Load();
 	params.Dump();
@@ -224,6 +327,26 @@ int32_t Network::Begin(uint16_t nPort) {
 		exit(EXIT_FAILURE);
 	}
 
+#if defined (CONFIG_NETWORK_SO_RCVBUF)
+	/*
+	 * A larger receive buffer absorbs the bursts of hundreds of universes per frame
+	 */
+	val = CONFIG_NETWORK_SO_RCVBUF;
+	if (setsockopt(nSocket, SOL_SOCKET, SO_RCVBUF, &val, sizeof(val)) == -1) {
+		perror("setsockopt(SO_RCVBUF)");
+	}
+#endif
+
+#if defined (CONFIG_NETWORK_SO_BUSY_POLL) && defined (SO_BUSY_POLL)
+	/*
+	 * Microseconds to busy poll the device queue, trades CPU for latency
+	 */
+	val = CONFIG_NETWORK_SO_BUSY_POLL;
+	if (setsockopt(nSocket, SOL_SOCKET, SO_BUSY_POLL, &val, sizeof(val)) == -1) {
+		perror("setsockopt(SO_BUSY_POLL)");
+	}
+#endif
+
     memset(&si_me, 0, sizeof(si_me));
 
     si_me.sin_family = AF_INET;
@@ -250,6 +373,10 @@ int32_t Network::Begin(uint16_t nPort) {
 
 	snHandles[i] = nSocket;
 
+#if defined (NETWORK_BATCH)
+	s_pRecvBatch[i] = recv_batch_create();
+#endif
+
 	DEBUG_PRINTF("nSocket=%d", nSocket);
 	DEBUG_EXIT
 	return nSocket;
@@ -277,12 +404,25 @@ int32_t Network::End(uint16_t nPort) {
 	for (i = 0; i < max::PORTS_ALLOWED; i++) {
 		if (s_ports_allowed[i] == nPort) {
 			s_ports_allowed[i] = 0;
+#if defined (NETWORK_BATCH)
+			if ((s_SendBatch.nCount != 0) && (s_SendBatch.nHandle == snHandles[i])) {
+				send_flush();
+			}
+#endif
 			printf("close");
 			if (close(snHandles[i]) == -1) {
 				perror("unbind");
 				exit(EXIT_FAILURE);
 			}
 			snHandles[i] = -1;
+#if defined (NETWORK_BATCH)
+			if (s_pRecvBatchLast == s_pRecvBatch[i]) {
+				s_pRecvBatchLast = nullptr;
+				s_nRecvBatchHandle = -1;
+			}
+			delete s_pRecvBatch[i];
+			s_pRecvBatch[i] = nullptr;
+#endif
 			return 0;
 		}
 	}
@@ -380,6 +520,150 @@ void Network::LeaveGroup(int32_t nHandle, uint32_t ip) {
 	}
 }
 
+#if defined (NETWORK_BATCH)
+static RecvBatch *recv_batch(int32_t nHandle) {
+	if (nHandle == s_nRecvBatchHandle) {
+		return s_pRecvBatchLast;
+	}
+
+	for (uint32_t i = 0; i < max::PORTS_ALLOWED; i++) {
+		if (snHandles[i] == nHandle) {
+			s_nRecvBatchHandle = nHandle;
+			s_pRecvBatchLast = s_pRecvBatch[i];
+			return s_pRecvBatchLast;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Returns the next datagram of the batch, the batch is refilled with one recvmmsg when it is empty.
+ */
+static uint32_t recv_next(int32_t nHandle, const uint8_t **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort) {
+	auto *pBatch = recv_batch(nHandle);
+	assert(pBatch != nullptr);
+
+	if (pBatch->nIndex == pBatch->nCount) {
+		pBatch->nIndex = 0;
+		pBatch->nCount = 0;
+
+		for (uint32_t i = 0; i < batch::MESSAGES; i++) {
+			pBatch->msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+		}
+
+		const auto nResult = recvmmsg(nHandle, pBatch->msgs, batch::MESSAGES, MSG_DONTWAIT, nullptr);
+
+		if (nResult <= 0) {
+			if ((nResult == -1) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) { // EAGAIN and EWOULDBLOCK can be equal
+				DEBUG_PRINTF("nHandle=%d", nHandle);
+				perror("recvmmsg");
+			}
+			return 0;
+		}
+
+		pBatch->nCount = static_cast<uint32_t>(nResult);
+	}
+
+	const auto nIndex = pBatch->nIndex++;
+
+	*ppBuffer = pBatch->buffers[nIndex];
+	*pFromIp = pBatch->from[nIndex].sin_addr.s_addr;
+	*pFromPort = ntohs(pBatch->from[nIndex].sin_port);
+
+	return pBatch->msgs[nIndex].msg_len;
+}
+
+uint16_t Network::RecvFrom(int32_t nHandle, void *pPacket, uint16_t nSize, uint32_t *pFromIp, uint16_t *pFromPort) {
+	assert(pPacket != nullptr);
+	assert(pFromIp != nullptr);
+	assert(pFromPort != nullptr);
+
+	const uint8_t *pBuffer;
+	auto nLength = recv_next(nHandle, &pBuffer, pFromIp, pFromPort);
+
+	if (nLength > nSize) {
+		nLength = nSize;
+	}
+
+	memcpy(pPacket, pBuffer, nLength);
+
+	return static_cast<uint16_t>(nLength);
+}
+
+uint16_t Network::RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFromIp, uint16_t *pFromPort) {
+	assert(ppBuffer != nullptr);
+	assert(pFromIp != nullptr);
+	assert(pFromPort != nullptr);
+
+	const uint8_t *pBuffer;
+	const auto nLength = recv_next(nHandle, &pBuffer, pFromIp, pFromPort);
+
+	*ppBuffer = pBuffer;
+
+	return static_cast<uint16_t>(nLength);
+}
+
+uint32_t Network::RecvBatch(int32_t nHandle) {
+	const auto *pBatch = recv_batch(nHandle);
+
+	if (pBatch == nullptr) {
+		return 0;
+	}
+
+	return pBatch->nCount - pBatch->nIndex;
+}
+
+/**
+ * A SendTo between SendBatchBegin and SendBatchEnd is queued, the queue is sent with one sendmmsg.
+ * The queue is flushed when it is full or when the handle changes.
+ */
+void Network::SendBatchBegin() {
+	s_SendBatch.bActive = true;
+}
+
+void Network::SendBatchEnd() {
+	send_flush();
+	s_SendBatch.bActive = false;
+}
+
+void Network::SendTo(int32_t nHandle, const void *pPacket, uint16_t nSize, uint32_t nToIp, uint16_t nRemotePort) {
+	assert(nSize <= batch::SEGMENT_LENGTH);
+
+	if (!s_SendBatch.bActive) {
+		struct sockaddr_in si_other;
+
+		si_other.sin_family = AF_INET;
+		si_other.sin_addr.s_addr = nToIp;
+		si_other.sin_port = htons(nRemotePort);
+
+		if (sendto(nHandle, pPacket, nSize, 0, reinterpret_cast<struct sockaddr*>(&si_other), sizeof(si_other)) == -1) {
+			perror("sendto");
+		}
+
+		return;
+	}
+
+	if ((s_SendBatch.nCount != 0) && (s_SendBatch.nHandle != nHandle)) {
+		send_flush();
+	}
+
+	const auto nIndex = s_SendBatch.nCount;
+
+	s_SendBatch.nHandle = nHandle;
+	s_SendBatch.to[nIndex].sin_family = AF_INET;
+	s_SendBatch.to[nIndex].sin_addr.s_addr = nToIp;
+	s_SendBatch.to[nIndex].sin_port = htons(nRemotePort);
+	s_SendBatch.iov[nIndex].iov_len = nSize;
+	memcpy(s_SendBatch.buffers[nIndex], pPacket, nSize);
+
+	s_SendBatch.nCount++;
+
+	if (s_SendBatch.nCount == batch::MESSAGES) {
+		send_flush();
+	}
+}
+#else
 uint16_t Network::RecvFrom(int32_t nHandle, void *pPacket, uint16_t nSize, uint32_t *pFromIp, uint16_t *pFromPort) {
 	assert(pPacket != nullptr);
 	assert(pFromIp != nullptr);
@@ -409,17 +693,21 @@ uint16_t Network::RecvFrom(int32_t nHandle, const void **ppBuffer, uint32_t *pFr
 	return RecvFrom(nHandle, s_ReadBuffer, MAX_SEGMENT_LENGTH, pFromIp, pFromPort);
 }
 
+uint32_t Network::RecvBatch(__attribute__((unused)) int32_t nHandle) {
+	return 0;
+}
+
+void Network::SendBatchBegin() {
+}
+
+void Network::SendBatchEnd() {
+}
+
 void Network::SendTo(int32_t nHandle, const void *pPacket, uint16_t nSize, uint32_t nToIp, uint16_t nRemotePort) {
 	struct sockaddr_in si_other;
 	socklen_t slen = sizeof(si_other);
 
-#ifndef NDEBUG
-	struct in_addr in;
-	in.s_addr = nToIp;
-	printf("network_sendto(%p, %d, %s, %d)\n", pPacket, nSize, inet_ntoa(in), nRemotePort);
-#endif
-
-    si_other.sin_family = AF_INET;
+	si_other.sin_family = AF_INET;
 	si_other.sin_addr.s_addr = nToIp;
 	si_other.sin_port = htons(nRemotePort);
 
@@ -427,6 +715,29 @@ void Network::SendTo(int32_t nHandle, const void *pPacket, uint16_t nSize, uint3
 		perror("sendto");
 	}
 }
+#endif
+
+/*
+ * There is no zero-copy send, the datagram is built in a buffer and sent with SendTo.
+ */
+
+static uint8_t s_SendBuffer[MAX_SEGMENT_LENGTH];
+static int32_t s_nSendHandle;
+static uint32_t s_nSendToIp;
+static uint16_t s_nSendRemotePort;
+
+void *Network::SendBegin(int32_t nHandle, uint32_t nToIp, uint16_t nRemotePort) {
+	s_nSendHandle = nHandle;
+	s_nSendToIp = nToIp;
+	s_nSendRemotePort = nRemotePort;
+
+	return s_SendBuffer;
+}
+
+void Network::SendCommit(uint16_t nLength) {
+	assert(nLength <= MAX_SEGMENT_LENGTH);
+	SendTo(s_nSendHandle, s_SendBuffer, nLength, s_nSendToIp, s_nSendRemotePort);
+}
 
 #if defined(__linux__)
 bool Network::IsDhclient(const char* if_name) {
@@ -80,6 +80,9 @@ void arp_handle_request(struct t_arp *p_arp) {
 		return;
 	}
 
+	// The sender is going to talk to us, learn its address (RFC 826)
+	arp_cache_update(p_arp->arp.sender_mac, p_arp->arp.sender_ip);
+
 	// Ethernet header
 	memcpy(s_arp_reply.ether.dst, p_arp->ether.src, ETH_ADDR_LEN);
 
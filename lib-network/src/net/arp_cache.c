@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 
@@ -31,26 +32,43 @@
 #include "net_platform.h"
 #include "net_debug.h"
 
+#include "c/millis.h"
+
+#include "../../config/net_config.h"
+
 #ifndef ALIGNED
 # define ALIGNED __attribute__ ((aligned (4)))
 #endif
 
 extern void arp_send_request(uint32_t ip);
 extern void net_handle(void);
+extern void udp_arp_resolved(uint32_t ip);
+extern void udp_arp_failed(uint32_t ip);
 
-#define MAX_RECORDS	32
+/*
+ * Open addressing with linear probing. There is always a free record, so a probe ends.
+ */
+#define ARP_RECORDS_MASK	(ARP_MAX_RECORDS - 1)
+#define ARP_MAX_USED		((ARP_MAX_RECORDS * 3) / 4)
+#define ARP_RETRIES			3	///< Requests, one per timer tick, before an entry is removed
+#define ARP_TTL_MILLIS		(ARP_TTL_SECONDS * 1000U)
+
+typedef enum arp_state {
+	ARP_STATE_FREE,
+	ARP_STATE_PENDING,	///< Request sent, no MAC address yet
+	ARP_STATE_VALID,
+	ARP_STATE_STALE		///< The TTL is expired, the MAC address is used while it is refreshed
+} _arp_state;
 
 struct t_arp_record {
 	uint32_t ip;
+	uint32_t millis;	///< Last time the MAC address was confirmed
 	uint8_t mac_address[ETH_ADDR_LEN];
+	uint8_t state;
+	uint8_t retries;
 } ALIGNED;
 
-typedef union pcast32 {
-	uint32_t u32;
-	uint8_t u8[4];
-} _pcast32;
-
-static struct t_arp_record s_arp_records[MAX_RECORDS] SECTION_NETWORK ALIGNED;
+static struct t_arp_record s_arp_records[ARP_MAX_RECORDS] SECTION_NETWORK ALIGNED;
 static uint16_t s_entry_current SECTION_NETWORK ALIGNED;
 
 #ifndef NDEBUG
@@ -58,13 +76,84 @@ static uint16_t s_entry_current SECTION_NETWORK ALIGNED;
   static volatile uint32_t s_ticker ;
 #endif
 
+static inline uint32_t _hash(uint32_t ip) {
+	ip ^= ip >> 16;
+	ip *= 0x45d9f3b;
+	ip ^= ip >> 16;
+	return ip & ARP_RECORDS_MASK;
+}
+
+static uint32_t _find(uint32_t ip) {
+	uint32_t i = _hash(ip);
+
+	while (s_arp_records[i].state != ARP_STATE_FREE) {
+		if (s_arp_records[i].ip == ip) {
+			return i;
+		}
+		i = (i + 1) & ARP_RECORDS_MASK;
+	}
+
+	return ARP_MAX_RECORDS;
+}
+
+static struct t_arp_record *_insert(uint32_t ip) {
+	if (s_entry_current == ARP_MAX_USED) {
+		DEBUG_PUTS("ARP cache is full");
+		return NULL;
+	}
+
+	uint32_t i = _hash(ip);
+
+	while (s_arp_records[i].state != ARP_STATE_FREE) {
+		i = (i + 1) & ARP_RECORDS_MASK;
+	}
+
+	s_arp_records[i].ip = ip;
+	s_entry_current++;
+
+	return &s_arp_records[i];
+}
+
+/*
+ * Backward shift deletion, the records after i that belong before it are moved up.
+ */
+static void _delete(uint32_t i) {
+	uint32_t j = i;
+
+	s_entry_current--;
+
+	for (;;) {
+		s_arp_records[i].state = ARP_STATE_FREE;
+
+		uint32_t k;
+
+		do {
+			j = (j + 1) & ARP_RECORDS_MASK;
+
+			if (s_arp_records[j].state == ARP_STATE_FREE) {
+				return;
+			}
+
+			k = _hash(s_arp_records[j].ip);
+		} while ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)));
+
+		s_arp_records[i] = s_arp_records[j];
+		i = j;
+	}
+}
+
 void __attribute__((cold)) arp_cache_init(void) {
-	uint16_t i;
+	uint32_t i;
 
 	s_entry_current = 0;
 
-	for (i = 0; i < MAX_RECORDS; i++) {
+	for (i = 0; i < ARP_MAX_RECORDS; i++) {
+		if (s_arp_records[i].state == ARP_STATE_PENDING) {
+			udp_arp_failed(s_arp_records[i].ip);
+		}
+
 		s_arp_records[i].ip = 0;
+		s_arp_records[i].state = ARP_STATE_FREE;
 		memset(s_arp_records[i].mac_address, 0, ETH_ADDR_LEN);
 	}
 
@@ -75,64 +164,95 @@ void __attribute__((cold)) arp_cache_init(void) {
 
 void arp_cache_update(uint8_t *mac_address, uint32_t ip) {
 	DEBUG2_ENTRY
-	uint16_t i;
 
-	if (s_entry_current == MAX_RECORDS) {
-		assert(0);
+	struct t_arp_record *p_record;
+	const uint32_t i = _find(ip);
+
+	if (i != ARP_MAX_RECORDS) {
+		p_record = &s_arp_records[i];
+	} else if ((p_record = _insert(ip)) == NULL) {
+		DEBUG2_EXIT
 		return;
 	}
 
-	for (i = 0; i < s_entry_current; i++) {
-		if (s_arp_records[i].ip == ip) {
-			return;
-		}
-	}
+	const bool is_resolved = (p_record->state == ARP_STATE_PENDING);
 
-	memcpy(s_arp_records[s_entry_current].mac_address, mac_address, ETH_ADDR_LEN);
-	s_arp_records[s_entry_current].ip = ip;
+	memcpy(p_record->mac_address, mac_address, ETH_ADDR_LEN);
+	p_record->millis = millis();
+	p_record->retries = 0;
+	p_record->state = ARP_STATE_VALID;
 
-	s_entry_current++;
+	if (is_resolved) {
+		udp_arp_resolved(ip);
+	}
 
 	DEBUG2_EXIT
 }
 
+/*
+ * Non-blocking. On a miss a request is sent and 0 is returned, the timer sends the retries.
+ */
 uint32_t arp_cache_lookup(uint32_t ip, uint8_t *mac_address) {
 	DEBUG2_ENTRY
-	DEBUG_PRINTF(IPSTR " " MACSTR, IP2STR(ip), MAC2STR(mac_address));
+	DEBUG_PRINTF(IPSTR, IP2STR(ip));
 
-	uint16_t i;
+	const uint32_t i = _find(ip);
 
-	for (i = 0; i < MAX_RECORDS; i++) {
-		if (s_arp_records[i].ip == ip) {
-			memcpy(mac_address, s_arp_records[i].mac_address, ETH_ADDR_LEN);
-			return ip;
+	if (__builtin_expect((i != ARP_MAX_RECORDS), 1)) {
+		if (s_arp_records[i].state == ARP_STATE_PENDING) {
+			DEBUG2_EXIT
+			return 0;
 		}
 
-		if (s_arp_records[i].ip == 0) {
-			break;
-		}
+		memcpy(mac_address, s_arp_records[i].mac_address, ETH_ADDR_LEN);
+		DEBUG2_EXIT
+		return ip;
 	}
 
-	uint16_t current_entry = s_entry_current;
+	struct t_arp_record *p_record = _insert(ip);
+
+	if (p_record != NULL) {
+		p_record->millis = millis();
+		p_record->retries = 0;
+		p_record->state = ARP_STATE_PENDING;
+		arp_send_request(ip);
+	}
+
+	DEBUG2_EXIT
+	return 0;
+}
+
+/*
+ * Blocking, for the RFC 3927 address probing only.
+ * Returns ip when a host answered within the retries, otherwise 0.
+ */
+uint32_t arp_cache_probe(uint32_t ip, uint8_t *mac_address) {
+	DEBUG2_ENTRY
+
 	int32_t timeout;
-	int8_t retries = 3;
+	int8_t retries = ARP_RETRIES;
+
+	if (arp_cache_lookup(ip, mac_address) == ip) {
+		DEBUG2_EXIT
+		return ip;
+	}
 
 	while (retries--) {
 		arp_send_request(ip);
 
 		timeout = 0x1FFFF;
 
-		while ((timeout-- > 0) && (current_entry == s_entry_current)) {
+		while (timeout-- > 0) {
 			net_handle();
-		}
 
-		if (current_entry != s_entry_current) {
-			memcpy(mac_address, s_arp_records[current_entry].mac_address, ETH_ADDR_LEN);
-			DEBUG_PRINTF("timeout=%x", timeout);
-			return ip;
-		}
+			const uint32_t i = _find(ip);
 
-		DEBUG_PRINTF("i=%d, timeout=%d, current_entry=%d, s_entry_current=%d", i, timeout, current_entry, s_entry_current);
+			if ((i != ARP_MAX_RECORDS) && (s_arp_records[i].state != ARP_STATE_PENDING)) {
+				memcpy(mac_address, s_arp_records[i].mac_address, ETH_ADDR_LEN);
+				DEBUG2_EXIT
+				return ip;
+			}
+		}
 	}
 
 	DEBUG2_EXIT
@@ -141,24 +261,71 @@ uint32_t arp_cache_lookup(uint32_t ip, uint8_t *mac_address) {
 
 void arp_cache_dump(void) {
 #ifndef NDEBUG
-	uint16_t i;
+	uint32_t i;
 
 	printf("ARP Cache size=%d\n", s_entry_current);
 
-	for (i = 0; i < s_entry_current; i++) {
-		printf("%02d " IPSTR " " MACSTR "\n", i, IP2STR(s_arp_records[i].ip),MAC2STR(s_arp_records[i].mac_address));
+	for (i = 0; i < ARP_MAX_RECORDS; i++) {
+		if (s_arp_records[i].state != ARP_STATE_FREE) {
+			printf("%02d " IPSTR " " MACSTR " %d\n", i, IP2STR(s_arp_records[i].ip), MAC2STR(s_arp_records[i].mac_address), s_arp_records[i].state);
+		}
 	}
 #endif
 }
 
-#ifndef NDEBUG
+/*
+ * Called every 100 ms from net_timers_run.
+ * Pending and stale entries get a request per tick, after ARP_RETRIES they are removed.
+ * A valid entry becomes stale when its TTL has expired.
+ */
 void arp_cache_timer(void) {
+	const uint32_t millis_now = millis();
+	uint32_t i = 0;
+
+	while (i < ARP_MAX_RECORDS) {
+		struct t_arp_record *p_record = &s_arp_records[i];
+
+		switch (p_record->state) {
+		case ARP_STATE_VALID:
+			if ((millis_now - p_record->millis) >= ARP_TTL_MILLIS) {
+				p_record->state = ARP_STATE_STALE;
+				p_record->retries = 0;
+				arp_send_request(p_record->ip);
+			}
+			break;
+		case ARP_STATE_PENDING:
+		case ARP_STATE_STALE:
+			if (p_record->retries == ARP_RETRIES) {
+				const uint32_t ip = p_record->ip;
+				const bool is_pending = (p_record->state == ARP_STATE_PENDING);
+
+				DEBUG_PRINTF("Remove " IPSTR, IP2STR(ip));
+
+				_delete(i);
+
+				if (is_pending) {
+					udp_arp_failed(ip);
+				}
+
+				continue;	// A record can be moved into i
+			} else {
+				p_record->retries++;
+				arp_send_request(p_record->ip);
+			}
+			break;
+		default:
+			break;
+		}
+
+		i++;
+	}
+
+#ifndef NDEBUG
 	s_ticker--;
 
 	if (s_ticker == 0) {
 		s_ticker = TICKER_COUNT;
 		arp_cache_dump();
 	}
-}
 #endif
-
+}
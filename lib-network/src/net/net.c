@@ -31,11 +31,18 @@
 #include "net_packets.h"
 #include "net_debug.h"
 
+#include "c/micros.h"
+
+#include "../../config/net_config.h"
+
 extern int emac_eth_recv(uint8_t **);
+extern uint32_t emac_eth_recv_backlog(void);
 extern void emac_free_pkt(void);
 
 extern void net_timers_run(void);
 
+extern void udp_rx_evict(void);
+
 extern void arp_init(const uint8_t *, const struct ip_info  *);
 extern void arp_handle(struct t_arp *);
 
@@ -57,6 +64,7 @@ uint8_t g_mac_address[ETH_ADDR_LEN] __attribute__ ((aligned (4)));
 
 static uint8_t *s_p;
 static bool s_is_dhcp = false;
+static struct net_rx_stats s_rx_stats;
 
 void __attribute__((cold)) net_init(const uint8_t *mac_address, struct ip_info *p_ip_info, const char *hostname, bool *use_dhcp, bool *is_zeroconf_used) {
 	uint32_t i;
@@ -174,10 +182,31 @@ bool net_set_zeroconf(struct ip_info *p_ip_info) {
 	return false;
 }
 
+const struct net_rx_stats *net_get_rx_stats(void) {
+	return &s_rx_stats;
+}
+
+/*
+ * Up to NET_RX_BATCH_MAX frames are handled per call,
+ * as long as the time spent is within NET_RX_BATCH_BUDGET_US.
+ */
 __attribute__((hot)) void net_handle(void) {
-	const int length = emac_eth_recv(&s_p);
+	uint32_t frames = 0;
+	uint32_t micros_start = 0;
+
+	udp_rx_evict();
+
+	while (emac_eth_recv(&s_p) > 0) {
+		if (frames == 0) {
+			micros_start = micros();
+
+			const uint32_t backlog = emac_eth_recv_backlog();
+
+			if (backlog > s_rx_stats.backlog_max) {
+				s_rx_stats.backlog_max = backlog;
+			}
+		}
 
-	if (__builtin_expect((length > 0), 0)) {
 		const struct ether_header *eth = (struct ether_header *) s_p;
 
 		if (eth->type == __builtin_bswap16(ETHER_TYPE_IPv4)) {
@@ -189,6 +218,19 @@ __attribute__((hot)) void net_handle(void) {
 		}
 
 		emac_free_pkt();
+
+		if ((++frames == NET_RX_BATCH_MAX) || ((micros() - micros_start) >= NET_RX_BATCH_BUDGET_US)) {
+			break;
+		}
+	}
+
+	if (frames != 0) {
+		s_rx_stats.calls++;
+		s_rx_stats.frames += frames;
+
+		if (frames > s_rx_stats.frames_per_call_max) {
+			s_rx_stats.frames_per_call_max = frames;
+		}
 	}
 
 	net_timers_run();
@@ -41,6 +41,13 @@ struct ip_info {
     struct ip_addr gw;
 };
 
+struct net_rx_stats {
+	uint32_t calls;					///< net_handle() calls that handled at least one frame
+	uint32_t frames;				///< Frames handled in total
+	uint32_t frames_per_call_max;
+	uint32_t backlog_max;			///< Maximum number of ready EMAC RX descriptors
+};
+
 #define IP_BROADCAST	((uint32_t) 0xFFFFFFFF)
 #define HOST_NAME_MAX 	64	/* including a terminating null byte. */
 
@@ -51,6 +58,7 @@ extern "C" {
 extern void net_init(const uint8_t *mac_address, struct ip_info *p_ip_info, const char *hostname, bool *use_dhcp, bool *is_zeroconf_used);
 extern void net_shutdown(void);
 extern void net_handle(void);
+extern const struct net_rx_stats *net_get_rx_stats(void);
 
 extern void net_set_ip(uint32_t ip);
 extern void net_set_gw(uint32_t gw);
@@ -63,7 +71,12 @@ extern int udp_bind(uint16_t);
 extern int udp_unbind(uint16_t);
 extern uint16_t udp_recv(uint8_t, uint8_t *, uint16_t, uint32_t *, uint16_t *);
 extern uint16_t udp_recv2(uint8_t, const uint8_t **, uint32_t *, uint16_t *);
+extern void udp_recv2_release(uint8_t);
+extern uint32_t udp_recv_pending(uint8_t);
+extern uint32_t udp_get_rx_overflow(uint8_t);
 extern int udp_send(uint8_t, const uint8_t *, uint16_t, uint32_t, uint16_t);
+extern uint8_t *udp_send_begin(uint8_t, uint32_t, uint16_t);
+extern void udp_send_commit(uint16_t);
 
 extern int igmp_join(uint32_t group_address);
 extern int igmp_leave(uint32_t group_address);
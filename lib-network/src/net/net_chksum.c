@@ -2,7 +2,7 @@
  * @file net_chksum.c
  *
  */
-/* Copyright (C) 2018-2021 by Arjan van Vught mailto:info@orangepi-dmx.nl
+/* Copyright (C) 2018-2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,12 +25,35 @@
 
 #include <stdint.h>
 
-uint16_t net_chksum(void *data, uint32_t len) {
-	uint32_t sum;
-	uint16_t *ptr;
+/*
+ * The bare-metal Raspberry Pi builds use -nostdinc, arm_neon.h is not available there.
+ */
+#if defined (__ARM_NEON) && !defined (RPI2)
+# define NET_CHKSUM_NEON
+# include <arm_neon.h>
+#elif defined (__SSE2__)
+# include <emmintrin.h>
+#endif
+
+/*
+ * The one's complement sum does not depend on the word size of the additions,
+ * as long as the carries are folded back in. The 32-bit words (and the SIMD lanes)
+ * are summed into a 64-bit accumulator, which is folded into 16 bits at the end.
+ */
+static inline uint32_t _fold(uint64_t sum) {
+	sum = (sum >> 32) + (sum & 0xFFFFFFFF);
+	sum = (sum >> 32) + (sum & 0xFFFFFFFF);
+
+	uint32_t sum32 = (uint32_t) sum;
 
-	ptr = (uint16_t *) data;
-	sum = 0;
+	sum32 = (sum32 >> 16) + (sum32 & 0xFFFF);
+	sum32 = (sum32 >> 16) + (sum32 & 0xFFFF);
+
+	return sum32;
+}
+
+static uint16_t _net_chksum_u16(const uint16_t *ptr, uint32_t len) {
+	uint32_t sum = 0;
 
 	while (len > 1) {
 		sum += *ptr;
@@ -50,3 +73,92 @@ uint16_t net_chksum(void *data, uint32_t len) {
 
 	return (uint16_t) (~sum);
 }
+
+uint16_t net_chksum(void *data, uint32_t len) {
+	const uint8_t *ptr = (const uint8_t *) data;
+
+	if (__builtin_expect((((uintptr_t) ptr & 0x1) != 0), 0)) {
+		return _net_chksum_u16((const uint16_t *) ptr, len);
+	}
+
+	uint64_t sum = 0;
+
+	if ((((uintptr_t) ptr & 0x2) != 0) && (len > 1)) {
+		sum += *(const uint16_t *) ptr;
+		ptr += 2;
+		len -= 2;
+	}
+
+#if defined (NET_CHKSUM_NEON)
+	if (len >= 32) {
+		uint32x4_t acc = vdupq_n_u32(0);
+
+		do {
+			acc = vpadalq_u16(acc, vld1q_u16((const uint16_t *) ptr));
+			ptr += 16;
+			len -= 16;
+		} while (len >= 16);
+
+		const uint64x2_t acc64 = vpaddlq_u32(acc);
+		sum += vgetq_lane_u64(acc64, 0) + vgetq_lane_u64(acc64, 1);
+	}
+#elif defined (__SSE2__)
+	if (len >= 32) {
+		const __m128i zero = _mm_setzero_si128();
+		__m128i acc = zero;
+
+		do {
+			const __m128i v = _mm_loadu_si128((const __m128i *) ptr);
+			acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+			acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+			ptr += 16;
+			len -= 16;
+		} while (len >= 16);
+
+		uint32_t lanes[4] __attribute__ ((aligned (16)));
+		_mm_store_si128((__m128i *) lanes, acc);
+		sum += (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+#endif
+
+	const uint32_t *ptr32 = (const uint32_t *) ptr;
+
+	while (len >= 16) {
+		sum += (uint64_t) ptr32[0] + ptr32[1] + ptr32[2] + ptr32[3];
+		ptr32 += 4;
+		len -= 16;
+	}
+
+	while (len >= 4) {
+		sum += *ptr32++;
+		len -= 4;
+	}
+
+	ptr = (const uint8_t *) ptr32;
+
+	if (len > 1) {
+		sum += *(const uint16_t *) ptr;
+		ptr += 2;
+		len -= 2;
+	}
+
+	/* Add left-over byte, if any */
+	if (len > 0) {
+		sum += __builtin_bswap16((uint16_t)(*ptr << 8));
+	}
+
+	return (uint16_t) (~_fold(sum));
+}
+
+/*
+ * Incremental update, RFC 1624 eqn. 3: HC' = ~(~HC + ~m + m')
+ * The 16-bit field changes from old_value to new_value, both as they are in the header.
+ */
+uint16_t net_chksum_update(uint16_t chksum, uint16_t old_value, uint16_t new_value) {
+	uint32_t sum = (uint32_t) (uint16_t) ~chksum + (uint16_t) ~old_value + new_value;
+
+	sum = (sum >> 16) + (sum & 0xFFFF);
+	sum = (sum >> 16) + (sum & 0xFFFF);
+
+	return (uint16_t) (~sum);
+}
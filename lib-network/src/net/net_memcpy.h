@@ -30,7 +30,7 @@ void* net_memcpy(void *__restrict__ dest, void const *__restrict__ src, size_t n
 	uint32_t *plDst = (uint32_t*) dest;
 	uint32_t const *plSrc = (uint32_t const*) src;
 
-	if ((((uint32_t) src & 0x3) == 0) && (((uint32_t) dest & 0x3) == 0)) {
+	if ((((uintptr_t) src & 0x3) == 0) && (((uintptr_t) dest & 0x3) == 0)) {
 		while (n >= 4) {
 			*plDst++ = *plSrc++;
 			n -= 4;
@@ -28,9 +28,7 @@
 #include "c/millis.h"
 
 extern void igmp_timer(void);
-#ifndef NDEBUG
- extern void arp_cache_timer(void);
-#endif
+extern void arp_cache_timer(void);
 
 static volatile uint32_t s_ticker;
 
@@ -42,8 +40,6 @@ void net_timers_run(void) {
 	if (__builtin_expect((millis_now >= s_ticker), 0)) {
 		s_ticker = millis_now + INTERVAL_MS;
 		igmp_timer();
-#ifndef NDEBUG
 		arp_cache_timer();
-#endif
 	}
 }
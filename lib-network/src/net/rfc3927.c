@@ -33,7 +33,7 @@
 
 #include "c/millis.h"
 
-extern uint32_t arp_cache_lookup(uint32_t, uint8_t *);
+extern uint32_t arp_cache_probe(uint32_t, uint8_t *);
 
 /*
  * https://tools.ietf.org/html/rfc3927
@@ -70,7 +70,7 @@ bool rfc3927(struct ip_info *p_ip_info) {
 	do  {
 		DEBUG_PRINTF(IPSTR, IP2STR(ip));
 
-		if (0 == arp_cache_lookup(ip, s_mac_address_arp_reply)) {
+		if (0 == arp_cache_probe(ip, s_mac_address_arp_reply)) {
 			p_ip_info->ip.addr = ip;
 			p_ip_info->gw.addr = ip;
 			p_ip_info->netmask.addr = 0x0000FFFF;
@@ -51,24 +51,51 @@ extern int console_error(const char *);
 # define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
-extern void emac_eth_send(void *, int);
+extern uint8_t *emac_eth_send_get_dma_buffer(void);
+extern void emac_eth_send_dma(int);
+extern uint32_t emac_hold_pkt(void);
+extern void emac_release_pkt(uint32_t);
+extern uint32_t emac_eth_recv_backlog(void);
+extern uint32_t emac_rx_dma_distance(uint32_t);
 extern uint32_t arp_cache_lookup(uint32_t, uint8_t *);
 extern uint16_t net_chksum(void *, uint32_t);
+extern uint16_t net_chksum_update(uint16_t, uint16_t, uint16_t);
 
-#define UDP_RX_MAX_ENTRIES		(1U << 1) // Must always be a power of 2
 #define UDP_RX_MAX_ENTRIES_MASK	(UDP_RX_MAX_ENTRIES - 1)
 
+/*
+ * The queue entries refer to the EMAC RX descriptor holding the datagram.
+ * The descriptor is given back to the EMAC when the entry is released.
+ *
+ * The RX ring is consumed in order, a held descriptor stops the ring when the DMA wraps around to it.
+ * Therefore a port holds at most UDP_RX_MAX_HELD_PORT descriptors, the other datagrams are copied.
+ * A held descriptor that the DMA is about to reach is copied out (udp_rx_evict), or dropped
+ * when there is no copy buffer. A slow reader loses datagrams, it never stalls the ring.
+ * This includes the entry handed out by udp_recv2, a port that is not polled does not keep its view.
+ */
+enum entry_state {
+	ENTRY_HELD, ENTRY_COPIED, ENTRY_DROPPED
+};
+
 struct queue_entry {
-	uint8_t data[UDP_DATA_SIZE];
+	const uint8_t *data;
+	uint32_t desc_num;		// ENTRY_HELD
 	uint32_t from_ip;
 	uint16_t from_port;
 	uint16_t size;
+	uint8_t copy;			// ENTRY_COPIED, index into copies
+	uint8_t state;
 }ALIGNED;
 
 struct queue {
-	uint16_t queue_head;
-	uint16_t queue_tail;
+	uint32_t queue_head;	// Free running
+	uint32_t queue_tail;	// Free running
+	uint32_t overflow;
+	uint32_t held;
+	uint32_t copy_used;		// Bit mask
+	bool is_view;			// Entry at queue_tail is handed out by udp_recv2
 	struct queue_entry entries[UDP_RX_MAX_ENTRIES] ALIGNED;
+	uint8_t copies[UDP_RX_MAX_COPY][UDP_DATA_SIZE] ALIGNED;
 }ALIGNED;
 
 typedef union pcast32 {
@@ -78,12 +105,44 @@ typedef union pcast32 {
 
 static uint32_t s_ports_allowed[UDP_MAX_PORTS_ALLOWED] SECTION_NETWORK ALIGNED;
 static struct queue s_recv_queue[UDP_MAX_PORTS_ALLOWED] SECTION_NETWORK ALIGNED;
-static struct t_udp s_send_packet SECTION_NETWORK ALIGNED;
+static struct t_udp s_send_packet SECTION_NETWORK ALIGNED;	// Only the headers are used, they are the template for all datagrams sent
 static uint16_t s_id SECTION_NETWORK ALIGNED;
+static uint32_t s_rx_held SECTION_NETWORK;
+static uint32_t s_port_index_last SECTION_NETWORK;
 static uint32_t broadcast_mask SECTION_NETWORK;
 static uint32_t on_network_mask SECTION_NETWORK;
 static uint32_t gw_ip SECTION_NETWORK;
 static uint8_t s_multicast_mac[ETH_ADDR_LEN] = {0x01, 0x00, 0x5E}; // Fixed part
+static uint32_t s_chksum_dst SECTION_NETWORK;	// Destination of the template for which s_chksum is valid
+static uint16_t s_chksum SECTION_NETWORK;
+
+/*
+ * Datagrams for a unicast destination that is not resolved yet.
+ * They are sent when the ARP reply comes in, or dropped when the ARP request times out.
+ */
+struct pending {
+	uint32_t to_ip;
+	uint32_t next_hop;
+	uint16_t remote_port;
+	uint16_t size;
+	uint8_t idx;
+	bool in_use;
+	uint8_t data[UDP_DATA_SIZE] ALIGNED;
+};
+
+static struct pending s_pending[ARP_PENDING_MAX] SECTION_NETWORK ALIGNED;
+static struct pending *s_p_pending_commit SECTION_NETWORK;	// Set by udp_send_begin when the datagram is queued
+
+/*
+ * The IPv4 header checksum of the template, with the len and id fields zero.
+ * Per datagram only these two fields change, they are added incrementally (RFC 1624).
+ */
+static void _udp_template_chksum(void) {
+	s_send_packet.ip4.len = 0;
+	s_send_packet.ip4.id = 0;
+	s_send_packet.ip4.chksum = 0;
+	s_chksum = net_chksum((void *) &s_send_packet.ip4, (uint32_t) sizeof(s_send_packet.ip4));
+}
 
 void udp_set_ip(const struct ip_info *p_ip_info) {
 	_pcast32 src;
@@ -93,6 +152,8 @@ void udp_set_ip(const struct ip_info *p_ip_info) {
 	broadcast_mask = ~(p_ip_info->netmask.addr);
 	on_network_mask = p_ip_info->ip.addr & p_ip_info->netmask.addr;
 	gw_ip = p_ip_info->gw.addr;
+
+	_udp_template_chksum();
 }
 
 void __attribute__((cold)) udp_init(const uint8_t *mac_address, const struct ip_info  *p_ip_info) {
@@ -102,9 +163,21 @@ void __attribute__((cold)) udp_init(const uint8_t *mac_address, const struct ip_
 		s_ports_allowed[i] = 0;
 		s_recv_queue[i].queue_head = 0;
 		s_recv_queue[i].queue_tail = 0;
+		s_recv_queue[i].overflow = 0;
+		s_recv_queue[i].held = 0;
+		s_recv_queue[i].copy_used = 0;
+		s_recv_queue[i].is_view = false;
 	}
 
+	for (i = 0; i < ARP_PENDING_MAX; i++) {
+		s_pending[i].in_use = false;
+	}
+
+	s_p_pending_commit = NULL;
+
 	s_id = 0;
+	s_rx_held = 0;
+	s_port_index_last = 0;
 
 	// Ethernet
 	memcpy(s_send_packet.ether.src, mac_address, ETH_ADDR_LEN);
@@ -126,10 +199,118 @@ void __attribute__((cold)) udp_shutdown(void) {
 	DEBUG_EXIT
 }
 
+static void _entry_release_held(struct queue *p_queue, const struct queue_entry *p_queue_entry) {
+	emac_release_pkt(p_queue_entry->desc_num);
+
+	assert(p_queue->held != 0);
+	p_queue->held--;
+	assert(s_rx_held != 0);
+	s_rx_held--;
+}
+
+/*
+ * Copies the datagram into a free copy buffer of the queue.
+ */
+static bool _entry_copy(struct queue *p_queue, struct queue_entry *p_queue_entry, const uint8_t *data) {
+	const uint32_t copy_free = ~p_queue->copy_used & ((1ULL << UDP_RX_MAX_COPY) - 1);
+
+	if (copy_free == 0) {
+		return false;
+	}
+
+	const uint32_t copy = (uint32_t) __builtin_ctz(copy_free);
+
+	memcpy(p_queue->copies[copy], data, p_queue_entry->size);
+
+	p_queue->copy_used |= (1U << copy);
+	p_queue_entry->data = p_queue->copies[copy];
+	p_queue_entry->copy = (uint8_t) copy;
+	p_queue_entry->state = ENTRY_COPIED;
+
+	return true;
+}
+
+static void _queue_release(struct queue *p_queue) {
+	assert(p_queue->queue_head != p_queue->queue_tail);
+
+	const struct queue_entry *p_queue_entry = &p_queue->entries[p_queue->queue_tail & UDP_RX_MAX_ENTRIES_MASK];
+
+	if (p_queue_entry->state == ENTRY_HELD) {
+		_entry_release_held(p_queue, p_queue_entry);
+	} else if (p_queue_entry->state == ENTRY_COPIED) {
+		p_queue->copy_used &= ~(1U << p_queue_entry->copy);
+	}
+
+	p_queue->queue_tail++;
+	p_queue->is_view = false;
+}
+
+/*
+ * The oldest entry that is not dropped, NULL when the queue is empty.
+ */
+static struct queue_entry *_queue_front(struct queue *p_queue) {
+	while (p_queue->queue_head != p_queue->queue_tail) {
+		struct queue_entry *p_queue_entry = &p_queue->entries[p_queue->queue_tail & UDP_RX_MAX_ENTRIES_MASK];
+
+		if (__builtin_expect((p_queue_entry->state != ENTRY_DROPPED), 1)) {
+			return p_queue_entry;
+		}
+
+		_queue_release(p_queue);
+	}
+
+	return NULL;
+}
+
+/*
+ * Called before new frames are handled.
+ * The entry handed out by udp_recv2 is read already, its descriptor is given back without a copy.
+ */
+void udp_rx_evict(void) {
+	if (__builtin_expect((s_rx_held == 0), 1)) {
+		return;
+	}
+
+	uint32_t i;
+
+	for (i = 0; i < UDP_MAX_PORTS_ALLOWED; i++) {
+		struct queue *p_queue = &s_recv_queue[i];
+
+		if (p_queue->held == 0) {
+			continue;
+		}
+
+		uint32_t n;
+
+		for (n = p_queue->queue_tail; n != p_queue->queue_head; n++) {
+			struct queue_entry *p_queue_entry = &p_queue->entries[n & UDP_RX_MAX_ENTRIES_MASK];
+
+			if ((p_queue_entry->state != ENTRY_HELD) || (emac_rx_dma_distance(p_queue_entry->desc_num) > UDP_RX_EVICT_DISTANCE)) {
+				continue;
+			}
+
+			if ((n == p_queue->queue_tail) && p_queue->is_view) {
+				_entry_release_held(p_queue, p_queue_entry);
+				p_queue_entry->state = ENTRY_DROPPED;
+				continue;
+			}
+
+			const struct queue_entry held = *p_queue_entry;
+
+			if (!_entry_copy(p_queue, p_queue_entry, held.data)) {
+				p_queue_entry->state = ENTRY_DROPPED;
+				p_queue->overflow++;
+				DEBUG_PRINTF("port_index=%u, dropped, overflow=%u", i, p_queue->overflow);
+			}
+
+			_entry_release_held(p_queue, &held);
+		}
+	}
+}
+
 __attribute__((hot)) void udp_handle(struct t_udp *p_udp) {
 	uint32_t port_index;
 	_pcast32 src;
-	uint16_t i;
 
 	const uint16_t dest_port = __builtin_bswap16(p_udp->udp.destination_port);
 
@@ -141,9 +322,15 @@ __attribute__((hot)) void udp_handle(struct t_udp *p_udp) {
 		return;
 	}
 
-	for (port_index = 0; port_index < UDP_MAX_PORTS_ALLOWED; port_index++) {
-		if (s_ports_allowed[port_index] == dest_port) {
-			break;
+	/* Bursts of datagrams are mostly for the same port (Art-Net, sACN) */
+	port_index = s_port_index_last;
+
+	if (__builtin_expect((s_ports_allowed[port_index] != dest_port), 0)) {
+		for (port_index = 0; port_index < UDP_MAX_PORTS_ALLOWED; port_index++) {
+			if (s_ports_allowed[port_index] == dest_port) {
+				s_port_index_last = port_index;
+				break;
+			}
 		}
 	}
 
@@ -152,23 +339,41 @@ __attribute__((hot)) void udp_handle(struct t_udp *p_udp) {
 		return;
 	}
 
-	const uint32_t entry = s_recv_queue[port_index].queue_head;
-	struct queue_entry *p_queue_entry = &s_recv_queue[port_index].entries[entry];
+	struct queue *p_queue = &s_recv_queue[port_index];
 
-	const uint16_t data_length = (uint16_t)(__builtin_bswap16(p_udp->udp.len) - UDP_HEADER_SIZE);
+	/* The new datagram is dropped, the unread entries are never overwritten */
+	if (__builtin_expect(((p_queue->queue_head - p_queue->queue_tail) == UDP_RX_MAX_ENTRIES), 0)) {
+		p_queue->overflow++;
+		DEBUG_PRINTF("port_index=%u, overflow=%u", port_index, p_queue->overflow);
+		return;
+	}
+
+	struct queue_entry *p_queue_entry = &p_queue->entries[p_queue->queue_head & UDP_RX_MAX_ENTRIES_MASK];
 
-	i = MIN(UDP_DATA_SIZE, data_length);
+	const uint16_t data_length = (uint16_t)(__builtin_bswap16(p_udp->udp.len) - UDP_HEADER_SIZE);
 
-	memcpy(p_queue_entry->data, p_udp->udp.data, i);
+	p_queue_entry->size = MIN(UDP_DATA_SIZE, data_length);
+
+	/* Copy when the port holds its share, or when the ring is nearly full */
+	if ((p_queue->held < UDP_RX_MAX_HELD_PORT) && ((s_rx_held + emac_eth_recv_backlog()) < UDP_RX_MAX_HELD)) {
+		p_queue_entry->data = p_udp->udp.data;
+		p_queue_entry->desc_num = emac_hold_pkt();
+		p_queue_entry->state = ENTRY_HELD;
+		p_queue->held++;
+		s_rx_held++;
+	} else if (!_entry_copy(p_queue, p_queue_entry, p_udp->udp.data)) {
+		p_queue->overflow++;
+		DEBUG_PRINTF("port_index=%u, overflow=%u", port_index, p_queue->overflow);
+		return;
+	}
 
 	memcpy(src.u8, p_udp->ip4.src, IPv4_ADDR_LEN);
 	p_queue_entry->from_ip = src.u32;
 	p_queue_entry->from_port = __builtin_bswap16(p_udp->udp.source_port);
-	p_queue_entry->size = i;
 
-	s_recv_queue[port_index].queue_head = (s_recv_queue[port_index].queue_head + 1U) & UDP_RX_MAX_ENTRIES_MASK;
+	p_queue->queue_head++;
 
-	DEBUG_PRINTF("port_index=%u, i=%u, queue_head=%u", port_index, i, s_recv_queue[port_index].queue_head);
+	DEBUG_PRINTF("port_index=%u, size=%u, queue_head=%u", port_index, p_queue_entry->size, p_queue->queue_head);
 }
 
 // -->
@@ -205,8 +410,14 @@ int udp_unbind(uint16_t local_port) {
 	for (uint32_t i = 0; i < UDP_MAX_PORTS_ALLOWED; i++) {
 		if (s_ports_allowed[i] == local_port) {
 			s_ports_allowed[i] = 0;
+
+			while (s_recv_queue[i].queue_head != s_recv_queue[i].queue_tail) {
+				_queue_release(&s_recv_queue[i]);
+			}
+
 			s_recv_queue[i].queue_head = 0;
 			s_recv_queue[i].queue_tail = 0;
+			s_recv_queue[i].overflow = 0;
 			return 0;
 		}
 	}
@@ -218,12 +429,17 @@ int udp_unbind(uint16_t local_port) {
 uint16_t udp_recv(uint8_t idx, uint8_t *packet, uint16_t size, uint32_t *from_ip, uint16_t *from_port) {
 	assert(idx < UDP_MAX_PORTS_ALLOWED);
 
-	if (s_recv_queue[idx].queue_head == s_recv_queue[idx].queue_tail) {
-		return 0;
+	struct queue *p_queue = &s_recv_queue[idx];
+
+	if (p_queue->is_view) {
+		_queue_release(p_queue);
 	}
 
-	const uint32_t entry = s_recv_queue[idx].queue_tail;
-	struct queue_entry *p_queue_entry = &s_recv_queue[idx].entries[entry];
+	const struct queue_entry *p_queue_entry = _queue_front(p_queue);
+
+	if (p_queue_entry == NULL) {
+		return 0;
+	}
 
 	const uint32_t i = MIN(size, p_queue_entry->size);
 
@@ -232,31 +448,78 @@ uint16_t udp_recv(uint8_t idx, uint8_t *packet, uint16_t size, uint32_t *from_ip
 	*from_ip = p_queue_entry->from_ip;
 	*from_port = p_queue_entry->from_port;
 
-	s_recv_queue[idx].queue_tail = (s_recv_queue[idx].queue_tail + 1U) & UDP_RX_MAX_ENTRIES_MASK;
+	_queue_release(p_queue);
 
 	return (uint16_t) i;
 }
 
+/*
+ * Zero-copy receive. The returned data is a view into the EMAC RX descriptor,
+ * or into a copy buffer when the descriptor is close to the RX DMA.
+ * It is valid until udp_recv2_release, the next udp_recv/udp_recv2 for the same idx, or the next net_handle.
+ */
 uint16_t udp_recv2(uint8_t idx, const uint8_t **packet, uint32_t *from_ip, uint16_t *from_port) {
 	assert(idx < UDP_MAX_PORTS_ALLOWED);
 
-	if (s_recv_queue[idx].queue_head == s_recv_queue[idx].queue_tail) {
+	struct queue *p_queue = &s_recv_queue[idx];
+
+	if (p_queue->is_view) {
+		_queue_release(p_queue);
+	}
+
+	struct queue_entry *p_queue_entry = _queue_front(p_queue);
+
+	if (p_queue_entry == NULL) {
 		return 0;
 	}
 
-	const uint32_t entry = s_recv_queue[idx].queue_tail;
-	const struct queue_entry *p_queue_entry = &s_recv_queue[idx].entries[entry];
+	/* The DMA is about to reach the descriptor, holding it would stall the ring until the next net_handle */
+	if ((p_queue_entry->state == ENTRY_HELD) && (emac_rx_dma_distance(p_queue_entry->desc_num) <= UDP_RX_EVICT_DISTANCE)) {
+		const struct queue_entry held = *p_queue_entry;
+
+		if (_entry_copy(p_queue, p_queue_entry, held.data)) {
+			_entry_release_held(p_queue, &held);
+		}
+	}
 
 	*packet = p_queue_entry->data;
 	*from_ip = p_queue_entry->from_ip;
 	*from_port = p_queue_entry->from_port;
 
-	s_recv_queue[idx].queue_tail = (s_recv_queue[idx].queue_tail + 1U) & UDP_RX_MAX_ENTRIES_MASK;
+	p_queue->is_view = true;
 
 	return p_queue_entry->size;
 }
 
-int udp_send(uint8_t idx, const uint8_t *packet, uint16_t size, uint32_t to_ip, uint16_t remote_port) {
+void udp_recv2_release(uint8_t idx) {
+	assert(idx < UDP_MAX_PORTS_ALLOWED);
+
+	if (s_recv_queue[idx].is_view) {
+		_queue_release(&s_recv_queue[idx]);
+	}
+}
+
+/*
+ * The number of datagrams in the queue that are not handed out yet.
+ */
+uint32_t udp_recv_pending(uint8_t idx) {
+	assert(idx < UDP_MAX_PORTS_ALLOWED);
+
+	const struct queue *p_queue = &s_recv_queue[idx];
+
+	return (uint32_t) (p_queue->queue_head - p_queue->queue_tail) - (p_queue->is_view ? 1 : 0);
+}
+
+uint32_t udp_get_rx_overflow(uint8_t idx) {
+	assert(idx < UDP_MAX_PORTS_ALLOWED);
+
+	return s_recv_queue[idx].overflow;
+}
+
+/*
+ * Fills in the destination of the header template.
+ */
+static int _udp_set_destination(uint8_t idx, uint32_t to_ip, uint16_t remote_port) {
 	assert(idx < UDP_MAX_PORTS_ALLOWED);
 
 	_pcast32 dst;
@@ -293,41 +556,185 @@ int udp_send(uint8_t idx, const uint8_t *packet, uint16_t size, uint32_t to_ip,
 					dst.u32 = to_ip;
 					memcpy(s_send_packet.ip4.dst, dst.u8, IPv4_ADDR_LEN);
 				} else {
-					console_error("ARP lookup failed -> default gateway\n");
-					return -3;
+					return -3;	// The default gateway is not resolved yet
 				}
 			} else {
 				if (to_ip == arp_cache_lookup(to_ip, s_send_packet.ether.dst)) {
 					dst.u32 = to_ip;
 					memcpy(s_send_packet.ip4.dst, dst.u8, IPv4_ADDR_LEN);
 				} else {
-					console_error("ARP lookup failed\n");
-					return -2;
+					return -2;	// Not resolved yet
 				}
 			}
 		}
 	}
 
+	memcpy(dst.u8, s_send_packet.ip4.dst, IPv4_ADDR_LEN);
+
+	if (__builtin_expect((dst.u32 != s_chksum_dst), 0)) {
+		s_chksum_dst = dst.u32;
+		_udp_template_chksum();
+	}
+
+	//UDP
+	s_send_packet.udp.source_port = __builtin_bswap16((uint16_t) s_ports_allowed[idx]);
+	s_send_packet.udp.destination_port = __builtin_bswap16(remote_port);
+
+	return 0;
+}
+
+/*
+ * The lengths and checksum are filled in, the headers are copied in front of the
+ * payload in the TX descriptor and the frame is handed to the EMAC.
+ */
+static void _udp_send_dma(uint8_t *frame, uint16_t size) {
 	//IPv4
 	s_send_packet.ip4.id = s_id;
 	s_send_packet.ip4.len = __builtin_bswap16((uint16_t)(size + IPv4_UDP_HEADERS_SIZE));
-	s_send_packet.ip4.chksum = 0;
-	s_send_packet.ip4.chksum = net_chksum((void *) &s_send_packet.ip4, (uint32_t) sizeof(s_send_packet.ip4));
+#if !defined (CONFIG_EMAC_TX_CHECKSUM_OFFLOAD)
+	s_send_packet.ip4.chksum = net_chksum_update(net_chksum_update(s_chksum, 0, s_send_packet.ip4.len), 0, s_send_packet.ip4.id);
+#endif
 
 	//UDP
-	s_send_packet.udp.source_port = __builtin_bswap16((uint16_t) s_ports_allowed[idx]);
-	s_send_packet.udp.destination_port = __builtin_bswap16(remote_port);
 	s_send_packet.udp.len = __builtin_bswap16((uint16_t)(size + UDP_HEADER_SIZE));
 
-	net_memcpy(s_send_packet.udp.data, packet, MIN(UDP_DATA_SIZE, size));
+	net_memcpy(frame, &s_send_packet, UDP_PACKET_HEADERS_SIZE);
 
-//	debug_dump( &s_send_packet, size + UDP_PACKET_HEADERS_SIZE);
+//	debug_dump(frame, size + UDP_PACKET_HEADERS_SIZE);
 
-	emac_eth_send((void *) &s_send_packet, (int) (size + UDP_PACKET_HEADERS_SIZE));
+	emac_eth_send_dma((int) (size + UDP_PACKET_HEADERS_SIZE));
 
 	s_id++;
+}
+
+static inline bool _udp_is_unresolved(int result) {
+	return (result == -2) || (result == -3);
+}
+
+static struct pending *_udp_pending_get(uint8_t idx, uint32_t to_ip, uint16_t remote_port) {
+	uint32_t i;
+
+	for (i = 0; i < ARP_PENDING_MAX; i++) {
+		struct pending *p_pending = &s_pending[i];
+
+		if (!p_pending->in_use) {
+			p_pending->to_ip = to_ip;
+			p_pending->next_hop = (on_network_mask != (to_ip & on_network_mask)) ? gw_ip : to_ip;
+			p_pending->remote_port = remote_port;
+			p_pending->idx = idx;
+			return p_pending;
+		}
+	}
+
+	DEBUG_PUTS("No pending entry available");
+	return NULL;
+}
+
+/*
+ * Called by the ARP cache when ip is resolved.
+ */
+void udp_arp_resolved(uint32_t ip) {
+	uint32_t i;
+
+	for (i = 0; i < ARP_PENDING_MAX; i++) {
+		struct pending *p_pending = &s_pending[i];
+
+		if (p_pending->in_use && (p_pending->next_hop == ip)) {
+			p_pending->in_use = false;
+
+			if (_udp_set_destination(p_pending->idx, p_pending->to_ip, p_pending->remote_port) == 0) {
+				uint8_t *frame = emac_eth_send_get_dma_buffer();
+
+				net_memcpy(&frame[UDP_PACKET_HEADERS_SIZE], p_pending->data, p_pending->size);
+
+				_udp_send_dma(frame, p_pending->size);
+			}
+		}
+	}
+}
+
+/*
+ * Called by the ARP cache when the requests for ip are not answered.
+ */
+void udp_arp_failed(uint32_t ip) {
+	uint32_t i;
+
+	for (i = 0; i < ARP_PENDING_MAX; i++) {
+		if (s_pending[i].in_use && (s_pending[i].next_hop == ip)) {
+			s_pending[i].in_use = false;
+			console_error("ARP lookup failed\n");
+		}
+	}
+}
+
+int udp_send(uint8_t idx, const uint8_t *packet, uint16_t size, uint32_t to_ip, uint16_t remote_port) {
+	const int result = _udp_set_destination(idx, to_ip, remote_port);
+
+	size = MIN(UDP_DATA_SIZE, size);
+
+	if (__builtin_expect((result != 0), 0)) {
+		if (_udp_is_unresolved(result)) {
+			struct pending *p_pending = _udp_pending_get(idx, to_ip, remote_port);
+
+			if (p_pending != NULL) {
+				memcpy(p_pending->data, packet, size);
+				p_pending->size = size;
+				p_pending->in_use = true;
+				return 0;
+			}
+		}
+
+		return result;
+	}
+
+	/* The ARP lookup can send a request, the TX descriptor is taken after it */
+	uint8_t *frame = emac_eth_send_get_dma_buffer();
+
+	net_memcpy(&frame[UDP_PACKET_HEADERS_SIZE], packet, size);
+
+	_udp_send_dma(frame, size);
 
 	return 0;
 }
 
+/*
+ * Zero-copy send. The returned buffer is the payload area of the current EMAC TX descriptor.
+ * The payload is written in place and sent with udp_send_commit.
+ * Nothing else may be sent in between, so no other network calls.
+ * When the destination is not resolved yet, the buffer is a pending entry instead.
+ * Returns NULL when the destination cannot be resolved, or there is no pending entry.
+ */
+uint8_t *udp_send_begin(uint8_t idx, uint32_t to_ip, uint16_t remote_port) {
+	const int result = _udp_set_destination(idx, to_ip, remote_port);
+
+	if (__builtin_expect((result != 0), 0)) {
+		if (_udp_is_unresolved(result)) {
+			s_p_pending_commit = _udp_pending_get(idx, to_ip, remote_port);
+
+			if (s_p_pending_commit != NULL) {
+				return s_p_pending_commit->data;
+			}
+		}
+
+		return NULL;
+	}
+
+	s_p_pending_commit = NULL;
+
+	return &emac_eth_send_get_dma_buffer()[UDP_PACKET_HEADERS_SIZE];
+}
+
+void udp_send_commit(uint16_t size) {
+	assert(size <= UDP_DATA_SIZE);
+
+	if (__builtin_expect((s_p_pending_commit != NULL), 0)) {
+		s_p_pending_commit->size = size;
+		s_p_pending_commit->in_use = true;
+		s_p_pending_commit = NULL;
+		return;
+	}
+
+	_udp_send_dma(emac_eth_send_get_dma_buffer(), size);
+}
+
 // <---
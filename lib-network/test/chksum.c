@@ -0,0 +1,136 @@
+/**
+ * @file chksum.c
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Compares net_chksum and net_chksum_update with the 16-bit reference loop.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+uint16_t net_chksum(void *data, uint32_t len);
+uint16_t net_chksum_update(uint16_t chksum, uint16_t old_value, uint16_t new_value);
+
+static uint16_t reference(const void *data, uint32_t len) {
+	const uint16_t *ptr = (const uint16_t *) data;
+	uint32_t sum = 0;
+
+	while (len > 1) {
+		sum += *ptr++;
+		len -= 2;
+	}
+
+	if (len > 0) {
+		sum += __builtin_bswap16((uint16_t)(*((const uint8_t *) ptr) << 8));
+	}
+
+	while (sum >> 16) {
+		sum = (sum >> 16) + (sum & 0xFFFF);
+	}
+
+	return (uint16_t) (~sum);
+}
+
+static uint32_t s_errors;
+
+static void check(const char *pName, uint32_t offset, uint32_t len, uint16_t result, uint16_t expected) {
+	if (result != expected) {
+		if (s_errors < 10) {
+			printf("%s offset=%u len=%u: %04x, expected %04x\n", pName, offset, len, result, expected);
+		}
+		s_errors++;
+	}
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	static uint8_t buffer[65536 + 16] __attribute__ ((aligned (16)));
+
+	srand(1);
+
+	/* All alignments and the lengths around the SIMD and word boundaries */
+	for (uint32_t offset = 0; offset < 16; offset++) {
+		for (uint32_t len = 0; len < 256; len++) {
+			for (uint32_t i = 0; i < len; i++) {
+				buffer[offset + i] = (uint8_t) rand();
+			}
+			check("net_chksum", offset, len, net_chksum(&buffer[offset], len), reference(&buffer[offset], len));
+		}
+	}
+
+	/* All ones and all zeros, the carries and the folding */
+	for (uint32_t fill = 0; fill < 2; fill++) {
+		for (uint32_t i = 0; i < sizeof(buffer); i++) {
+			buffer[i] = fill == 0 ? 0xFF : 0x00;
+		}
+		for (uint32_t offset = 0; offset < 4; offset++) {
+			check("net_chksum", offset, 65535, net_chksum(&buffer[offset], 65535), reference(&buffer[offset], 65535));
+			check("net_chksum", offset, 1514, net_chksum(&buffer[offset], 1514), reference(&buffer[offset], 1514));
+		}
+	}
+
+	for (uint32_t n = 0; n < 100000; n++) {
+		const uint32_t offset = (uint32_t) rand() % 16;
+		const uint32_t len = (n % 100 == 0) ? (uint32_t) rand() % 65536 : (uint32_t) rand() % 1600;
+
+		for (uint32_t i = 0; i < len; i++) {
+			buffer[offset + i] = (uint8_t) rand();
+		}
+
+		check("net_chksum", offset, len, net_chksum(&buffer[offset], len), reference(&buffer[offset], len));
+	}
+
+	/* IPv4 header, the total length and the identification are set after the checksum */
+	for (uint32_t n = 0; n < 100000; n++) {
+		uint16_t header[10];
+
+		for (uint32_t i = 0; i < 10; i++) {
+			header[i] = (uint16_t) rand();
+		}
+
+		const uint16_t nLength = header[1];
+		const uint16_t nId = header[2];
+
+		header[1] = 0;
+		header[2] = 0;
+		header[5] = 0;
+
+		uint16_t chksum = net_chksum(header, sizeof(header));
+		chksum = net_chksum_update(chksum, 0, nLength);
+		chksum = net_chksum_update(chksum, 0, nId);
+
+		header[1] = nLength;
+		header[2] = nId;
+
+		check("net_chksum_update", 0, sizeof(header), chksum, reference(header, sizeof(header)));
+	}
+
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
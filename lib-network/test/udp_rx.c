@@ -0,0 +1,337 @@
+/**
+ * @file udp_rx.c
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Host simulation of the UDP receive queue (udp.c) on top of a model of the EMAC RX ring.
+ *
+ * The DMA fills the descriptors in order. A descriptor is CPU owned from the moment
+ * it is filled until it is handled, or until it is released when udp.c holds it.
+ * The DMA does not overwrite a CPU owned descriptor, it stalls, and the frames are lost on the wire.
+ * The scheme must never stall the ring, and a view handed out by udp_recv2 must stay intact
+ * until the next net_handle.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net.h"
+#include "net_packets.h"
+
+void udp_handle(struct t_udp *);
+void udp_rx_evict(void);
+void udp_init(const uint8_t *, const struct ip_info *);
+
+#define RX_DESCR_NUM	48
+#define BATCH_MAX		8
+#define PAYLOAD_SIZE	64
+
+enum owner {
+	OWNER_DMA, OWNER_FILLED, OWNER_HELD
+};
+
+static struct t_udp s_desc[RX_DESCR_NUM];
+static uint8_t s_owner[RX_DESCR_NUM];
+static uint32_t s_dma;
+static uint32_t s_cpu;
+static uint32_t s_current;
+static bool s_is_held;
+static uint32_t s_stalls;
+
+static uint32_t s_errors;
+
+static void check(const char *pName, uint32_t n, bool is_ok) {
+	if (!is_ok) {
+		if (s_errors < 10) {
+			printf("%s n=%u\n", pName, n);
+		}
+		s_errors++;
+	}
+}
+
+/*
+ * The EMAC driver interface used by udp.c
+ */
+
+uint32_t emac_hold_pkt(void) {
+	s_is_held = true;
+	return s_current;
+}
+
+void emac_release_pkt(uint32_t desc_num) {
+	check("release", desc_num, s_owner[desc_num] == OWNER_HELD);
+	s_owner[desc_num] = OWNER_DMA;
+}
+
+uint32_t emac_eth_recv_backlog(void) {
+	uint32_t backlog = 0;
+	uint32_t i = s_cpu;
+
+	while ((s_owner[i] == OWNER_FILLED) && (backlog < RX_DESCR_NUM)) {
+		backlog++;
+		i = (i + 1) % RX_DESCR_NUM;
+	}
+
+	return backlog;
+}
+
+uint32_t emac_rx_dma_distance(uint32_t desc_num) {
+	return (desc_num + RX_DESCR_NUM - s_dma) % RX_DESCR_NUM;
+}
+
+uint8_t *emac_eth_send_get_dma_buffer(void) {
+	static uint8_t buffer[2048];
+	return buffer;
+}
+
+void emac_eth_send_dma(int length) {
+	(void) length;
+}
+
+uint32_t arp_cache_lookup(uint32_t ip, uint8_t *mac_address) {
+	memset(mac_address, 0, ETH_ADDR_LEN);
+	return ip;
+}
+
+int console_error(const char *s) {
+	return fputs(s, stderr);
+}
+
+/*
+ * The model of the ring
+ */
+
+static void fill(uint8_t *data, uint32_t seq) {
+	memcpy(data, &seq, sizeof(uint32_t));
+
+	for (uint32_t i = sizeof(uint32_t); i < PAYLOAD_SIZE; i++) {
+		data[i] = (uint8_t) (seq * 7 + i);
+	}
+}
+
+static bool is_intact(const uint8_t *data, uint32_t seq) {
+	uint8_t expected[PAYLOAD_SIZE];
+
+	fill(expected, seq);
+
+	return memcmp(data, expected, PAYLOAD_SIZE) == 0;
+}
+
+static void arrive(uint16_t port, uint32_t seq) {
+	if (s_owner[s_dma] != OWNER_DMA) {
+		s_stalls++;
+		return;
+	}
+
+	struct t_udp *p_udp = &s_desc[s_dma];
+
+	p_udp->udp.source_port = __builtin_bswap16(port);
+	p_udp->udp.destination_port = __builtin_bswap16(port);
+	p_udp->udp.len = __builtin_bswap16(UDP_HEADER_SIZE + PAYLOAD_SIZE);
+	fill(p_udp->udp.data, seq);
+
+	s_owner[s_dma] = OWNER_FILLED;
+	s_dma = (s_dma + 1) % RX_DESCR_NUM;
+}
+
+void net_handle(void) {
+	udp_rx_evict();
+
+	for (uint32_t frames = 0; (frames < BATCH_MAX) && (s_owner[s_cpu] == OWNER_FILLED); frames++) {
+		s_current = s_cpu;
+		s_is_held = false;
+
+		udp_handle(&s_desc[s_cpu]);
+
+		s_owner[s_cpu] = s_is_held ? OWNER_HELD : OWNER_DMA;
+		s_cpu = (s_cpu + 1) % RX_DESCR_NUM;
+	}
+}
+
+static bool is_descriptor(const uint8_t *data) {
+	return (data >= (const uint8_t *) &s_desc[0]) && (data < (const uint8_t *) &s_desc[RX_DESCR_NUM]);
+}
+
+/*
+ * The tests
+ */
+
+struct view {
+	const uint8_t *data;
+	uint32_t seq;
+	bool is_valid;
+};
+
+static void reset(void) {
+	memset(s_owner, OWNER_DMA, sizeof(s_owner));
+	s_dma = 0;
+	s_cpu = 0;
+	s_stalls = 0;
+
+	const uint8_t mac_address[ETH_ADDR_LEN] = {0};
+	struct ip_info ip_info;
+
+	memset(&ip_info, 0, sizeof(struct ip_info));
+
+	udp_init(mac_address, &ip_info);
+}
+
+/*
+ * Port A is read empty every loop. Port B is read once in a while, its last view stays handed out.
+ * Port C is never read.
+ */
+static void test_unpolled_view(void) {
+	reset();
+
+	const int a = udp_bind(6454);
+	const int b = udp_bind(5568);
+	const int c = udp_bind(5569);
+	uint32_t seq[3] = {0, 0, 0};
+	uint32_t seq_read[2] = {0, 0};
+	struct view view[2];
+
+	memset(view, 0, sizeof(view));
+
+	for (uint32_t n = 0; n < 200000; n++) {
+		const uint8_t *data;
+		uint32_t from_ip;
+		uint16_t from_port;
+
+		while (udp_recv2((uint8_t) a, &data, &from_ip, &from_port) != 0) {
+			uint32_t s;
+			memcpy(&s, data, sizeof(uint32_t));
+			check("port A order", n, s >= seq_read[0]);
+			check("port A data", n, is_intact(data, s));
+			seq_read[0] = s + 1;
+			view[0].data = data;
+			view[0].seq = s;
+			view[0].is_valid = true;
+		}
+
+		if ((n % 250) == 0) {
+			if (udp_recv2((uint8_t) b, &data, &from_ip, &from_port) != 0) {
+				uint32_t s;
+				memcpy(&s, data, sizeof(uint32_t));
+				check("port B order", n, s >= seq_read[1]);
+				check("port B data", n, is_intact(data, s));
+				seq_read[1] = s + 1;
+				view[1].data = data;
+				view[1].seq = s;
+				view[1].is_valid = true;
+			}
+		}
+
+		/* The DMA runs while the views are in use */
+		const uint32_t frames = (uint32_t) rand() % 7;
+
+		for (uint32_t i = 0; i < frames; i++) {
+			if ((rand() % 16) == 0) {
+				arrive(5569, seq[2]++);
+			} else {
+				arrive(6454, seq[0]++);
+			}
+		}
+
+		/* Port B has a held descriptor at the front when it is read */
+		if ((n % 250) == 249) {
+			arrive(5568, seq[1]++);
+		}
+
+		for (uint32_t i = 0; i < 2; i++) {
+			if (view[i].is_valid) {
+				check("view", n, is_intact(view[i].data, view[i].seq));
+				view[i].is_valid = false;
+			}
+		}
+
+		net_handle();
+	}
+
+	check("stalls", s_stalls, s_stalls == 0);
+	check("port A overflow", udp_get_rx_overflow((uint8_t) a), udp_get_rx_overflow((uint8_t) a) == 0);
+	check("port B overflow", udp_get_rx_overflow((uint8_t) b), udp_get_rx_overflow((uint8_t) b) == 0);
+	check("port B read", seq_read[1], (seq[1] - seq_read[1]) <= 1);	// The last one arrives after the last read
+	check("port C overflow", udp_get_rx_overflow((uint8_t) c), udp_get_rx_overflow((uint8_t) c) != 0);
+
+	udp_unbind(6454);
+	udp_unbind(5568);
+	udp_unbind(5569);
+}
+
+/*
+ * The DMA is close to the descriptor when it is handed out, the view is a copy.
+ */
+static void test_recv2_near_dma(void) {
+	reset();
+
+	const int a = udp_bind(6454);
+	const int b = udp_bind(5568);
+
+	arrive(5568, 0);
+	net_handle();
+
+	for (uint32_t i = 1; i < (RX_DESCR_NUM - 4); i++) {
+		arrive(6454, i);
+	}
+
+	const uint8_t *data;
+	uint32_t from_ip;
+	uint16_t from_port;
+
+	check("recv2 size", 0, udp_recv2((uint8_t) b, &data, &from_ip, &from_port) == PAYLOAD_SIZE);
+	check("recv2 copy", 0, !is_descriptor(data));
+	check("recv2 data", 0, is_intact(data, 0));
+	check("recv2 released", 0, s_owner[0] == OWNER_DMA);
+
+	/* The DMA wraps, the descriptor of the view is filled again */
+	for (uint32_t i = 0; i < 5; i++) {
+		arrive(6454, RX_DESCR_NUM + i);
+	}
+
+	check("recv2 view", 0, is_intact(data, 0));
+	check("stalls", s_stalls, s_stalls == 0);
+
+	udp_recv2_release((uint8_t) b);
+	(void) a;
+
+	udp_unbind(6454);
+	udp_unbind(5568);
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	srand(1);
+
+	test_unpolled_view();
+	test_recv2_near_dma();
+
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -31,6 +31,7 @@
 #include "nodemsgconst.h"
 
 #include "display.h"
+#include "hardware.h"
 
 #include "debug.h"
 
@@ -169,10 +170,15 @@ void Node::Start() {
 				const bool isActive = ArtNetNode::GetRdm(nPortIndex) && ArtNetNode::GetPortAddress(nPortIndex, nUniverse, lightset::PortDir::OUTPUT);
 
 				if (isActive) {
-					m_pArtNetRdmController->Full(nPortIndex);
+					m_pArtNetRdmController->Discovery(nPortIndex, false);
 				}
 			}
 
+			while (m_pArtNetRdmController->IsDiscoveryRunning()) {
+				Hardware::Get()->WatchdogFeed();
+				m_pArtNetRdmController->Run();
+			}
+
 			ArtNetNode::SetRdmHandler(m_pArtNetRdmController);
 		}
 #endif
@@ -0,0 +1,122 @@
+/**
+ * @file oscbundle.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef OSCBUNDLE_H_
+#define OSCBUNDLE_H_
+
+#include <cstdint>
+
+/*
+ * OSC-bundle
+ * The OSC-string "#bundle", followed by an OSC Time Tag,
+ * followed by zero or more bundle elements. A bundle element is an int32 size count,
+ * followed by that many bytes of an OSC-message or an OSC-bundle.
+ */
+
+namespace osc {
+namespace bundle {
+static constexpr char TAG[8] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0' };
+static constexpr uint32_t HEADER_SIZE = 16;	///< "#bundle" and the time tag
+namespace send {
+static constexpr auto BUFFER_SIZE = 1024U;
+}  // namespace send
+}  // namespace bundle
+namespace timetag {
+/*
+ * The time tag is a 64-bit NTP timestamp, seconds since 1 January 1900 and a 32-bit fraction.
+ */
+static constexpr uint64_t IMMEDIATELY = 1;
+static constexpr uint32_t NTP_UNIX_OFFSET = 2208988800U;
+
+uint64_t now();
+uint64_t from_millis(uint32_t nMillis);	///< A relative time in milliseconds as a time tag interval
+}  // namespace timetag
+
+inline static bool is_bundle(const void *pData, uint32_t nLength) {
+	const auto *p = reinterpret_cast<const uint8_t *>(pData);
+	return (nLength >= bundle::HEADER_SIZE) && (p[0] == '#') && (p[1] == 'b') && (p[7] == '\0');
+}
+}  // namespace osc
+
+class OscBundle {
+public:
+	OscBundle(const void *pData, uint32_t nLength);
+
+	bool IsValid() const {
+		return m_bIsValid;
+	}
+
+	uint64_t GetTimeTag() const {
+		return m_nTimeTag;
+	}
+
+	/**
+	 * Returns the next element, a message or a nested bundle, and its size.
+	 * Returns nullptr when there are no more elements, or when an element is malformed.
+	 */
+	const uint8_t *Next(uint32_t& nSize);
+
+private:
+	const uint8_t *m_pData;
+	uint32_t m_nLength;
+	uint32_t m_nOffset { osc::bundle::HEADER_SIZE };
+	uint64_t m_nTimeTag { 0 };
+	bool m_bIsValid { false };
+};
+
+/*
+ * The elements are added to a buffer, the bundle is sent with Send.
+ * An element that does not fit anymore is not added.
+ */
+class OscBundleSend {
+public:
+	OscBundleSend(uint64_t nTimeTag = osc::timetag::IMMEDIATELY);
+
+	// Support for path only
+	bool Add(const char *pPath);
+	// Support for 's'
+	bool Add(const char *pPath, const char *pString);
+	// Support for type 'i'
+	bool Add(const char *pPath, int nValue);
+	// Support for type 'f'
+	bool Add(const char *pPath, float fValue);
+
+	uint32_t GetLength() const {
+		return m_nLength;
+	}
+
+	void Send(int32_t nHandle, uint32_t nIpAddress, uint16_t nPort);
+
+private:
+	char *AddMessage(const char *pPath, char cType, uint32_t nArgumentSize);
+
+private:
+	uint32_t m_nLength;
+
+	static char s_Bundle[osc::bundle::send::BUFFER_SIZE];
+};
+
+#endif /* OSCBUNDLE_H_ */
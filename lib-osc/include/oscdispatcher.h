@@ -0,0 +1,83 @@
+/**
+ * @file oscdispatcher.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef OSCDISPATCHER_H_
+#define OSCDISPATCHER_H_
+
+#include <cstdint>
+
+/*
+ * The registered addresses are compiled once, so that an incoming path is matched
+ * without walking a chain of pattern matches.
+ * Addresses without wildcard characters are kept in a hash table, a single lookup.
+ * Addresses with wildcards are only pattern matched when their literal prefix matches.
+ * An exact address takes precedence, then the wildcards in the order they were added.
+ */
+
+namespace osc {
+namespace dispatcher {
+static constexpr uint32_t MAX_ADDRESSES = 16;
+static constexpr uint32_t HASH_SIZE = 32;	///< Power of 2, at least twice MAX_ADDRESSES
+static constexpr int32_t NO_MATCH = -1;
+}  // namespace dispatcher
+}  // namespace osc
+
+class OscDispatcher {
+public:
+	OscDispatcher() {
+		Clear();
+	}
+
+	void Clear();
+
+	/**
+	 * The address is not copied, it must stay valid. After the address is changed, Clear and Add again.
+	 */
+	bool Add(const char *pAddress, uint32_t nId);
+
+	/**
+	 * Returns the id of the matching address, or osc::dispatcher::NO_MATCH
+	 */
+	int32_t Match(const char *pPath) const;
+
+private:
+	struct Address {
+		const char *pAddress;
+		uint32_t nId;
+		uint32_t nPrefixLength;	///< Wildcards only, the literal characters before the first wildcard
+	};
+
+	static uint32_t Hash(const char *pString, uint32_t& nLength);
+
+private:
+	Address m_Exact[osc::dispatcher::MAX_ADDRESSES];
+	Address m_Wildcard[osc::dispatcher::MAX_ADDRESSES];
+	uint32_t m_nExact;
+	uint32_t m_nWildcard;
+	uint8_t m_HashTable[osc::dispatcher::HASH_SIZE];	///< Index into m_Exact, 0xFF is empty
+};
+
+#endif /* OSCDISPATCHER_H_ */
@@ -0,0 +1,199 @@
+/**
+ * @file oscbundle.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstring>
+#if defined (__linux__) || defined (H3)
+# include <sys/time.h>
+#else
+# include <time.h>
+#endif
+#include <cassert>
+
+#include "oscbundle.h"
+#include "osc.h"
+#include "oscstring.h"
+
+#include "network.h"
+
+#include "debug.h"
+
+namespace osc {
+namespace timetag {
+uint64_t now() {
+#if defined (__linux__) || defined (H3)
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+
+	const auto nSeconds = static_cast<uint64_t>(static_cast<uint32_t>(tv.tv_sec) + NTP_UNIX_OFFSET);
+	const auto nFraction = (static_cast<uint64_t>(tv.tv_usec) << 32) / 1000000U;
+
+	return (nSeconds << 32) | nFraction;
+#else
+	// No sub-second system time, bundles are scheduled with a 1 second resolution
+	const auto nSeconds = static_cast<uint64_t>(static_cast<uint32_t>(time(nullptr)) + NTP_UNIX_OFFSET);
+	return nSeconds << 32;
+#endif
+}
+
+uint64_t from_millis(uint32_t nMillis) {
+	return ((static_cast<uint64_t>(nMillis / 1000U) << 32) | ((static_cast<uint64_t>(nMillis % 1000U) << 32) / 1000U));
+}
+}  // namespace timetag
+}  // namespace osc
+
+static uint32_t get_uint32(const uint8_t *p) {
+	uint32_t nValue;
+	memcpy(&nValue, p, sizeof(uint32_t));
+	return __builtin_bswap32(nValue);
+}
+
+OscBundle::OscBundle(const void *pData, uint32_t nLength) : m_pData(reinterpret_cast<const uint8_t *>(pData)), m_nLength(nLength) {
+	if ((nLength < osc::bundle::HEADER_SIZE) || ((nLength & 0x3) != 0) || (memcmp(m_pData, osc::bundle::TAG, sizeof(osc::bundle::TAG)) != 0)) {
+		return;
+	}
+
+	m_nTimeTag = (static_cast<uint64_t>(get_uint32(&m_pData[8])) << 32) | get_uint32(&m_pData[12]);
+	m_bIsValid = true;
+}
+
+const uint8_t *OscBundle::Next(uint32_t& nSize) {
+	if (!m_bIsValid || ((m_nOffset + 4) > m_nLength)) {
+		return nullptr;
+	}
+
+	nSize = get_uint32(&m_pData[m_nOffset]);
+
+	if ((nSize == 0) || ((nSize & 0x3) != 0) || (nSize > (m_nLength - m_nOffset - 4))) {
+		DEBUG_PRINTF("Invalid element size %u", nSize);
+		m_bIsValid = false;
+		return nullptr;
+	}
+
+	const auto *pElement = &m_pData[m_nOffset + 4];
+	m_nOffset += 4 + nSize;
+
+	return pElement;
+}
+
+char OscBundleSend::s_Bundle[osc::bundle::send::BUFFER_SIZE];
+
+OscBundleSend::OscBundleSend(uint64_t nTimeTag) : m_nLength(osc::bundle::HEADER_SIZE) {
+	memcpy(s_Bundle, osc::bundle::TAG, sizeof(osc::bundle::TAG));
+
+	const auto nSeconds = __builtin_bswap32(static_cast<uint32_t>(nTimeTag >> 32));
+	const auto nFraction = __builtin_bswap32(static_cast<uint32_t>(nTimeTag));
+
+	memcpy(&s_Bundle[8], &nSeconds, sizeof(uint32_t));
+	memcpy(&s_Bundle[12], &nFraction, sizeof(uint32_t));
+}
+
+/*
+ * Writes the element size, the path and the type tag. Returns where the argument goes.
+ */
+char *OscBundleSend::AddMessage(const char *pPath, char cType, uint32_t nArgumentSize) {
+	const auto nPathLength = osc::string_size(pPath);
+	const auto nMessageLength = nPathLength + 4U + nArgumentSize;
+
+	if ((m_nLength + 4U + nMessageLength) > sizeof(s_Bundle)) {
+		DEBUG_PUTS("Bundle is full");
+		return nullptr;
+	}
+
+	const auto nElementSize = __builtin_bswap32(nMessageLength);
+	memcpy(&s_Bundle[m_nLength], &nElementSize, sizeof(uint32_t));
+
+	auto *pMessage = &s_Bundle[m_nLength + 4U];
+
+	memset(pMessage + nPathLength - 4, 0, 4);
+	strcpy(pMessage, pPath);
+
+	pMessage[nPathLength + 0] = ',';
+	pMessage[nPathLength + 1] = cType;
+	pMessage[nPathLength + 2] = '\0';
+	pMessage[nPathLength + 3] = '\0';
+
+	m_nLength += 4U + nMessageLength;
+
+	return &pMessage[nPathLength + 4];
+}
+
+bool OscBundleSend::Add(const char *pPath) {
+	return AddMessage(pPath, '\0', 0) != nullptr;
+}
+
+bool OscBundleSend::Add(const char *pPath, const char *pString) {
+	const auto nStringSize = osc::string_size(pString);
+	auto *pArgument = AddMessage(pPath, osc::type::STRING, nStringSize);
+
+	if (pArgument == nullptr) {
+		return false;
+	}
+
+	memset(pArgument + nStringSize - 4, 0, 4);
+	strcpy(pArgument, pString);
+
+	return true;
+}
+
+bool OscBundleSend::Add(const char *pPath, int nValue) {
+	auto *pArgument = AddMessage(pPath, osc::type::INT32, 4);
+
+	if (pArgument == nullptr) {
+		return false;
+	}
+
+	const auto nData = __builtin_bswap32(static_cast<uint32_t>(nValue));
+	memcpy(pArgument, &nData, sizeof(uint32_t));
+
+	return true;
+}
+
+bool OscBundleSend::Add(const char *pPath, float fValue) {
+	auto *pArgument = AddMessage(pPath, osc::type::FLOAT, 4);
+
+	if (pArgument == nullptr) {
+		return false;
+	}
+
+	union pcast32 {
+		uint32_t u;
+		float f;
+	} osc_pcast32;
+
+	osc_pcast32.f = fValue;
+
+	const auto nData = __builtin_bswap32(osc_pcast32.u);
+	memcpy(pArgument, &nData, sizeof(uint32_t));
+
+	return true;
+}
+
+void OscBundleSend::Send(int32_t nHandle, uint32_t nIpAddress, uint16_t nPort) {
+	debug_dump(s_Bundle, static_cast<uint16_t>(m_nLength));
+
+	Network::Get()->SendTo(nHandle, s_Bundle, static_cast<uint16_t>(m_nLength), nIpAddress, nPort);
+}
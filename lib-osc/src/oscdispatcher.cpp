@@ -0,0 +1,135 @@
+/**
+ * @file oscdispatcher.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "oscdispatcher.h"
+#include "osc.h"
+
+#include "debug.h"
+
+static_assert((osc::dispatcher::HASH_SIZE & (osc::dispatcher::HASH_SIZE - 1)) == 0, "HASH_SIZE must be a power of 2");
+static_assert(osc::dispatcher::HASH_SIZE >= 2 * osc::dispatcher::MAX_ADDRESSES, "HASH_SIZE is too small");
+
+static constexpr uint8_t EMPTY = 0xFF;
+
+/*
+ * FNV-1a
+ */
+uint32_t OscDispatcher::Hash(const char *pString, uint32_t& nLength) {
+	auto nHash = 2166136261U;
+	const auto *p = reinterpret_cast<const uint8_t *>(pString);
+
+	while (*p != '\0') {
+		nHash ^= *p++;
+		nHash *= 16777619U;
+	}
+
+	nLength = static_cast<uint32_t>(p - reinterpret_cast<const uint8_t *>(pString));
+
+	return nHash;
+}
+
+void OscDispatcher::Clear() {
+	m_nExact = 0;
+	m_nWildcard = 0;
+	memset(m_HashTable, EMPTY, sizeof(m_HashTable));
+}
+
+bool OscDispatcher::Add(const char *pAddress, uint32_t nId) {
+	assert(pAddress != nullptr);
+
+	const auto nPrefixLength = static_cast<uint32_t>(strcspn(pAddress, "*?[{"));
+
+	if (pAddress[nPrefixLength] != '\0') {
+		if (m_nWildcard == osc::dispatcher::MAX_ADDRESSES) {
+			DEBUG_PUTS("Too many wildcard addresses");
+			return false;
+		}
+
+		m_Wildcard[m_nWildcard].pAddress = pAddress;
+		m_Wildcard[m_nWildcard].nId = nId;
+		m_Wildcard[m_nWildcard].nPrefixLength = nPrefixLength;
+		m_nWildcard++;
+
+		return true;
+	}
+
+	if (m_nExact == osc::dispatcher::MAX_ADDRESSES) {
+		DEBUG_PUTS("Too many addresses");
+		return false;
+	}
+
+	uint32_t nLength;
+	auto nIndex = Hash(pAddress, nLength) & (osc::dispatcher::HASH_SIZE - 1);
+
+	while (m_HashTable[nIndex] != EMPTY) {
+		if (strcmp(m_Exact[m_HashTable[nIndex]].pAddress, pAddress) == 0) {
+			DEBUG_PRINTF("Duplicate address %s", pAddress);
+			return true;	// The first one added wins
+		}
+		nIndex = (nIndex + 1) & (osc::dispatcher::HASH_SIZE - 1);
+	}
+
+	m_Exact[m_nExact].pAddress = pAddress;
+	m_Exact[m_nExact].nId = nId;
+	m_Exact[m_nExact].nPrefixLength = nLength;
+	m_HashTable[nIndex] = static_cast<uint8_t>(m_nExact);
+	m_nExact++;
+
+	return true;
+}
+
+int32_t OscDispatcher::Match(const char *pPath) const {
+	assert(pPath != nullptr);
+
+	uint32_t nLength;
+	auto nIndex = Hash(pPath, nLength) & (osc::dispatcher::HASH_SIZE - 1);
+
+	while (m_HashTable[nIndex] != EMPTY) {
+		const auto& exact = m_Exact[m_HashTable[nIndex]];
+
+		if ((exact.nPrefixLength == nLength) && (memcmp(exact.pAddress, pPath, nLength) == 0)) {
+			return static_cast<int32_t>(exact.nId);
+		}
+
+		nIndex = (nIndex + 1) & (osc::dispatcher::HASH_SIZE - 1);
+	}
+
+	for (uint32_t i = 0; i < m_nWildcard; i++) {
+		const auto& wildcard = m_Wildcard[i];
+
+		if ((wildcard.nPrefixLength <= nLength) && (memcmp(wildcard.pAddress, pPath, wildcard.nPrefixLength) == 0)) {
+			if (osc::is_match(pPath, wildcard.pAddress)) {
+				return static_cast<int32_t>(wildcard.nId);
+			}
+		}
+	}
+
+	return osc::dispatcher::NO_MATCH;
+}
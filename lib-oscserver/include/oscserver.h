@@ -29,6 +29,8 @@
 #include <cstdint>
 #include <cassert>
 
+#include "oscdispatcher.h"
+
 #include "lightset.h"
 
 namespace osc {
@@ -41,6 +43,18 @@ struct DefaultPort {
 struct Max {
 	static constexpr auto PATH_LENGTH = 128U;
 };
+
+/*
+ * Bundles with a time tag in the future are kept until they are due.
+ * A time tag further ahead than HORIZON_MILLIS is executed immediately,
+ * the local clock is not synchronized with the sender (e.g. no NTP, no RTC).
+ */
+struct Bundle {
+	static constexpr auto SCHEDULED = 4U;
+	static constexpr auto MAX_SIZE = 1472U;
+	static constexpr auto MAX_DEPTH = 4U;
+	static constexpr auto HORIZON_MILLIS = 4000U;
+};
 }  // namespace server
 }  // namespace osc
 
@@ -130,6 +144,13 @@ public:
 	}
 
 private:
+	void Compile();
+	void HandleMessage(char *pData, uint32_t nSize, uint32_t nRemoteIp);
+	void HandleBundle(char *pData, uint32_t nSize, uint32_t nRemoteIp, uint32_t nDepth);
+	bool Schedule(const char *pData, uint32_t nSize, uint32_t nRemoteIp, uint64_t nTimeTag);
+	void RunScheduled();
+	void DataChanged(uint16_t nLength);
+	void SetData();
 	int GetChannel(const char *p);
 	bool IsDmxDataChanged(const uint8_t *pData, uint16_t nStartChannel, uint32_t nLength);
 
@@ -138,6 +159,8 @@ private:
 	uint16_t m_nPortOutgoing { osc::server::DefaultPort::OUTGOING };
 	int32_t m_nHandle { -1 };
 	uint16_t m_nLastChannel { 0 };
+	uint16_t m_nSetDataLength { 0 };
+	bool m_bSetData { false };
 
 	bool m_bPartialTransmission { false };
 	bool m_bEnableNoChangeUpdate { false };
@@ -150,6 +173,18 @@ private:
 	const char *m_pModel;
 	const char *m_pSoC;
 
+	OscDispatcher m_Dispatcher;
+
+	struct Scheduled {
+		uint64_t nTimeTag;
+		uint32_t nSize;
+		uint32_t nRemoteIp;
+		uint32_t nMillis;	///< When it was scheduled
+	};
+
+	Scheduled m_Scheduled[osc::server::Bundle::SCHEDULED];
+	uint32_t m_nScheduled { 0 };
+
 	static char s_aPath[osc::server::Max::PATH_LENGTH];
 	static char s_aPathSecond[osc::server::Max::PATH_LENGTH];
 	static char s_aPathInfo[osc::server::Max::PATH_LENGTH];
@@ -157,6 +192,7 @@ private:
 
 	static uint8_t s_pData[lightset::dmx::UNIVERSE_SIZE];
 	static uint8_t s_pOsc[lightset::dmx::UNIVERSE_SIZE];
+	static char s_Scheduled[osc::server::Bundle::SCHEDULED][osc::server::Bundle::MAX_SIZE];
 
 	static char *s_pUdpBuffer;
 	static OscServer *s_pThis;
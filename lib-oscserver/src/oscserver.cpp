@@ -30,6 +30,7 @@
 
 #include "oscserver.h"
 #include "osc.h"
+#include "oscbundle.h"
 #include "oscsimplemessage.h"
 #include "oscsimplesend.h"
 #include "oscblob.h"
@@ -49,6 +50,14 @@
 
 #define SOFTWARE_VERSION "1.0"
 
+namespace osc {
+namespace server {
+enum class Dispatch : uint32_t {
+	PATH, BLACKOUT, SECOND, PING, INFO
+};
+}  // namespace server
+}  // namespace osc
+
 char OscServer::s_aPath[osc::server::Max::PATH_LENGTH];
 char OscServer::s_aPathSecond[osc::server::Max::PATH_LENGTH];
 char OscServer::s_aPathInfo[osc::server::Max::PATH_LENGTH];
@@ -57,6 +66,7 @@ char OscServer::s_aPathBlackOut[osc::server::Max::PATH_LENGTH];
 char *OscServer::s_pUdpBuffer;
 uint8_t OscServer::s_pData[lightset::dmx::UNIVERSE_SIZE];
 uint8_t OscServer::s_pOsc[lightset::dmx::UNIVERSE_SIZE];
+char OscServer::s_Scheduled[osc::server::Bundle::SCHEDULED][osc::server::Bundle::MAX_SIZE];
 
 OscServer *OscServer::s_pThis;
 
@@ -77,6 +87,8 @@ OscServer::OscServer() {
 	memset(s_aPathBlackOut, 0, sizeof(s_aPathBlackOut));
 	strcpy(s_aPathBlackOut, OSCSERVER_DEFAULT_PATH_BLACKOUT);
 
+	memset(m_Scheduled, 0, sizeof(m_Scheduled));
+
 	snprintf(m_Os, sizeof(m_Os) - 1, "[V%s] %s", SOFTWARE_VERSION, __DATE__);
 
 	uint8_t nHwTextLength;
@@ -87,6 +99,8 @@ OscServer::OscServer() {
 		m_pSoC = Hardware::Get()->GetCpuName(nHwTextLength);
 	}
 
+	Compile();
+
 	DEBUG_EXIT
 }
 
@@ -132,6 +146,8 @@ void OscServer::SetPath(const char* pPath) {
 		s_aPathSecond[length] = '\0';
 	}
 
+	Compile();
+
 	DEBUG_PUTS(s_aPath);
 	DEBUG_PUTS(s_aPathSecond);
 }
@@ -147,6 +163,8 @@ void OscServer::SetPathInfo(const char* pPathInfo) {
 		}
 	}
 
+	Compile();
+
 	DEBUG_PUTS(s_aPathInfo);
 }
 
@@ -161,9 +179,23 @@ void OscServer::SetPathBlackOut(const char* pPathBlackOut) {
 		}
 	}
 
+	Compile();
+
 	DEBUG_PUTS(s_aPathBlackOut);
 }
 
+/*
+ * The order of adding is the order of the former match chain, for the wildcard addresses that is the precedence.
+ */
+void OscServer::Compile() {
+	m_Dispatcher.Clear();
+	m_Dispatcher.Add(s_aPath, static_cast<uint32_t>(osc::server::Dispatch::PATH));
+	m_Dispatcher.Add(s_aPathBlackOut, static_cast<uint32_t>(osc::server::Dispatch::BLACKOUT));
+	m_Dispatcher.Add(s_aPathSecond, static_cast<uint32_t>(osc::server::Dispatch::SECOND));
+	m_Dispatcher.Add("/ping", static_cast<uint32_t>(osc::server::Dispatch::PING));
+	m_Dispatcher.Add(s_aPathInfo, static_cast<uint32_t>(osc::server::Dispatch::INFO));
+}
+
 int OscServer::GetChannel(const char* p) {
 	assert(p != nullptr);
 
@@ -212,25 +244,50 @@ bool OscServer::IsDmxDataChanged(const uint8_t* pData, uint16_t nStartChannel, u
 	return isChanged;
 }
 
-void OscServer::Run() {
-	uint32_t nRemoteIp;
-	uint16_t nRemotePort;
+/*
+ * The output is updated once per received packet, a bundle with many channel messages is a single SetData.
+ */
+void OscServer::DataChanged(uint16_t nLength) {
+	m_nSetDataLength = nLength > m_nSetDataLength ? nLength : m_nSetDataLength;
+	m_bSetData = true;
+}
 
-	const auto nBytesReceived = Network::Get()->RecvFrom(m_nHandle, const_cast<const void **>(reinterpret_cast<void **>(&s_pUdpBuffer)), &nRemoteIp, &nRemotePort);
+void OscServer::SetData() {
+	if (!m_bSetData) {
+		return;
+	}
 
-	if (__builtin_expect((nBytesReceived == 0), 1)) {
+	m_pLightSet->SetData(0, s_pData, m_nSetDataLength);
+
+	if (!m_bIsRunning) {
+		m_bIsRunning = true;
+		m_pLightSet->Start(0);
+	}
+
+	m_bSetData = false;
+	m_nSetDataLength = 0;
+}
+
+void OscServer::HandleMessage(char *pData, uint32_t nSize, uint32_t nRemoteIp) {
+	const auto *pPath = osc::get_path(pData, nSize);
+
+	if (pPath == nullptr) {
+		DEBUG_PUTS("Invalid path");
 		return;
 	}
 
-	auto bIsDmxDataChanged = false;
+	DEBUG_PRINTF("[%u] path : %s", nSize, pPath);
 
-	OscSimpleMessage Msg(s_pUdpBuffer, nBytesReceived);
+	const auto nMatch = m_Dispatcher.Match(pPath);
 
-	debug_dump(s_pUdpBuffer, nBytesReceived);
+	if (nMatch == osc::dispatcher::NO_MATCH) {
+		return;
+	}
 
-	DEBUG_PRINTF("[%d] path : %s", nBytesReceived, osc::get_path(s_pUdpBuffer, nBytesReceived));
+	OscSimpleMessage Msg(pData, nSize);
 
-	if (osc::is_match(s_pUdpBuffer, s_aPath)) {
+	switch (static_cast<osc::server::Dispatch>(nMatch)) {
+	case osc::server::Dispatch::PATH: {
 		const auto nArgc = Msg.GetArgc();
 
 		if ((nArgc == 1) && (Msg.GetType(0) == osc::type::BLOB)) {
@@ -242,24 +299,18 @@ void OscServer::Run() {
 			if (size <= lightset::dmx::UNIVERSE_SIZE) {
 				const auto *ptr = blob.GetDataPtr();
 
-				bIsDmxDataChanged = IsDmxDataChanged(ptr, 1, size);
+				const auto bIsDmxDataChanged = IsDmxDataChanged(ptr, 1, size);
 
 				if (bIsDmxDataChanged || m_bEnableNoChangeUpdate) {
 					if ((!m_bPartialTransmission) || (size == lightset::dmx::UNIVERSE_SIZE)) {
-						m_pLightSet->SetData(0, s_pData, lightset::dmx::UNIVERSE_SIZE);
+						DataChanged(lightset::dmx::UNIVERSE_SIZE);
 					} else {
 						m_nLastChannel = static_cast<uint16_t>(size > m_nLastChannel ? size : m_nLastChannel);
-						m_pLightSet->SetData(0, s_pData, m_nLastChannel);
-					}
-
-					if (!m_bIsRunning) {
-						m_bIsRunning = true;
-						m_pLightSet->Start(0);
+						DataChanged(m_nLastChannel);
 					}
 				}
 			} else {
 				DEBUG_PUTS("Too many channels");
-				return;
 			}
 		} else if ((nArgc == 2) && (Msg.GetType(0) == osc::type::INT32)) {
 			auto nChannel = static_cast<uint16_t>(1 + Msg.GetInt(0));
@@ -283,28 +334,23 @@ void OscServer::Run() {
 
 			DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
 
-			bIsDmxDataChanged = IsDmxDataChanged(&nData, nChannel, 1);
+			const auto bIsDmxDataChanged = IsDmxDataChanged(&nData, nChannel, 1);
 
 			if (bIsDmxDataChanged || m_bEnableNoChangeUpdate) {
 				if (!m_bPartialTransmission) {
-					m_pLightSet->SetData(0, s_pData, lightset::dmx::UNIVERSE_SIZE);
+					DataChanged(lightset::dmx::UNIVERSE_SIZE);
 				} else {
 					m_nLastChannel = nChannel > m_nLastChannel ? nChannel : m_nLastChannel;
-					m_pLightSet->SetData(0, s_pData, m_nLastChannel);
-				}
-
-				if (!m_bIsRunning) {
-					m_bIsRunning = true;
-					m_pLightSet->Start(0);
+					DataChanged(m_nLastChannel);
 				}
 			}
 		}
-
-		return;
 	}
-
-	if ((m_pOscServerHandler != nullptr) && (osc::is_match(s_pUdpBuffer, s_aPathBlackOut))) {
-		OscSimpleMessage Msg(s_pUdpBuffer, nBytesReceived);
+		break;
+	case osc::server::Dispatch::BLACKOUT:
+		if (m_pOscServerHandler == nullptr) {
+			return;
+		}
 
 		if (Msg.GetType(0) != osc::type::FLOAT) {
 			DEBUG_PUTS("No float");
@@ -318,15 +364,12 @@ void OscServer::Run() {
 			m_pOscServerHandler->Update();
 			DEBUG_PUTS("Update");
 		}
-
-		return;
-	}
-
-	if (osc::is_match(s_pUdpBuffer, s_aPathSecond)) {
+		break;
+	case osc::server::Dispatch::SECOND: {
 		const auto nArgc = Msg.GetArgc();
 
 		if (nArgc == 1) { // /path/N 'i' or 'f'
-			const auto nChannel = static_cast<uint16_t>(GetChannel(s_pUdpBuffer));
+			const auto nChannel = static_cast<uint16_t>(GetChannel(pPath));
 
 			if (nChannel >= 1 && nChannel <= lightset::dmx::UNIVERSE_SIZE) {
 				uint8_t nData;
@@ -343,35 +386,26 @@ void OscServer::Run() {
 
 				DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
 
-				bIsDmxDataChanged = IsDmxDataChanged(&nData, nChannel, 1);
+				const auto bIsDmxDataChanged = IsDmxDataChanged(&nData, nChannel, 1);
 
 				if (bIsDmxDataChanged || m_bEnableNoChangeUpdate) {
 					if (!m_bPartialTransmission) {
-						m_pLightSet->SetData(0, s_pData, lightset::dmx::UNIVERSE_SIZE);
+						DataChanged(lightset::dmx::UNIVERSE_SIZE);
 					} else {
 						m_nLastChannel = nChannel > m_nLastChannel ? nChannel : m_nLastChannel;
-						m_pLightSet->SetData(0, s_pData, m_nLastChannel);
-					}
-
-					if (!m_bIsRunning) {
-						m_bIsRunning = true;
-						m_pLightSet->Start(0);
+						DataChanged(m_nLastChannel);
 					}
 				}
 			}
 		}
-
-		return;
 	}
-
-	if (osc::is_match(s_pUdpBuffer, "/ping")) {
+		break;
+	case osc::server::Dispatch::PING: {
 		DEBUG_PUTS("ping received");
 		OscSimpleSend MsgSend(m_nHandle, nRemoteIp, m_nPortOutgoing, "/pong", nullptr);
-
-		return;
 	}
-
-	if (osc::is_match(s_pUdpBuffer, s_aPathInfo)) {
+		break;
+	case osc::server::Dispatch::INFO: {
 		OscSimpleSend MsgSendInfo(m_nHandle, nRemoteIp, m_nPortOutgoing, "/info/os", "s", m_Os);
 		OscSimpleSend MsgSendModel(m_nHandle, nRemoteIp, m_nPortOutgoing, "/info/model", "s", m_pModel);
 		OscSimpleSend MsgSendSoc(m_nHandle, nRemoteIp, m_nPortOutgoing, "/info/soc", "s", m_pSoC);
@@ -379,9 +413,146 @@ void OscServer::Run() {
 		if (m_pOscServerHandler != nullptr) {
 			m_pOscServerHandler->Info(m_nHandle, nRemoteIp, m_nPortOutgoing);
 		}
+	}
+		break;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
+	}
+}
 
+/*
+ * A bundle that is due is executed element by element, in order.
+ * A nested bundle has its own time tag, it can be scheduled later than its parent.
+ */
+void OscServer::HandleBundle(char *pData, uint32_t nSize, uint32_t nRemoteIp, uint32_t nDepth) {
+	OscBundle bundle(pData, nSize);
+
+	if (!bundle.IsValid() || (nDepth == osc::server::Bundle::MAX_DEPTH)) {
+		DEBUG_PUTS("Invalid bundle");
 		return;
 	}
+
+	const auto nTimeTag = bundle.GetTimeTag();
+
+	if (nTimeTag != osc::timetag::IMMEDIATELY) {
+		const auto nNow = osc::timetag::now();
+
+		if (nTimeTag > nNow) {
+			if ((nTimeTag - nNow) > osc::timetag::from_millis(osc::server::Bundle::HORIZON_MILLIS)) {
+				DEBUG_PUTS("Beyond the horizon");
+			} else if (Schedule(pData, nSize, nRemoteIp, nTimeTag)) {
+				return;
+			}
+		}
+	}
+
+	uint32_t nElementSize;
+	const uint8_t *pElement;
+
+	while ((pElement = bundle.Next(nElementSize)) != nullptr) {
+		auto *p = reinterpret_cast<char *>(const_cast<uint8_t *>(pElement));
+
+		if (osc::is_bundle(p, nElementSize)) {
+			HandleBundle(p, nElementSize, nRemoteIp, nDepth + 1);
+		} else {
+			HandleMessage(p, nElementSize, nRemoteIp);
+		}
+	}
+}
+
+/*
+ * Returns false when the bundle cannot be kept, it is then executed now. Late is better than lost.
+ */
+bool OscServer::Schedule(const char *pData, uint32_t nSize, uint32_t nRemoteIp, uint64_t nTimeTag) {
+	if (nSize > osc::server::Bundle::MAX_SIZE) {
+		DEBUG_PUTS("Bundle too large");
+		return false;
+	}
+
+	for (uint32_t i = 0; i < osc::server::Bundle::SCHEDULED; i++) {
+		if (m_Scheduled[i].nSize == 0) {
+			memcpy(s_Scheduled[i], pData, nSize);
+			m_Scheduled[i].nTimeTag = nTimeTag;
+			m_Scheduled[i].nSize = nSize;
+			m_Scheduled[i].nRemoteIp = nRemoteIp;
+			m_Scheduled[i].nMillis = Hardware::Get()->Millis();
+			m_nScheduled++;
+
+			DEBUG_PRINTF("Scheduled [%u]", i);
+			return true;
+		}
+	}
+
+	DEBUG_PUTS("No free slot");
+	return false;
+}
+
+/*
+ * The bundles that are due are executed in time tag order.
+ * A slot is freed after its bundle is executed, a nested bundle scheduled meanwhile cannot overwrite it.
+ * A bundle that is not due after being held longer than the horizon is dropped, the local clock has been set back.
+ */
+void OscServer::RunScheduled() {
+	const auto nNow = osc::timetag::now();
+	const auto nMillis = Hardware::Get()->Millis();
+
+	for (uint32_t i = 0; i < osc::server::Bundle::SCHEDULED; i++) {
+		if ((m_Scheduled[i].nSize != 0) && (m_Scheduled[i].nTimeTag > nNow) && ((nMillis - m_Scheduled[i].nMillis) > osc::server::Bundle::HORIZON_MILLIS)) {
+			DEBUG_PRINTF("Dropped [%u]", i);
+			m_Scheduled[i].nSize = 0;
+			m_nScheduled--;
+		}
+	}
+
+	for (;;) {
+		auto nNext = osc::server::Bundle::SCHEDULED;
+
+		for (uint32_t i = 0; i < osc::server::Bundle::SCHEDULED; i++) {
+			if ((m_Scheduled[i].nSize != 0) && (m_Scheduled[i].nTimeTag <= nNow)) {
+				if ((nNext == osc::server::Bundle::SCHEDULED) || (m_Scheduled[i].nTimeTag < m_Scheduled[nNext].nTimeTag)) {
+					nNext = i;
+				}
+			}
+		}
+
+		if (nNext == osc::server::Bundle::SCHEDULED) {
+			break;
+		}
+
+		HandleBundle(s_Scheduled[nNext], m_Scheduled[nNext].nSize, m_Scheduled[nNext].nRemoteIp, 0);
+
+		m_Scheduled[nNext].nSize = 0;
+		m_nScheduled--;
+	}
+
+	SetData();
+}
+
+void OscServer::Run() {
+	if (__builtin_expect((m_nScheduled != 0), 0)) {
+		RunScheduled();
+	}
+
+	uint32_t nRemoteIp;
+	uint16_t nRemotePort;
+
+	const auto nBytesReceived = Network::Get()->RecvFrom(m_nHandle, const_cast<const void **>(reinterpret_cast<void **>(&s_pUdpBuffer)), &nRemoteIp, &nRemotePort);
+
+	if (__builtin_expect((nBytesReceived == 0), 1)) {
+		return;
+	}
+
+	debug_dump(s_pUdpBuffer, nBytesReceived);
+
+	if (osc::is_bundle(s_pUdpBuffer, nBytesReceived)) {
+		HandleBundle(s_pUdpBuffer, nBytesReceived, nRemoteIp, 0);
+	} else {
+		HandleMessage(s_pUdpBuffer, nBytesReceived, nRemoteIp);
+	}
+
+	SetData();
 }
 
 void OscServer::Print() {
@@ -41,6 +41,7 @@ public:
 	void Stop(uint32_t nPortIndex = 0) override;
 
 	void SetData(uint32_t nPortIndex, const uint8_t *pDmxData, uint32_t nLength) override;
+	void SetDataRange(uint32_t nPortIndex, const uint8_t *pDmxData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) override;
 
 public: // RDM
 	bool SetDmxStartAddress(uint16_t nDmxStartAddress) override;
@@ -91,6 +92,7 @@ private:
 	bool m_bOutputInvert { false };
 	bool m_bOutputDriver { true };
 	bool m_bIsStarted { false };
+	bool m_bForceUpdate { true };
 	PCA9685PWMLed **m_pPWMLed { nullptr };
 	uint8_t *m_pDmxData { nullptr };
 	char *m_pSlotInfoRaw { nullptr };
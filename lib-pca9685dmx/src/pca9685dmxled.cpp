@@ -120,11 +120,26 @@ void PCA9685DmxLed::SetData(__attribute__((unused)) uint32_t nPortIndex, const u
 	}
 }
 
+void PCA9685DmxLed::SetDataRange(uint32_t nPortIndex, const uint8_t *pDmxData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) {
+	const uint32_t nSlotFirst = m_nDmxStartAddress - 1U;
+	const uint32_t nSlotLast = nSlotFirst + m_nDmxFootprint - 1U;
+
+	// Skip when none of the changed slots is within our footprint
+	if (!m_bForceUpdate && ((nFirst > nLast) || (nFirst > nSlotLast) || (nLast < nSlotFirst))) {
+		return;
+	}
+
+	m_bForceUpdate = false;
+
+	SetData(nPortIndex, pDmxData, nLength);
+}
+
 bool PCA9685DmxLed::SetDmxStartAddress(uint16_t nDmxStartAddress) {
 	assert((nDmxStartAddress != 0) && (nDmxStartAddress <= DMX_MAX_CHANNELS));
 
 	if ((nDmxStartAddress != 0) && (nDmxStartAddress <= DMX_MAX_CHANNELS)) {
 		m_nDmxStartAddress = nDmxStartAddress;
+		m_bForceUpdate = true;
 		return true;
 	}
 
@@ -40,6 +40,9 @@ struct DevicesParamsConst {
 	static const char GROUPING_ENABLED[];
 	static const char GROUPING_COUNT[];
 
+	static const char MATRIX_COLUMNS[];
+	static const char MATRIX_ZIGZAG[];
+
 	static const char SPI_SPEED_HZ[];
 
 	static const char GLOBAL_BRIGHTNESS[];
@@ -50,6 +53,9 @@ struct DevicesParamsConst {
 
 	static const char GAMMA_CORRECTION[];
 	static const char GAMMA_VALUE[];
+
+	static const char INPUT_16BIT[];
+	static const char DITHERING[];
 };
 
 #endif /* DEVICESPARAMSCONST_H_ */
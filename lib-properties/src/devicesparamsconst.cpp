@@ -39,6 +39,9 @@ const char DevicesParamsConst::COUNT[] = "led_count";
 const char DevicesParamsConst::GROUPING_ENABLED[] = "led_grouping";
 const char DevicesParamsConst::GROUPING_COUNT[] = "led_group_count";
 
+const char DevicesParamsConst::MATRIX_COLUMNS[] = "led_matrix_columns";
+const char DevicesParamsConst::MATRIX_ZIGZAG[] = "led_matrix_zigzag";
+
 const char DevicesParamsConst::SPI_SPEED_HZ[] = "clock_speed_hz";
 
 const char DevicesParamsConst::GLOBAL_BRIGHTNESS[] = "global_brightness";
@@ -50,3 +53,6 @@ const char DevicesParamsConst::TEST_PATTERN[] = "test_pattern";
 const char DevicesParamsConst::GAMMA_CORRECTION[] = "gamma_correction";
 const char DevicesParamsConst::GAMMA_VALUE[] = "gamma_value";
 
+const char DevicesParamsConst::INPUT_16BIT[] = "led_16bit";
+const char DevicesParamsConst::DITHERING[] = "led_dithering";
+
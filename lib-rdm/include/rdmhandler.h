@@ -53,6 +53,10 @@ private:
 	static const PidDefinition PID_DEFINITIONS[];
 	static const PidDefinition PID_DEFINITIONS_SUB_DEVICES[];
 
+	static constexpr bool IsSorted(const PidDefinition *pPidDefinitions, uint32_t nCount) {
+		return (nCount < 2) || ((pPidDefinitions[0].nPid < pPidDefinitions[1].nPid) && IsSorted(&pPidDefinitions[1], nCount - 1));
+	}
+
 	// Get
 #if defined (ENABLE_RDM_QUEUED_MSG)
 	void GetQueuedMessage(uint16_t nSubDevice);
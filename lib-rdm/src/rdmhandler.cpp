@@ -145,20 +145,26 @@ void RDMHandler::RespondMessageNack(uint16_t nReason) {
 	CreateRespondMessage(E120_RESPONSE_TYPE_NACK_REASON, nReason);
 }
 
-const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[] {
+/**
+ * Sorted by PID, Handlers does a binary search.
+ */
+
+constexpr RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[] {
+#if !defined (NODE_RDMNET_LLRP_ONLY) && defined (ENABLE_RDM_QUEUED_MSG)
+	{E120_QUEUED_MESSAGE,              	&RDMHandler::GetQueuedMessage,           	nullptr,               				1, true , false},
+#endif
+#if !defined (NODE_RDMNET_LLRP_ONLY)
+	{E120_SUPPORTED_PARAMETERS,        	&RDMHandler::GetSupportedParameters,      	nullptr,             				0, false, true , false},
+#endif
 	{E120_DEVICE_INFO,                	&RDMHandler::GetDeviceInfo,               	nullptr,                			0, false, true , true },
+#if !defined (NODE_RDMNET_LLRP_ONLY)
+	{E120_PRODUCT_DETAIL_ID_LIST, 	   	&RDMHandler::GetProductDetailIdList,     	nullptr,							0, true , true , false},
+#endif
 	{E120_DEVICE_MODEL_DESCRIPTION,    	&RDMHandler::GetDeviceModelDescription,		nullptr,                 			0, true , true , true },
 	{E120_MANUFACTURER_LABEL,          	&RDMHandler::GetManufacturerLabel,         	nullptr,                        	0, true , true , true },
 	{E120_DEVICE_LABEL,                	&RDMHandler::GetDeviceLabel,               	&RDMHandler::SetDeviceLabel,		0, true , true , true },
 	{E120_FACTORY_DEFAULTS,            	&RDMHandler::GetFactoryDefaults,          	&RDMHandler::SetFactoryDefaults,	0, true , true , true },
-	{E120_IDENTIFY_DEVICE,		       	&RDMHandler::GetIdentifyDevice,		    	&RDMHandler::SetIdentifyDevice,    	0, false, true , true },
-	{E120_RESET_DEVICE,			    	nullptr,                                	&RDMHandler::SetResetDevice,       	0, true , true , true },
 #if !defined (NODE_RDMNET_LLRP_ONLY)
-#if defined (ENABLE_RDM_QUEUED_MSG)
-	{E120_QUEUED_MESSAGE,              	&RDMHandler::GetQueuedMessage,           	nullptr,               				1, true , false},
-#endif
-	{E120_SUPPORTED_PARAMETERS,        	&RDMHandler::GetSupportedParameters,      	nullptr,             				0, false, true , false},
-	{E120_PRODUCT_DETAIL_ID_LIST, 	   	&RDMHandler::GetProductDetailIdList,     	nullptr,							0, true , true , false},
 	{E120_LANGUAGE_CAPABILITIES,       	&RDMHandler::GetLanguage,			        nullptr,                 			0, true , true , false},
 	{E120_LANGUAGE,						&RDMHandler::GetLanguage,			        &RDMHandler::SetLanguage,           0, true , true , false},
 	{E120_SOFTWARE_VERSION_LABEL,		&RDMHandler::GetSoftwareVersionLabel,   	nullptr,                  			0, false, true , false},
@@ -176,15 +182,6 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[] {
 	{E120_DISPLAY_INVERT,				&RDMHandler::GetDisplayInvert,				&RDMHandler::SetDisplayInvert,		0, true , true , false},
 	{E120_DISPLAY_LEVEL,				&RDMHandler::GetDisplayLevel,				&RDMHandler::SetDisplayLevel,		0, true , true , false},
 	{E120_REAL_TIME_CLOCK,		       	&RDMHandler::GetRealTimeClock,  			&RDMHandler::SetRealTimeClock,    	0, true , true , false},
-	{E120_POWER_STATE,					&RDMHandler::GetPowerState,					&RDMHandler::SetPowerState,			0, true , true , false},
-#if defined (ENABLE_RDM_SELF_TEST)
-	{E120_PERFORM_SELFTEST,				&RDMHandler::GetPerformSelfTest,			&RDMHandler::SetPerformSelfTest,	0, true , true , false},
-	{E120_SELF_TEST_DESCRIPTION,		&RDMHandler::GetSelfTestDescription,		nullptr,							1, true , true , false},
-#endif
-#if defined (ENABLE_RDM_PRESET_PLAYBACK)
-	{E120_PRESET_PLAYBACK,				&RDMHandler::GetPresetPlayback,				&RDMHandler::SetPresetPlayback,		0, true , true , false},
-#endif
-	{E137_1_IDENTIFY_MODE,			   	&RDMHandler::GetIdentifyMode,				&RDMHandler::SetIdentifyMode,		0, true , true , false},
 #endif
 #if defined (NODE_RDMNET_LLRP_ONLY)
 	{E137_2_LIST_INTERFACES,			&RDMHandler::GetInterfaceList,				nullptr,							0, false, false, true },
@@ -193,13 +190,28 @@ const RDMHandler::PidDefinition RDMHandler::PID_DEFINITIONS[] {
 	{E137_2_IPV4_DHCP_MODE,				&RDMHandler::GetDHCPMode,					&RDMHandler::SetDHCPMode,			4, false, false, true },
 	{E137_2_IPV4_ZEROCONF_MODE,			&RDMHandler::GetZeroconf,					&RDMHandler::SetZeroconf,			4, false, false, true },
 	{E137_2_IPV4_CURRENT_ADDRESS,		&RDMHandler::GetAddressNetmask,				nullptr,							4, false, false, true },
-	{E137_2_INTERFACE_RENEW_DHCP, 		nullptr,									&RDMHandler::RenewDhcp,				4, false, false, true },
 	{E137_2_IPV4_STATIC_ADDRESS,		&RDMHandler::GetStaticAddress,				&RDMHandler::SetStaticAddress,		4, false, false, true },
+	{E137_2_INTERFACE_RENEW_DHCP, 		nullptr,									&RDMHandler::RenewDhcp,				4, false, false, true },
 	{E137_2_INTERFACE_APPLY_CONFIGURATION,nullptr,									&RDMHandler::ApplyConfiguration,	4, false, false, true },
-	{E137_2_DNS_IPV4_NAME_SERVER,		&RDMHandler::GetNameServers,				nullptr,							1, false, false, true },
 	{E137_2_IPV4_DEFAULT_ROUTE,			&RDMHandler::GetDefaultRoute,				&RDMHandler::SetDefaultRoute,		4, false, false, true },
+	{E137_2_DNS_IPV4_NAME_SERVER,		&RDMHandler::GetNameServers,				nullptr,							1, false, false, true },
 	{E137_2_DNS_HOSTNAME,               &RDMHandler::GetHostName,                   &RDMHandler::SetHostName,           0, false, false, true },
-	{E137_2_DNS_DOMAIN_NAME,			&RDMHandler::GetDomainName,					&RDMHandler::SetDomainName,			0, false, false, true }
+	{E137_2_DNS_DOMAIN_NAME,			&RDMHandler::GetDomainName,					&RDMHandler::SetDomainName,			0, false, false, true },
+#endif
+	{E120_IDENTIFY_DEVICE,		       	&RDMHandler::GetIdentifyDevice,		    	&RDMHandler::SetIdentifyDevice,    	0, false, true , true },
+	{E120_RESET_DEVICE,			    	nullptr,                                	&RDMHandler::SetResetDevice,       	0, true , true , true },
+#if !defined (NODE_RDMNET_LLRP_ONLY)
+	{E120_POWER_STATE,					&RDMHandler::GetPowerState,					&RDMHandler::SetPowerState,			0, true , true , false},
+#endif
+#if !defined (NODE_RDMNET_LLRP_ONLY) && defined (ENABLE_RDM_SELF_TEST)
+	{E120_PERFORM_SELFTEST,				&RDMHandler::GetPerformSelfTest,			&RDMHandler::SetPerformSelfTest,	0, true , true , false},
+	{E120_SELF_TEST_DESCRIPTION,		&RDMHandler::GetSelfTestDescription,		nullptr,							1, true , true , false},
+#endif
+#if !defined (NODE_RDMNET_LLRP_ONLY) && defined (ENABLE_RDM_PRESET_PLAYBACK)
+	{E120_PRESET_PLAYBACK,				&RDMHandler::GetPresetPlayback,				&RDMHandler::SetPresetPlayback,		0, true , true , false},
+#endif
+#if !defined (NODE_RDMNET_LLRP_ONLY)
+	{E137_1_IDENTIFY_MODE,			   	&RDMHandler::GetIdentifyMode,				&RDMHandler::SetIdentifyMode,		0, true , true , false},
 #endif
 };
 
@@ -355,6 +367,8 @@ void RDMHandler::HandleData(const uint8_t *pRdmDataIn, uint8_t *pRdmDataOut) {
 void RDMHandler::Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nParamId, uint8_t nParamDataLength, uint16_t nSubDevice) {
 	DEBUG1_ENTRY
 
+	static_assert(IsSorted(PID_DEFINITIONS, sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0])), "PID_DEFINITIONS must be sorted by PID");
+
 	PidDefinition const *pid_handler = nullptr;
 	bool bRDM;
 	bool bRDMNet;
@@ -371,11 +385,23 @@ void RDMHandler::Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nPa
 		return;
 	}
 
-	for (uint32_t i = 0; i < sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]); ++i) {
-		if (PID_DEFINITIONS[i].nPid == nParamId) {
-			pid_handler = &PID_DEFINITIONS[i];
-			bRDM = PID_DEFINITIONS[i].bRDM;
-			bRDMNet = PID_DEFINITIONS[i].bRDMNet;
+	uint32_t nLow = 0;
+	uint32_t nHigh = sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]);
+
+	while (nLow < nHigh) {
+		const auto nMid = (nLow + nHigh) / 2;
+
+		if (PID_DEFINITIONS[nMid].nPid == nParamId) {
+			pid_handler = &PID_DEFINITIONS[nMid];
+			bRDM = PID_DEFINITIONS[nMid].bRDM;
+			bRDMNet = PID_DEFINITIONS[nMid].bRDMNet;
+			break;
+		}
+
+		if (PID_DEFINITIONS[nMid].nPid < nParamId) {
+			nLow = nMid + 1;
+		} else {
+			nHigh = nMid;
 		}
 	}
 
@@ -36,6 +36,11 @@
 #include "rdmdevicecontroller.h"
 #include "rdm.h"
 
+namespace artnetrdmcontroller {
+static constexpr uint32_t QUEUE_SIZE = 4;					///< Pending requests per port
+static constexpr uint32_t RECEIVE_TIME_OUT_MICROS = 60000;
+}  // namespace artnetrdmcontroller
+
 class ArtNetRdmController final: public RDMDeviceController, public ArtNetRdm, RDMDiscovery {
 public:
 	ArtNetRdmController(uint32_t nPorts = artnetnode::MAX_PORTS);
@@ -71,6 +76,22 @@ public:
 
 	const uint8_t *Handler(uint32_t nPortIndex, const uint8_t *pRdmData) override;
 
+	bool Request(uint32_t nPortIndex, const uint8_t *pRdmData, uint32_t nIPAddress) override;
+
+	bool Discovery(uint32_t nPortIndex, bool bIncremental) override;
+	void DiscoveryStop(uint32_t nPortIndex) override;
+
+	bool IsDiscoveryRunning() const {
+		for (uint32_t nPortIndex = 0; nPortIndex < s_nPorts; nPortIndex++) {
+			if (s_Port[nPortIndex].bDiscovery) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Run() override;
+
 	bool CopyTodEntry(uint32_t nPortIndex, uint32_t nIndex, uint8_t uid[RDM_UID_SIZE]) {
 		assert(nPortIndex < artnetnode::MAX_PORTS);
 		if (m_pRDMTod[nPortIndex] == nullptr) {
@@ -93,6 +114,31 @@ public:
 	}
 
 private:
+	void Complete(uint32_t nPortIndex, const uint8_t *pRdmResponse);
+
+private:
+	enum class State : uint8_t {
+		IDLE, WAITING
+	};
+
+	struct Transaction {
+		TRdmMessage Message;
+		uint32_t nIPAddress;
+	};
+
+	struct Port {
+		Transaction Queue[artnetrdmcontroller::QUEUE_SIZE];
+		uint32_t nSentMicros;
+		uint8_t nHead;
+		uint8_t nCount;
+		State state;
+		bool bDiscovery;
+		bool bDiscoveryPending;		///< Started when the request in flight is completed
+		bool bDiscoveryIncremental;
+		bool bDiscoveryStopped;		///< The TOD is sent by the caller of DiscoveryStop
+	};
+
+	static Port s_Port[artnetnode::MAX_PORTS];
 	static RDMTod *m_pRDMTod[artnetnode::MAX_PORTS];
 	static TRdmMessage s_rdmMessage;
 	static uint32_t s_nPorts;
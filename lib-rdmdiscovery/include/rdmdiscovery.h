@@ -33,15 +33,57 @@
 #include "rdmmessage.h"
 #include "rdmtod.h"
 
+namespace rdmdiscovery {
+static constexpr uint32_t STACK_SIZE = 64;	///< Pending UID ranges, binary search depth is 48
+static constexpr uint32_t RECEIVE_TIME_OUT_MICROS = 2800;
+static constexpr uint32_t SPACING_MICROS = 5800;
+
+enum class State : uint8_t {
+	IDLE,
+	UN_MUTE, WAIT_UN_MUTE,
+	VERIFY, WAIT_VERIFY,
+	NEXT_RANGE,
+	UNIQUE_BRANCH, WAIT_UNIQUE_BRANCH,
+	MUTE, WAIT_MUTE
+};
+
+struct Range {
+	uint64_t nLower;
+	uint64_t nUpper;
+};
+}  // namespace rdmdiscovery
+
+/**
+ * The discovery is a resumable task per port. Each call to Run() does at most
+ * one step for every active port, without waiting for responses.
+ *
+ * Full discovery un-mutes all devices and flushes the TOD.
+ * Incremental discovery first mutes the known devices, removing the ones that
+ * no longer respond, so only new (un-muted) devices answer DISC_UNIQUE_BRANCH.
+ */
 class RDMDiscovery {
 public:
-	RDMDiscovery(const uint8_t *pUid);
+	RDMDiscovery(const uint8_t *pUid, uint32_t nPorts = 1);
+	~RDMDiscovery();
+
+	void Full(uint32_t nPortIndex, RDMTod *pRDMTod);
 
-	void Full(uint32_t m_nPortIndex, RDMTod *pRDMTod);
+	void Start(uint32_t nPortIndex, RDMTod *pRDMTod, bool bIncremental);
+	void Stop(uint32_t nPortIndex);
+	void Run();
+
+	bool IsRunning(uint32_t nPortIndex) const {
+		return m_pContext[nPortIndex].state != rdmdiscovery::State::IDLE;
+	}
+
+	bool IsTodChanged(uint32_t nPortIndex) const {
+		return m_pContext[nPortIndex].bTodChanged;
+	}
 
 private:
-	bool FindDevices(uint64_t LowerBound, uint64_t UpperBound);
-	bool QuickFind(const uint8_t *pUid);
+	void Step(uint32_t nPortIndex);
+	void Send(uint32_t nPortIndex, uint16_t nPid, const uint8_t *pUid);
+	void Push(uint32_t nPortIndex, uint64_t nLower, uint64_t nUpper);
 
 	bool IsValidDiscoveryResponse(const uint8_t *pDiscResponse, uint8_t *pUid);
 
@@ -51,9 +93,23 @@ private:
 	uint64_t ConvertUid(const uint8_t *pUid);
 
 private:
+	struct Context {
+		rdmdiscovery::Range Stack[rdmdiscovery::STACK_SIZE];
+		rdmdiscovery::Range Current;
+		RDMTod *pRDMTod;
+		uint32_t nStackTop;
+		uint32_t nTodIndex;
+		uint32_t nSentMicros;
+		uint8_t Uid[RDM_UID_SIZE];
+		uint8_t nUnMuteCount;
+		rdmdiscovery::State state;
+		bool bBranchAgain;
+		bool bTodChanged;
+	};
+
 	RDMMessage m_Message;
-	uint32_t m_nPortIndex;
-	RDMTod *m_pRDMTod;
+	uint32_t m_nPorts;
+	Context *m_pContext;
 	uint8_t m_Uid[RDM_UID_SIZE];
 	uint8_t m_Pdl[2][RDM_UID_SIZE];
 };
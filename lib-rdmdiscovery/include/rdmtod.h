@@ -45,6 +45,10 @@ struct TRdmTod {
 };
 }  // namespace rdmtod
 
+/**
+ * The UIDs are kept sorted, lookups are a binary search.
+ * The mute state of each entry is kept in a bitset.
+ */
 class RDMTod {
 public:
 	RDMTod() {
@@ -54,6 +58,10 @@ public:
 		for (uint32_t i = 0; i < rdmtod::TOD_TABLE_SIZE; i++) {
 			memcpy(&m_pTable[i], UID_ALL, RDM_UID_SIZE);
 		}
+
+		for (uint32_t i = 0; i < MUTED_WORDS; i++) {
+			m_Muted[i] = 0;
+		}
 	}
 
 	~RDMTod() {
@@ -67,6 +75,7 @@ public:
 		}
 
 		m_nEntries = 0;
+		UnMuteAll();
 	}
 
 	bool AddUid(const uint8_t *pUid) {
@@ -74,11 +83,21 @@ public:
 			return false;
 		}
 
-		if (Exist(pUid)) {
+		uint32_t nIndex;
+
+		if (Find(pUid, nIndex)) {
 			return false;
 		}
 
-		memcpy(&m_pTable[m_nEntries++], pUid, RDM_UID_SIZE);
+		memmove(&m_pTable[nIndex + 1], &m_pTable[nIndex], (m_nEntries - nIndex) * sizeof(rdmtod::TRdmTod));
+		memcpy(&m_pTable[nIndex], pUid, RDM_UID_SIZE);
+
+		for (auto i = m_nEntries; i > nIndex; i--) {
+			SetMutedBit(i, IsMutedBit(i - 1));
+		}
+		SetMutedBit(nIndex, false);
+
+		m_nEntries++;
 
 		return true;
 	}
@@ -98,50 +117,53 @@ public:
 	}
 
 	void Copy(uint8_t *pTable) {
-		const auto *pSrc = reinterpret_cast<const uint8_t*>(m_pTable);
-		auto *pDst = pTable;
-
-		for (uint32_t i = 0; i < (m_nEntries * RDM_UID_SIZE); i++) {
-			*pDst++ = *pSrc++;
-		}
+		memcpy(pTable, m_pTable, m_nEntries * RDM_UID_SIZE);
 	}
 
 	bool Delete(const uint8_t *pUid) {
-		bool found = false;
-		uint32_t i;
-
-		for (i = 0; i < m_nEntries; i++) {
-			if (memcmp(&m_pTable[i], pUid, RDM_UID_SIZE) == 0) {
-				found = true;
-				break;
-			}
-		}
+		uint32_t nIndex;
 
-		if (!found) {
+		if (!Find(pUid, nIndex)) {
 			return false;
 		}
 
-		if (i == rdmtod::TOD_TABLE_SIZE - 1) {
-			memcpy(&m_pTable[i], UID_ALL, RDM_UID_SIZE);
-		} else {
-			for (; i < m_nEntries; i++) {
-				memcpy(&m_pTable[i], &m_pTable[i + 1], RDM_UID_SIZE);
-			}
-		}
-
 		m_nEntries--;
 
+		memmove(&m_pTable[nIndex], &m_pTable[nIndex + 1], (m_nEntries - nIndex) * sizeof(rdmtod::TRdmTod));
+		memcpy(&m_pTable[m_nEntries], UID_ALL, RDM_UID_SIZE);
+
+		for (auto i = nIndex; i < m_nEntries; i++) {
+			SetMutedBit(i, IsMutedBit(i + 1));
+		}
+		SetMutedBit(m_nEntries, false);
+
 		return true;
 	}
 
 	bool Exist(const uint8_t *pUid) {
-		for (uint32_t i = 0 ; i < m_nEntries; i++) {
-			if (memcmp(&m_pTable[i], pUid, RDM_UID_SIZE) == 0) {
-				return true;
-			}
+		uint32_t nIndex;
+		return Find(pUid, nIndex);
+	}
+
+	// Mute state
+
+	void SetMuted(const uint8_t *pUid, bool bIsMuted) {
+		uint32_t nIndex;
+
+		if (Find(pUid, nIndex)) {
+			SetMutedBit(nIndex, bIsMuted);
 		}
+	}
 
-		return false;
+	bool IsMuted(const uint8_t *pUid) {
+		uint32_t nIndex;
+		return Find(pUid, nIndex) && IsMutedBit(nIndex);
+	}
+
+	void UnMuteAll() {
+		for (uint32_t i = 0; i < MUTED_WORDS; i++) {
+			m_Muted[i] = 0;
+		}
 	}
 
 	void Dump(__attribute__((unused)) uint32_t nCount) {
@@ -151,7 +173,7 @@ public:
 	}
 
 	for (uint32_t i = 0 ; i < nCount; i++) {
-		printf("%.2x%.2x:%.2x%.2x%.2x%.2x\n", m_pTable[i].uid[0], m_pTable[i].uid[1], m_pTable[i].uid[2], m_pTable[i].uid[3], m_pTable[i].uid[4], m_pTable[i].uid[5]);
+		printf("%.2x%.2x:%.2x%.2x%.2x%.2x %c\n", m_pTable[i].uid[0], m_pTable[i].uid[1], m_pTable[i].uid[2], m_pTable[i].uid[3], m_pTable[i].uid[4], m_pTable[i].uid[5], IsMutedBit(i) ? 'M' : '-');
 	}
 #endif
 	}
@@ -163,8 +185,51 @@ public:
 	}
 
 private:
+	/**
+	 * Returns true when found, otherwise nIndex is the insert position.
+	 */
+	bool Find(const uint8_t *pUid, uint32_t& nIndex) const {
+		uint32_t nLow = 0;
+		uint32_t nHigh = m_nEntries;
+
+		while (nLow < nHigh) {
+			const auto nMid = (nLow + nHigh) / 2;
+			const auto nCompare = memcmp(&m_pTable[nMid], pUid, RDM_UID_SIZE);
+
+			if (nCompare == 0) {
+				nIndex = nMid;
+				return true;
+			}
+
+			if (nCompare < 0) {
+				nLow = nMid + 1;
+			} else {
+				nHigh = nMid;
+			}
+		}
+
+		nIndex = nLow;
+		return false;
+	}
+
+	bool IsMutedBit(uint32_t nIndex) const {
+		return (m_Muted[nIndex / 32] & (1U << (nIndex & 31))) != 0;
+	}
+
+	void SetMutedBit(uint32_t nIndex, bool bIsMuted) {
+		if (bIsMuted) {
+			m_Muted[nIndex / 32] |= (1U << (nIndex & 31));
+		} else {
+			m_Muted[nIndex / 32] &= ~(1U << (nIndex & 31));
+		}
+	}
+
+private:
+	static constexpr uint32_t MUTED_WORDS = (rdmtod::TOD_TABLE_SIZE + 31) / 32;
+
 	uint32_t m_nEntries { 0 };
 	rdmtod::TRdmTod *m_pTable;
+	uint32_t m_Muted[MUTED_WORDS];
 };
 
 #endif /* RDMTOD_H_ */
@@ -40,11 +40,12 @@
 
 #include "debug.h"
 
+ArtNetRdmController::Port ArtNetRdmController::s_Port[artnetnode::MAX_PORTS];
 RDMTod *ArtNetRdmController::m_pRDMTod[artnetnode::MAX_PORTS];
 TRdmMessage ArtNetRdmController::s_rdmMessage;
 uint32_t ArtNetRdmController::s_nPorts;
 
-ArtNetRdmController::ArtNetRdmController(uint32_t nPorts): RDMDiscovery(RDMDeviceController::GetUID()) {
+ArtNetRdmController::ArtNetRdmController(uint32_t nPorts): RDMDiscovery(RDMDeviceController::GetUID(), nPorts) {
 	DEBUG_ENTRY
 	assert(nPorts <= artnetnode::MAX_PORTS);
 
@@ -54,6 +55,14 @@ ArtNetRdmController::ArtNetRdmController(uint32_t nPorts): RDMDiscovery(RDMDevic
 	for (nPortIndex = 0; nPortIndex < nPorts; nPortIndex++) {
 		m_pRDMTod[nPortIndex] = new RDMTod;
 		assert(m_pRDMTod[nPortIndex] != nullptr);
+
+		s_Port[nPortIndex].nHead = 0;
+		s_Port[nPortIndex].nCount = 0;
+		s_Port[nPortIndex].state = State::IDLE;
+		s_Port[nPortIndex].bDiscovery = false;
+		s_Port[nPortIndex].bDiscoveryPending = false;
+		s_Port[nPortIndex].bDiscoveryIncremental = false;
+		s_Port[nPortIndex].bDiscoveryStopped = false;
 	}
 
 	for (; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
@@ -96,3 +105,157 @@ const uint8_t *ArtNetRdmController::Handler(uint32_t nPortIndex, const uint8_t *
 #endif
 	return pResponse;
 }
+
+/**
+ * While a request is in flight, the discovery is started from Run() when the request is completed.
+ * Otherwise the discovery would consume the response.
+ */
+bool ArtNetRdmController::Discovery(uint32_t nPortIndex, bool bIncremental) {
+	if (nPortIndex >= s_nPorts) {
+		return false;
+	}
+
+	auto& port = s_Port[nPortIndex];
+
+	if (bIncremental && port.bDiscovery) {
+		return true;
+	}
+
+	port.bDiscovery = true;
+	port.bDiscoveryStopped = false;
+
+	if (port.state == State::WAITING) {
+		port.bDiscoveryPending = true;
+		port.bDiscoveryIncremental = bIncremental;
+		return true;
+	}
+
+	port.bDiscoveryPending = false;
+	RDMDiscovery::Start(nPortIndex, m_pRDMTod[nPortIndex], bIncremental);
+
+	return true;
+}
+
+void ArtNetRdmController::DiscoveryStop(uint32_t nPortIndex) {
+	assert(nPortIndex < s_nPorts);
+
+	auto& port = s_Port[nPortIndex];
+
+	RDMDiscovery::Stop(nPortIndex);
+
+	port.bDiscoveryPending = false;
+
+	if (port.bDiscovery) {
+		port.bDiscoveryStopped = true;
+	}
+}
+
+/**
+ * The request is sent from Run(). When the queue is full, the request is
+ * completed without a response, the controller will retry.
+ */
+bool ArtNetRdmController::Request(uint32_t nPortIndex, const uint8_t *pRdmData, uint32_t nIPAddress) {
+	assert(nPortIndex < s_nPorts);
+	assert(pRdmData != nullptr);
+	assert(m_pRdmCompleted != nullptr);
+
+	auto& port = s_Port[nPortIndex];
+
+	if (port.nCount == artnetrdmcontroller::QUEUE_SIZE) {
+		DEBUG_PUTS("RDM queue is full");
+		m_pRdmCompleted(nPortIndex, nullptr, nIPAddress, false);
+		return true;
+	}
+
+	const auto nTail = (port.nHead + port.nCount) % artnetrdmcontroller::QUEUE_SIZE;
+	auto& transaction = port.Queue[nTail];
+	const auto *pRdmMessageNoSc = reinterpret_cast<const TRdmMessageNoSc*>(pRdmData);
+
+	transaction.Message.start_code = E120_SC_RDM;
+	memcpy(&reinterpret_cast<uint8_t*>(&transaction.Message)[1], pRdmData, static_cast<size_t>(pRdmMessageNoSc->message_length + 2));
+	transaction.nIPAddress = nIPAddress;
+
+	port.nCount++;
+
+	return true;
+}
+
+void ArtNetRdmController::Complete(uint32_t nPortIndex, const uint8_t *pRdmResponse) {
+	auto& port = s_Port[nPortIndex];
+	const auto nIPAddress = port.Queue[port.nHead].nIPAddress;
+
+	port.nHead = static_cast<uint8_t>((port.nHead + 1) % artnetrdmcontroller::QUEUE_SIZE);
+	port.nCount--;
+	port.state = State::IDLE;
+
+#ifndef NDEBUG
+	if (pRdmResponse != nullptr) {
+		RDMMessage::Print(pRdmResponse);
+	}
+#endif
+
+	m_pRdmCompleted(nPortIndex, pRdmResponse, nIPAddress, (port.nCount == 0) && !port.bDiscovery);
+}
+
+/**
+ * One step per port, there are no busy waits.
+ * A port is either discovering or handling RDM requests.
+ */
+void ArtNetRdmController::Run() {
+	RDMDiscovery::Run();
+
+	for (uint32_t nPortIndex = 0; nPortIndex < s_nPorts; nPortIndex++) {
+		auto& port = s_Port[nPortIndex];
+
+		if (port.state == State::WAITING) {
+			const auto *pResponse = RDMMessage::Receive(nPortIndex);
+
+			if (pResponse != nullptr) {
+				Complete(nPortIndex, pResponse);
+			} else if ((Hardware::Get()->Micros() - port.nSentMicros) >= artnetrdmcontroller::RECEIVE_TIME_OUT_MICROS) {
+				Complete(nPortIndex, nullptr);
+			} else {
+				continue;
+			}
+		}
+
+		if (port.bDiscovery) {
+			if (port.bDiscoveryPending) {
+				port.bDiscoveryPending = false;
+				RDMDiscovery::Start(nPortIndex, m_pRDMTod[nPortIndex], port.bDiscoveryIncremental);
+				continue;
+			}
+
+			if (RDMDiscovery::IsRunning(nPortIndex)) {
+				continue;
+			}
+
+			port.bDiscovery = false;
+
+			if (m_pDiscoveryFinished != nullptr) {
+				m_pDiscoveryFinished(nPortIndex, RDMDiscovery::IsTodChanged(nPortIndex) && !port.bDiscoveryStopped, port.nCount == 0);
+			}
+
+			port.bDiscoveryStopped = false;
+		}
+
+		if (port.nCount == 0) {
+			continue;
+		}
+
+		while (nullptr != RDMMessage::Receive(nPortIndex)) {
+			// Discard late responses
+		}
+
+		const auto *pRdmCommand = reinterpret_cast<const uint8_t*>(&port.Queue[port.nHead].Message);
+
+#ifndef NDEBUG
+		RDMMessage::Print(pRdmCommand);
+#endif
+
+		RDMMessage::SendRaw(nPortIndex, pRdmCommand, port.Queue[port.nHead].Message.message_length + 2U);
+
+		port.nSentMicros = Hardware::Get()->Micros();
+		port.state = State::WAITING;
+	}
+}
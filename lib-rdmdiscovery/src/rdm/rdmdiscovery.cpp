@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <cassert>
 #ifndef NDEBUG
 # include <cstdio>
 #endif
@@ -42,12 +43,21 @@ typedef union cast {
 
 static _cast uuid_cast;
 
-static constexpr auto RECEIVE_TIME_OUT = 2800U;
+using namespace rdmdiscovery;
 
-RDMDiscovery::RDMDiscovery(const uint8_t *pUid) {
+RDMDiscovery::RDMDiscovery(const uint8_t *pUid, uint32_t nPorts): m_nPorts(nPorts) {
 	memcpy(m_Uid, pUid, RDM_UID_SIZE);
 	m_Message.SetSrcUid(pUid);
 
+	m_pContext = new Context[nPorts];
+	assert(m_pContext != nullptr);
+
+	for (uint32_t nPortIndex = 0; nPortIndex < nPorts; nPortIndex++) {
+		m_pContext[nPortIndex].pRDMTod = nullptr;
+		m_pContext[nPortIndex].state = State::IDLE;
+		m_pContext[nPortIndex].bTodChanged = false;
+	}
+
 #ifndef NDEBUG
 	printf("Uid : ");
 	PrintUid(m_Uid);
@@ -55,106 +65,222 @@ RDMDiscovery::RDMDiscovery(const uint8_t *pUid) {
 #endif
 }
 
-void RDMDiscovery::Full(uint32_t nPortIndex, RDMTod *pRDMTod){
-	m_nPortIndex = nPortIndex;
+RDMDiscovery::~RDMDiscovery() {
+	delete[] m_pContext;
+}
 
-	m_pRDMTod = pRDMTod;
-	m_pRDMTod->Reset();
+/**
+ * Blocking, used at start-up.
+ */
+void RDMDiscovery::Full(uint32_t nPortIndex, RDMTod *pRDMTod) {
+	Start(nPortIndex, pRDMTod, false);
 
-	Hardware::Get()->WatchdogFeed();
+	while (IsRunning(nPortIndex)) {
+		Hardware::Get()->WatchdogFeed();
+		Step(nPortIndex);
+	}
 
-	m_Message.SetDstUid(UID_ALL);
-	m_Message.SetCc(E120_DISCOVERY_COMMAND);
-	m_Message.SetPid(E120_DISC_UN_MUTE);
-	m_Message.SetPd(nullptr, 0);
-	m_Message.Send(m_nPortIndex);
-	m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT);
+	pRDMTod->Dump();
+}
 
-	Hardware::Get()->WatchdogFeed();
-	udelay(RECEIVE_TIME_OUT);
-	Hardware::Get()->WatchdogFeed();
+void RDMDiscovery::Start(uint32_t nPortIndex, RDMTod *pRDMTod, bool bIncremental) {
+	assert(nPortIndex < m_nPorts);
+	assert(pRDMTod != nullptr);
 
-	m_Message.Send(m_nPortIndex);
-	m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT);
+	auto& context = m_pContext[nPortIndex];
 
-	Hardware::Get()->WatchdogFeed();
-	udelay(RECEIVE_TIME_OUT);
-	Hardware::Get()->WatchdogFeed();
+	context.pRDMTod = pRDMTod;
+	context.nStackTop = 0;
+	context.nTodIndex = 0;
+	context.nUnMuteCount = 0;
+	context.nSentMicros = Hardware::Get()->Micros() - SPACING_MICROS;
 
-	FindDevices(0x000000000000, 0xfffffffffffe);
+	Push(nPortIndex, 0x000000000000, 0xfffffffffffe);
 
-	m_pRDMTod->Dump();
+	if (bIncremental) {
+		pRDMTod->UnMuteAll();
+		context.bTodChanged = false;
+		context.state = State::VERIFY;
+	} else {
+		pRDMTod->Reset();
+		context.bTodChanged = true;
+		context.state = State::UN_MUTE;
+	}
 }
 
-bool RDMDiscovery::FindDevices(uint64_t LowerBound, uint64_t UpperBound) {
-	struct TRdmMessage *pRdmMessage;
-	uint8_t uid[RDM_UID_SIZE];
-	auto bDeviceFound = false;
-	uint64_t MidPosition;
-
-	Hardware::Get()->WatchdogFeed();
-
-#ifndef NDEBUG
-	printf("FindDevices : ");
-	PrintUid(LowerBound);
-	printf(" - ");
-	PrintUid(UpperBound);
-	printf("\n");
-#endif
+void RDMDiscovery::Stop(uint32_t nPortIndex) {
+	assert(nPortIndex < m_nPorts);
+	m_pContext[nPortIndex].state = State::IDLE;
+}
 
-	if (LowerBound == UpperBound) {
-		memcpy(uid, ConvertUid(LowerBound), RDM_UID_SIZE);
+void RDMDiscovery::Run() {
+	for (uint32_t nPortIndex = 0; nPortIndex < m_nPorts; nPortIndex++) {
+		if (m_pContext[nPortIndex].state != State::IDLE) {
+			Step(nPortIndex);
+		}
+	}
+}
 
-		m_Message.SetCc(E120_DISCOVERY_COMMAND);
-		m_Message.SetPid(E120_DISC_MUTE);
-		m_Message.SetDstUid(uid);
-		m_Message.SetPd(nullptr, 0);
-		m_Message.Send(m_nPortIndex, 5800);
+void RDMDiscovery::Push(uint32_t nPortIndex, uint64_t nLower, uint64_t nUpper) {
+	auto& context = m_pContext[nPortIndex];
+	assert(context.nStackTop < STACK_SIZE);
 
-		pRdmMessage = reinterpret_cast<struct TRdmMessage*>(const_cast<uint8_t*>(m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT)));
+	context.Stack[context.nStackTop].nLower = nLower;
+	context.Stack[context.nStackTop].nUpper = nUpper;
+	context.nStackTop++;
+}
 
-		if (pRdmMessage != nullptr) {
-			if ((pRdmMessage->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(uid, pRdmMessage->source_uid, RDM_UID_SIZE) == 0)) {
-				m_pRDMTod->AddUid(uid);
-			}
-		} else {
-			return true;
-		}
-	} else {
-		memcpy(m_Pdl[0], ConvertUid(LowerBound), RDM_UID_SIZE);
-		memcpy(m_Pdl[1], ConvertUid(UpperBound), RDM_UID_SIZE);
+void RDMDiscovery::Send(uint32_t nPortIndex, uint16_t nPid, const uint8_t *pUid) {
+	m_Message.SetDstUid(pUid);
+	m_Message.SetCc(E120_DISCOVERY_COMMAND);
+	m_Message.SetPid(nPid);
 
-		m_Message.SetDstUid(UID_ALL);
-		m_Message.SetCc(E120_DISCOVERY_COMMAND);
-		m_Message.SetPid(E120_DISC_UNIQUE_BRANCH);
+	if (nPid == E120_DISC_UNIQUE_BRANCH) {
+		const auto& range = m_pContext[nPortIndex].Current;
+		memcpy(m_Pdl[0], ConvertUid(range.nLower), RDM_UID_SIZE);
+		memcpy(m_Pdl[1], ConvertUid(range.nUpper), RDM_UID_SIZE);
 		m_Message.SetPd(reinterpret_cast<const uint8_t*>(m_Pdl), 2 * RDM_UID_SIZE);
-		m_Message.Send(m_nPortIndex, 5800);
+	} else {
+		m_Message.SetPd(nullptr, 0);
+	}
 
-		pRdmMessage = reinterpret_cast<struct TRdmMessage*>(const_cast<uint8_t*>(m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT)));
+	m_Message.Send(nPortIndex);
 
-		if (pRdmMessage != nullptr) {
-			bDeviceFound = true;
+	m_pContext[nPortIndex].nSentMicros = Hardware::Get()->Micros();
+}
 
-			if (IsValidDiscoveryResponse(reinterpret_cast<const uint8_t*>(pRdmMessage), uid)) {
-				bDeviceFound = QuickFind(uid);
-			}
+void RDMDiscovery::Step(uint32_t nPortIndex) {
+	auto& context = m_pContext[nPortIndex];
+	const auto nElapsedMicros = Hardware::Get()->Micros() - context.nSentMicros;
+	const uint8_t *pResponse = nullptr;
+
+	switch (context.state) {
+	case State::UN_MUTE:
+	case State::VERIFY:
+	case State::UNIQUE_BRANCH:
+	case State::MUTE:
+		if (nElapsedMicros < SPACING_MICROS) {
+			return;
+		}
+		break;
+	case State::WAIT_UN_MUTE:
+	case State::WAIT_VERIFY:
+	case State::WAIT_UNIQUE_BRANCH:
+	case State::WAIT_MUTE:
+		pResponse = m_Message.Receive(nPortIndex);
+		if ((pResponse == nullptr) && (nElapsedMicros < RECEIVE_TIME_OUT_MICROS)) {
+			return;
+		}
+		break;
+	default:
+		break;
+	}
 
-			if (bDeviceFound) {
-				MidPosition = ((LowerBound & (0x0000800000000000 - 1)) + (UpperBound & (0x0000800000000000 - 1))) / 2
-						+ (UpperBound & (0x0000800000000000) ? 0x0000400000000000 : 0 )
-						+ (LowerBound & (0x0000800000000000) ? 0x0000400000000000 : 0 );
+	switch (context.state) {
+	case State::UN_MUTE:
+		Send(nPortIndex, E120_DISC_UN_MUTE, UID_ALL);
+		context.nUnMuteCount++;
+		context.state = State::WAIT_UN_MUTE;
+		break;
+	case State::WAIT_UN_MUTE:
+		if (pResponse == nullptr) {
+			context.state = context.nUnMuteCount < 2 ? State::UN_MUTE : State::NEXT_RANGE;
+		}
+		break;
+	case State::VERIFY:
+		if (context.nTodIndex < context.pRDMTod->GetUidCount()) {
+			context.pRDMTod->CopyUidEntry(context.nTodIndex, context.Uid);
+			Send(nPortIndex, E120_DISC_MUTE, context.Uid);
+			context.state = State::WAIT_VERIFY;
+		} else {
+			context.state = State::NEXT_RANGE;
+		}
+		break;
+	case State::WAIT_VERIFY:
+		if (pResponse != nullptr) {
+			context.pRDMTod->SetMuted(context.Uid, true);
+			context.nTodIndex++;
+		} else {
+#ifndef NDEBUG
+			printf("Lost : ");
+			PrintUid(context.Uid);
+			printf("\n");
+#endif
+			context.pRDMTod->Delete(context.Uid);
+			context.bTodChanged = true;
+		}
+		context.state = State::VERIFY;
+		break;
+	case State::NEXT_RANGE:
+		if (context.nStackTop == 0) {
+			context.state = State::IDLE;
+			break;
+		}
 
-				bDeviceFound = FindDevices(LowerBound, MidPosition);
-				bDeviceFound |= FindDevices(MidPosition + 1, UpperBound);
+		context.nStackTop--;
+		context.Current = context.Stack[context.nStackTop];
 
-				if (bDeviceFound) {
-					return true;
+		if (context.Current.nLower == context.Current.nUpper) {
+			memcpy(context.Uid, ConvertUid(context.Current.nLower), RDM_UID_SIZE);
+			context.bBranchAgain = false;
+			context.state = State::MUTE;
+		} else {
+			context.state = State::UNIQUE_BRANCH;
+		}
+		break;
+	case State::UNIQUE_BRANCH:
+#ifndef NDEBUG
+		printf("FindDevices : ");
+		PrintUid(context.Current.nLower);
+		printf(" - ");
+		PrintUid(context.Current.nUpper);
+		printf("\n");
+#endif
+		Send(nPortIndex, E120_DISC_UNIQUE_BRANCH, UID_ALL);
+		context.state = State::WAIT_UNIQUE_BRANCH;
+		break;
+	case State::WAIT_UNIQUE_BRANCH:
+		if (pResponse == nullptr) {
+			context.state = State::NEXT_RANGE;
+		} else if (IsValidDiscoveryResponse(pResponse, context.Uid)) {
+			context.bBranchAgain = true;
+			context.state = State::MUTE;
+		} else {
+			// Collision, split the range
+			const auto nLower = context.Current.nLower;
+			const auto nUpper = context.Current.nUpper;
+			const auto nMid = ((nLower & (0x0000800000000000 - 1)) + (nUpper & (0x0000800000000000 - 1))) / 2
+					+ (nUpper & (0x0000800000000000) ? 0x0000400000000000 : 0 )
+					+ (nLower & (0x0000800000000000) ? 0x0000400000000000 : 0 );
+
+			Push(nPortIndex, nMid + 1, nUpper);
+			Push(nPortIndex, nLower, nMid);
+			context.state = State::NEXT_RANGE;
+		}
+		break;
+	case State::MUTE:
+		Send(nPortIndex, E120_DISC_MUTE, context.Uid);
+		context.state = State::WAIT_MUTE;
+		break;
+	case State::WAIT_MUTE:
+		if (pResponse != nullptr) {
+			const auto *pRdmMessage = reinterpret_cast<const struct TRdmMessage*>(pResponse);
+
+			if ((pRdmMessage->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(context.Uid, pRdmMessage->source_uid, RDM_UID_SIZE) == 0)) {
+				if (context.pRDMTod->AddUid(context.Uid)) {
+					context.bTodChanged = true;
 				}
+				context.pRDMTod->SetMuted(context.Uid, true);
 			}
 		}
+		// Same range again, until there is no response or a collision
+		context.state = context.bBranchAgain ? State::UNIQUE_BRANCH : State::NEXT_RANGE;
+		break;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
 	}
-
-	return false;
 }
 
 const uint8_t *RDMDiscovery::ConvertUid(uint64_t nUid) {
@@ -217,53 +343,3 @@ bool RDMDiscovery::IsValidDiscoveryResponse(const uint8_t *pDiscResponse, uint8_
 
 	return bIsValid;
 }
-
-bool RDMDiscovery::QuickFind(const uint8_t *uid) {
-	uint8_t r_uid[RDM_UID_SIZE];
-
-	Hardware::Get()->WatchdogFeed();
-
-#ifndef NDEBUG
-	printf("QuickFind : ");
-	PrintUid(uid);
-	printf("\n");
-#endif
-
-	m_Message.SetCc(E120_DISCOVERY_COMMAND);
-	m_Message.SetPid(E120_DISC_MUTE);
-	m_Message.SetDstUid(uid);
-	m_Message.SetPd(nullptr, 0);
-	m_Message.Send(m_nPortIndex, 5800);
-
-	auto *pResponse = const_cast<uint8_t*>(m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT));
-
-	if (pResponse != nullptr) {
-		auto *pRdmMessage = reinterpret_cast<struct TRdmMessage*>(pResponse);
-#ifndef NDEBUG
-		RDMMessage::Print(pResponse);
-#endif
-		if ((pRdmMessage->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(uid, pRdmMessage->source_uid, RDM_UID_SIZE) == 0)) {
-			m_pRDMTod->AddUid(uid);
-		}
-	}
-
-	Hardware::Get()->WatchdogFeed();
-
-	m_Message.SetDstUid(UID_ALL);
-	m_Message.SetCc(E120_DISCOVERY_COMMAND);
-	m_Message.SetPid(E120_DISC_UNIQUE_BRANCH);
-	m_Message.SetPd(reinterpret_cast<const uint8_t*>(m_Pdl), 2 * RDM_UID_SIZE);
-	m_Message.Send(m_nPortIndex, 5800);
-
-	pResponse = const_cast<uint8_t *>(m_Message.ReceiveTimeOut(m_nPortIndex, RECEIVE_TIME_OUT));
-
-	Hardware::Get()->WatchdogFeed();
-
-	if ((pResponse != nullptr) && (IsValidDiscoveryResponse(pResponse, r_uid))) {
-		QuickFind(r_uid);
-	} else if ((pResponse != nullptr) && (!IsValidDiscoveryResponse(pResponse, r_uid))) {
-		return true;
-	}
-
-	return false;
-}
@@ -28,8 +28,17 @@
 
 #include "rgbpanelconst.h"
 
+/*
+ * Define CONFIG_RGBPANEL_BCM_PLANES (8..10) to use a binary-coded modulation
+ * framebuffer instead of the PWM slices. Plane n is displayed 2^n time units.
+ */
+
 namespace rgbpanel {
 static constexpr auto PWM_WIDTH = 84;
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+static constexpr uint32_t BCM_PLANES = CONFIG_RGBPANEL_BCM_PLANES;
+static_assert((BCM_PLANES >= 8) && (BCM_PLANES <= 10), "CONFIG_RGBPANEL_BCM_PLANES must be 8..10");
+#endif
 }  // namespace rgbpanel
 
 class RgbPanel {
@@ -43,6 +52,14 @@ public:
 	void Stop();
 
 	void SetPixel(uint32_t nColumn, uint32_t nRow, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
+	/**
+	 * pRGB : m_nColumns RGB triplets
+	 */
+	void SetRow(uint32_t nRow, const uint8_t *pRGB);
+	/**
+	 * pRGB : m_nRows rows of m_nColumns RGB triplets
+	 */
+	void SetFrame(const uint8_t *pRGB);
 	void Cls();
 	void Show();
 
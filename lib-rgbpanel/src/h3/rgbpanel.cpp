@@ -74,12 +74,29 @@ static volatile uint32_t s_nUpdatesCounter;
 //
 static uint32_t *s_pFramebuffer1 ;
 static uint32_t *s_pFramebuffer2 ;
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+static uint16_t *s_pTableBCM ;
+#else
 static uint8_t *s_pTablePWM ;
+#endif
 //
 static bool s_bIsCoreRunning;
 
 using namespace rgbpanel;
 
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+# if !defined (CONFIG_RGBPANEL_BCM_LSB_TICKS)
+#  define CONFIG_RGBPANEL_BCM_LSB_TICKS	4	// 24MHz ticks
+# endif
+static constexpr uint32_t BCM_LSB_TICKS = CONFIG_RGBPANEL_BCM_LSB_TICKS;
+
+static inline uint32_t get_ticks() {
+	uint64_t cval;
+	asm volatile("mrrc p15, 1, %Q0, %R0, c14" : "=r" (cval));
+	return static_cast<uint32_t>(cval);
+}
+#endif
+
 void RgbPanel::PlatformInit() {
 	h3_cpu_off(H3_CPU2);
 	h3_cpu_off(H3_CPU3);
@@ -127,7 +144,11 @@ void RgbPanel::PlatformInit() {
 	h3_gpio_clr(HUB75B_G2);
 	h3_gpio_clr(HUB75B_B2);
 
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+	s_nBufferSize = m_nColumns * (m_nRows / 2) * BCM_PLANES;
+#else
 	s_nBufferSize = m_nColumns * m_nRows * PWM_WIDTH;
+#endif
 	DEBUG_PRINTF("nBufferSize=%u", s_nBufferSize);
 
 	s_pFramebuffer1 = new uint32_t[s_nBufferSize];
@@ -143,18 +164,38 @@ void RgbPanel::PlatformInit() {
 		s_pFramebuffer2[i] = 0;
 	}
 
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+	s_pTableBCM = new uint16_t[256];
+	assert(s_pTableBCM != nullptr);
+
+	/*
+	 * With more than 8 planes the extra resolution is used for a gamma 2.0 curve.
+	 */
+	for (uint32_t i = 0; i < 256; i++) {
+		if (BCM_PLANES == 8) {
+			s_pTableBCM[i] = static_cast<uint16_t>(i);
+		} else {
+			s_pTableBCM[i] = static_cast<uint16_t>(((i * i) * ((1U << BCM_PLANES) - 1) + (255 * 255 / 2)) / (255 * 255));
+		}
+	}
+#else
 	s_pTablePWM = new uint8_t[256];
 	assert(s_pTablePWM != nullptr);
 
 	for (uint32_t i = 0; i < 256; i++) {
 		s_pTablePWM[i] = static_cast<uint8_t>((i * PWM_WIDTH) / 255);
 	}
+#endif
 }
 
 void RgbPanel::PlatformCleanUp() {
 	delete[] s_pFramebuffer1;
 	delete[] s_pFramebuffer2;
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+	delete[] s_pTableBCM;
+#else
 	delete[] s_pTablePWM;
+#endif
 }
 
 void RgbPanel::Start() {
@@ -224,6 +265,99 @@ uint32_t RgbPanel::GetUpdatesCounter() {
 	return s_nUpdatesCounter;
 }
 
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+/*
+ * Bit-plane layout: [row (m_nRows / 2)][plane][column]
+ * Each word holds the RGB bits of both halves of the panel.
+ */
+
+static constexpr uint32_t MASK_TOP = (1U << HUB75B_R1) | (1U << HUB75B_G1) | (1U << HUB75B_B1);
+static constexpr uint32_t MASK_BOTTOM = (1U << HUB75B_R2) | (1U << HUB75B_G2) | (1U << HUB75B_B2);
+
+static inline uint32_t bcm_bits_top(const uint32_t nRed, const uint32_t nGreen, const uint32_t nBlue, const uint32_t nPlane) {
+	return (((nRed >> nPlane) & 0x1) << HUB75B_R1) | (((nGreen >> nPlane) & 0x1) << HUB75B_G1) | (((nBlue >> nPlane) & 0x1) << HUB75B_B1);
+}
+
+static inline uint32_t bcm_bits_bottom(const uint32_t nRed, const uint32_t nGreen, const uint32_t nBlue, const uint32_t nPlane) {
+	return (((nRed >> nPlane) & 0x1) << HUB75B_R2) | (((nGreen >> nPlane) & 0x1) << HUB75B_G2) | (((nBlue >> nPlane) & 0x1) << HUB75B_B2);
+}
+
+static inline void bcm_set(uint32_t *pWord, const uint32_t nColumns, const uint32_t nRow, const uint32_t nHalf, const uint8_t *pRGB) {
+	const uint32_t nRed = s_pTableBCM[pRGB[0]];
+	const uint32_t nGreen = s_pTableBCM[pRGB[1]];
+	const uint32_t nBlue = s_pTableBCM[pRGB[2]];
+
+	if (nRow < nHalf) {
+		for (uint32_t nPlane = 0; nPlane < BCM_PLANES; nPlane++) {
+			*pWord = (*pWord & ~MASK_TOP) | bcm_bits_top(nRed, nGreen, nBlue, nPlane);
+			pWord += nColumns;
+		}
+	} else {
+		for (uint32_t nPlane = 0; nPlane < BCM_PLANES; nPlane++) {
+			*pWord = (*pWord & ~MASK_BOTTOM) | bcm_bits_bottom(nRed, nGreen, nBlue, nPlane);
+			pWord += nColumns;
+		}
+	}
+}
+
+void RgbPanel::SetPixel(uint32_t nColumn, uint32_t nRow, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
+	if (__builtin_expect(((nColumn >= m_nColumns) || (nRow >= m_nRows)), 0)) {
+		return;
+	}
+
+	const auto nHalf = m_nRows / 2;
+	const auto nPlaneRow = nRow < nHalf ? nRow : nRow - nHalf;
+	const uint8_t RGB[3] = { nRed, nGreen, nBlue };
+
+	bcm_set(&s_pFramebuffer1[(nPlaneRow * BCM_PLANES * m_nColumns) + nColumn], m_nColumns, nRow, nHalf, RGB);
+}
+
+void RgbPanel::SetRow(uint32_t nRow, const uint8_t *pRGB) {
+	if (__builtin_expect((nRow >= m_nRows), 0)) {
+		return;
+	}
+
+	const auto nHalf = m_nRows / 2;
+	const auto nPlaneRow = nRow < nHalf ? nRow : nRow - nHalf;
+	auto *pWord = &s_pFramebuffer1[nPlaneRow * BCM_PLANES * m_nColumns];
+
+	for (uint32_t nColumn = 0; nColumn < m_nColumns; nColumn++) {
+		bcm_set(pWord++, m_nColumns, nRow, nHalf, pRGB);
+		pRGB += 3;
+	}
+}
+
+/*
+ * Both halves are written at once, so there is no read-modify-write.
+ */
+void RgbPanel::SetFrame(const uint8_t *pRGB) {
+	const auto nHalf = m_nRows / 2;
+	const auto *pBottom = pRGB + (nHalf * m_nColumns * 3);
+	auto *pRowWord = s_pFramebuffer1;
+
+	for (uint32_t nRow = 0; nRow < nHalf; nRow++) {
+		for (uint32_t nColumn = 0; nColumn < m_nColumns; nColumn++) {
+			const uint32_t nRed1 = s_pTableBCM[pRGB[0]];
+			const uint32_t nGreen1 = s_pTableBCM[pRGB[1]];
+			const uint32_t nBlue1 = s_pTableBCM[pRGB[2]];
+			const uint32_t nRed2 = s_pTableBCM[pBottom[0]];
+			const uint32_t nGreen2 = s_pTableBCM[pBottom[1]];
+			const uint32_t nBlue2 = s_pTableBCM[pBottom[2]];
+			pRGB += 3;
+			pBottom += 3;
+
+			auto *pWord = &pRowWord[nColumn];
+
+			for (uint32_t nPlane = 0; nPlane < BCM_PLANES; nPlane++) {
+				*pWord = bcm_bits_top(nRed1, nGreen1, nBlue1, nPlane) | bcm_bits_bottom(nRed2, nGreen2, nBlue2, nPlane);
+				pWord += m_nColumns;
+			}
+		}
+
+		pRowWord += BCM_PLANES * m_nColumns;
+	}
+}
+#else
 void RgbPanel::SetPixel(uint32_t nColumn, uint32_t nRow, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
 	if (__builtin_expect(((nColumn >= m_nColumns) || (nRow >= m_nRows)), 0)) {
 		return;
@@ -281,6 +415,21 @@ void RgbPanel::SetPixel(uint32_t nColumn, uint32_t nRow, uint8_t nRed, uint8_t n
 	}
 }
 
+void RgbPanel::SetRow(uint32_t nRow, const uint8_t *pRGB) {
+	for (uint32_t nColumn = 0; nColumn < m_nColumns; nColumn++) {
+		SetPixel(nColumn, nRow, pRGB[0], pRGB[1], pRGB[2]);
+		pRGB += 3;
+	}
+}
+
+void RgbPanel::SetFrame(const uint8_t *pRGB) {
+	for (uint32_t nRow = 0; nRow < m_nRows; nRow++) {
+		SetRow(nRow, pRGB);
+		pRGB += m_nColumns * 3;
+	}
+}
+#endif
+
 void RgbPanel::Show() {
 	do {
 		dmb();
@@ -290,6 +439,86 @@ void RgbPanel::Show() {
 	s_nShowCounter++;
 }
 
+#if defined (CONFIG_RGBPANEL_BCM_PLANES)
+/*
+ * Plane n is enabled for BCM_LSB_TICKS << n. The next plane is shifted in while
+ * the current plane is displayed. When a plane is shorter than the shift time,
+ * the display is blanked before shifting, so the weights stay exact.
+ */
+void core1_task() {
+	const uint32_t nMultiplier = s_nColumns * BCM_PLANES;
+
+	uint32_t nGPIO = H3_PIO_PORTA->DAT & ~((1U << HUB75B_R1) | (1U << HUB75B_G1) | (1U << HUB75B_B1) | (1U << HUB75B_R2) | (1U << HUB75B_G2) | (1U << HUB75B_B2));
+	uint32_t nOnTicks = 0;
+	uint32_t nShiftTicks = 0;
+	uint32_t nStart = get_ticks();
+
+	for (;;) {
+		for (uint32_t nRow = 0; nRow < (s_nRows / 2); nRow++) {
+
+			const uint32_t nBaseIndex = nRow * nMultiplier;
+
+			for (uint32_t nPlane = 0; nPlane < BCM_PLANES; nPlane++) {
+
+				uint32_t nIndex = nBaseIndex + (nPlane * s_nColumns);
+				const auto nShiftStart = get_ticks();
+
+				/* Shift in next data */
+				for (uint32_t i = 0; i < s_nColumns; i++) {
+					const uint32_t nValue = s_pFramebuffer2[nIndex++];
+					// Clock high with data
+					H3_PIO_PORTA->DAT = nGPIO | (1U << HUB75B_CK) | nValue;
+					// Clock low
+					H3_PIO_PORTA->DAT = nGPIO | nValue;
+				}
+
+				nShiftTicks = get_ticks() - nShiftStart;
+
+				/* Display the previous plane for its weight */
+				while ((get_ticks() - nStart) < nOnTicks) {
+				}
+
+				/* Blank the display */
+				H3_PIO_PORTA->DAT = nGPIO | (1U << HUB75B_OE);
+
+				/* Latch the previous data */
+				H3_PIO_PORTA->DAT = nGPIO | (1U << HUB75B_LA) | (1U << HUB75B_OE);
+				nGPIO |= (1U << HUB75B_OE);
+				H3_PIO_PORTA->DAT = nGPIO;
+
+				/* Update the row select */
+				nGPIO &= ~(0xFU);
+				nGPIO |= nRow;
+				H3_PIO_PORTA->DAT = nGPIO;
+
+				/* Enable the display */
+				nGPIO &= ~(1U << HUB75B_OE);
+				H3_PIO_PORTA->DAT = nGPIO;
+				nStart = get_ticks();
+				nOnTicks = BCM_LSB_TICKS << nPlane;
+
+				if (nOnTicks < nShiftTicks) {
+					while ((get_ticks() - nStart) < nOnTicks) {
+					}
+					nGPIO |= (1U << HUB75B_OE);
+					H3_PIO_PORTA->DAT = nGPIO;
+					nOnTicks = 0;
+				}
+			}
+		}
+
+		s_nUpdatesCounter++;
+
+		if (s_bDoSwap) {
+			auto pTmp = s_pFramebuffer1;
+			s_pFramebuffer1 = s_pFramebuffer2;
+			s_pFramebuffer2 = pTmp;
+			dmb();
+			s_bDoSwap = false;
+		}
+	}
+}
+#else
 void core1_task() {
 	const uint32_t nMultiplier = s_nColumns * PWM_WIDTH;
 
@@ -343,3 +572,4 @@ void core1_task() {
 		}
 	}
 }
+#endif
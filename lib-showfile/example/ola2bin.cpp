@@ -0,0 +1,60 @@
+/**
+ * @file ola2bin.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "showfileconvert.h"
+#include "showfilebinary.h"
+
+int main(int argc, char **argv) {
+	if ((argc < 3) || (argc > 4)) {
+		printf("Usage: %s <ola showfile> <binary showfile> [index interval ms]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	uint32_t nIndexIntervalMillis = showfile::binary::INDEX_INTERVAL_MILLIS;
+
+	if (argc == 4) {
+		const auto nValue = strtoul(argv[3], nullptr, 10);
+
+		if ((nValue == 0) || (nValue > UINT32_MAX)) {
+			printf("Invalid index interval: %s\n", argv[3]);
+			return EXIT_FAILURE;
+		}
+
+		nIndexIntervalMillis = static_cast<uint32_t>(nValue);
+	}
+
+	ShowFileConvert convert;
+
+	if (!convert.OlaToBinary(argv[1], argv[2], nIndexIntervalMillis)) {
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file binaryshowfile.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINARYSHOWFILE_H_
+#define BINARYSHOWFILE_H_
+
+#include <cstdint>
+#include <cstdio>
+
+#include "showfile.h"
+#include "showfilebinary.h"
+
+#include "debug.h"
+
+/**
+ * Plays the binary showfile format, see showfilebinary.h
+ * The file is memory mapped on Linux, otherwise it is read frame by frame.
+ */
+class BinaryShowFile final: public ShowFile {
+public:
+	BinaryShowFile() {
+		DEBUG1_ENTRY
+
+		DEBUG1_EXIT
+	}
+
+	~BinaryShowFile() override {
+		ShowFileClose();
+	}
+
+	void ShowFileStart() override;
+
+	void ShowFileStop() override;
+	void ShowFileResume() override;
+	void ShowFileRun() override;
+	void ShowFilePrint() override;
+
+	void ShowFileOpen() override;
+	void ShowFileClose() override;
+	bool ShowFileGoto(uint32_t nMillis) override;
+
+private:
+	bool Read(uint32_t nOffset, void *pBuffer, uint32_t nSize);
+	const uint8_t *NextFrame();
+	void ApplyFrame(const uint8_t *pFrame, bool bOutput);
+	void Rewind();
+
+private:
+	showfile::binary::Header m_Header;
+	showfile::binary::Index *m_pIndex { nullptr };
+	uint16_t *m_pUniverses { nullptr };
+	uint16_t *m_pLength { nullptr };
+	uint8_t *m_pDmxData { nullptr };
+#if defined (__linux__) || defined (__APPLE__)
+	uint8_t *m_pMap { nullptr };
+	uint32_t m_nMapSize { 0 };
+#else
+	uint8_t *m_pFrameBuffer { nullptr };
+	uint32_t m_nFilePosition { 0 };
+#endif
+	const uint8_t *m_pFrame { nullptr };
+	uint32_t m_nOffset { 0 };
+	uint32_t m_nStartMillis { 0 };
+	uint32_t m_nElapsedMillis { 0 };
+	uint64_t m_nTouched { 0 };
+	bool m_bValid { false };
+};
+
+#endif /* BINARYSHOWFILE_H_ */
@@ -40,7 +40,7 @@ enum class Status {
 };
 
 enum class Formats {
-	OLA, DUMMY, UNDEFINED
+	OLA, DUMMY, BINARY, UNDEFINED
 };
 
 enum class Protocols {
@@ -98,6 +98,18 @@ public:
 		DEBUG_EXIT
 	}
 
+	/**
+	 * Continue the running show at nMillis from the start of the show.
+	 * Only supported by the formats with a seek index.
+	 */
+	bool Goto(uint32_t nMillis) {
+		if (m_pShowFile != nullptr) {
+			return ShowFileGoto(nMillis);
+		}
+
+		return false;
+	}
+
 	void Run() {
 		if (m_Status == showfile::Status::RUNNING) {
 			ShowFileRun();
@@ -199,6 +211,13 @@ protected:
 	virtual void ShowFileRun()=0;
 	virtual void ShowFilePrint()=0;
 
+	// Called after the show file is opened and before it is closed
+	virtual void ShowFileOpen() {}
+	virtual void ShowFileClose() {}
+	virtual bool ShowFileGoto(__attribute__((unused)) uint32_t nMillis) {
+		return false;
+	}
+
 protected:
 	uint32_t m_nShowFileNumber { showfile::File::MAX_NUMBER + 1 };
 	bool m_bDoLoop { false };
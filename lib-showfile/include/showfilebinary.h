@@ -0,0 +1,95 @@
+/**
+ * @file showfilebinary.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILEBINARY_H_
+#define SHOWFILEBINARY_H_
+
+#include <cstdint>
+
+/*
+ * Binary showfile, all fields are little endian.
+ *
+ * Header
+ * Frame[nFrames]          at nDataOffset
+ * uint16_t [nUniverses]   at nUniverseOffset, the universe table
+ * Index[nIndexEntries]    at nIndexOffset
+ *
+ * A frame holds the records sent at nTimestampMillis, followed by a sync.
+ * A record holds the runs of slots changed since the previous record of the same universe.
+ * The frame of an index entry is a key frame, it holds a record with all slots
+ * of every universe seen so far. The delta reference is reset there as well.
+ * Playback can start at any index entry.
+ */
+
+namespace showfile {
+namespace binary {
+static constexpr char MAGIC[] = "ShowBin";
+static constexpr uint16_t VERSION = 2;
+static constexpr uint32_t MAX_UNIVERSES = 64;
+static constexpr uint32_t INDEX_INTERVAL_MILLIS = 1000;
+static constexpr uint32_t DMX_LENGTH = 512;
+
+struct Header {
+	char Magic[8];
+	uint16_t nVersion;
+	uint16_t nUniverses;
+	uint32_t nFrames;
+	uint32_t nDurationMillis;	///< Including the delay after the last frame
+	uint32_t nFrameSizeMax;
+	uint32_t nIndexIntervalMillis;
+	uint32_t nIndexEntries;
+	uint32_t nDataOffset;
+	uint32_t nUniverseOffset;
+	uint32_t nIndexOffset;
+} __attribute__((packed));
+
+struct Frame {
+	uint32_t nTimestampMillis;
+	uint32_t nSize;				///< Including this header
+	uint16_t nRecords;
+	uint16_t nReserved;
+} __attribute__((packed));
+
+struct Record {
+	uint16_t nUniverseIndex;
+	uint16_t nLength;			///< The number of slots of the universe
+	uint16_t nRuns;				///< 0 -> unchanged
+} __attribute__((packed));
+
+struct Run {
+	uint16_t nOffset;
+	uint16_t nCount;			///< Followed by nCount slots
+} __attribute__((packed));
+
+struct Index {
+	uint32_t nTimestampMillis;
+	uint32_t nOffset;			///< Offset of the Frame
+} __attribute__((packed));
+
+static constexpr uint32_t FRAME_SIZE_MAX = sizeof(struct Frame) + MAX_UNIVERSES * (sizeof(struct Record) + sizeof(struct Run) + DMX_LENGTH);
+}  // namespace binary
+}  // namespace showfile
+
+#endif /* SHOWFILEBINARY_H_ */
@@ -0,0 +1,74 @@
+/**
+ * @file showfileconvert.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SHOWFILECONVERT_H_
+#define SHOWFILECONVERT_H_
+
+#include <cstdint>
+#include <cstdio>
+
+#include "showfilebinary.h"
+
+/**
+ * Converts an OLA showfile into the binary showfile format.
+ * Linux only, the bare-metal file API supports one open file only.
+ */
+class ShowFileConvert {
+public:
+	ShowFileConvert() {}
+	~ShowFileConvert() {
+		delete[] m_pIndex;
+	}
+
+	bool OlaToBinary(const char *pSource, const char *pDestination, uint32_t nIndexIntervalMillis = showfile::binary::INDEX_INTERVAL_MILLIS);
+
+private:
+	bool ParseDmxData(const char *pLine, uint32_t& nLength);
+	bool AddRecord(uint16_t nUniverse, uint32_t nLength);
+	bool AddIndex(uint32_t nOffset);
+	bool AddKeyRecords();
+	bool WriteFrame();
+
+private:
+	FILE *m_pDestination { nullptr };
+	showfile::binary::Header m_Header;
+	showfile::binary::Index *m_pIndex { nullptr };
+	uint32_t m_nIndexSize { 0 };
+	uint32_t m_nNextIndexMillis { 0 };
+	uint32_t m_nTimestampMillis { 0 };
+	uint32_t m_nOffset { 0 };
+	uint32_t m_nFrameSize { 0 };
+	uint32_t m_nRecords { 0 };
+	bool m_bKeyFrame { false };
+	uint16_t m_aUniverses[showfile::binary::MAX_UNIVERSES];
+	bool m_aReference[showfile::binary::MAX_UNIVERSES];
+	uint16_t m_aLength[showfile::binary::MAX_UNIVERSES];
+	uint8_t m_aPrevious[showfile::binary::MAX_UNIVERSES][showfile::binary::DMX_LENGTH];
+	uint8_t m_aDmxData[showfile::binary::DMX_LENGTH];
+	uint8_t m_aFrame[showfile::binary::FRAME_SIZE_MAX];
+	char m_aLine[4096];
+};
+
+#endif /* SHOWFILECONVERT_H_ */
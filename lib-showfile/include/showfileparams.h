@@ -42,12 +42,15 @@ struct Params {
 	uint16_t nUniverse;
 	uint8_t nDisableUnicast;
 	uint8_t nDmxMaster;
+	uint16_t nArtNetKeepAlive;
 } __attribute__((packed));
 
 struct Options {
 	static constexpr auto AUTO_START = (1U << 0);
 	static constexpr auto LOOP = (1U << 1);
 	static constexpr auto DISABLE_SYNC = (1U << 2);
+	static constexpr auto ARTNET_LENGTH_EXACT = (1U << 3);
+	static constexpr auto ARTNET_CHANGED_ONLY = (1U << 4);
 };
 
 struct Mask {
@@ -60,6 +63,7 @@ struct Mask {
 	static constexpr auto SACN_UNIVERSE = (1U << 6);
 	static constexpr auto ARTNET_UNICAST_DISABLED = (1U << 7);
 	static constexpr auto DMX_MASTER = (1U << 8);
+	static constexpr auto ARTNET_KEEP_ALIVE = (1U << 9);
 };
 }  // namespace showfileparams
 
@@ -41,6 +41,9 @@ struct ShowFileParamsConst {
 	static  const char PROTOCOL[];
 	static  const char SACN_SYNC_UNIVERSE[];
 	static  const char ARTNET_DISABLE_UNICAST[];
+	static  const char ARTNET_LENGTH_EXACT[];
+	static  const char ARTNET_CHANGED_ONLY[];
+	static  const char ARTNET_KEEP_ALIVE[];
 };
 
 #endif /* SHOWFILEPARAMSCONST_H_ */
@@ -0,0 +1,427 @@
+/**
+ * @file binaryshowfile.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#if defined (__linux__) || defined (__APPLE__)
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+#include <cassert>
+
+#include "binaryshowfile.h"
+#include "showfile.h"
+#include "showfilebinary.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+using namespace showfile::binary;
+
+static_assert(MAX_UNIVERSES <= 64, "m_nTouched is a 64-bit mask");
+
+void BinaryShowFile::ShowFileOpen() {
+	DEBUG_ENTRY
+
+	assert(m_pShowFile != nullptr);
+	assert(!m_bValid);
+
+#if defined (__linux__) || defined (__APPLE__)
+	struct stat st;
+
+	if ((fstat(fileno(m_pShowFile), &st) != 0) || (st.st_size < static_cast<off_t>(sizeof(struct Header))) || (st.st_size > static_cast<off_t>(UINT32_MAX))) {
+		DEBUG_EXIT
+		return;
+	}
+
+	m_nMapSize = static_cast<uint32_t>(st.st_size);
+
+	auto *pMap = mmap(nullptr, m_nMapSize, PROT_READ, MAP_PRIVATE, fileno(m_pShowFile), 0);
+
+	if (pMap == MAP_FAILED) {
+		perror("mmap");
+		m_nMapSize = 0;
+		DEBUG_EXIT
+		return;
+	}
+
+	m_pMap = reinterpret_cast<uint8_t *>(pMap);
+#else
+	m_nFilePosition = UINT32_MAX;
+#endif
+
+	if (!Read(0, &m_Header, sizeof(struct Header))) {
+		ShowFileClose();
+		DEBUG_EXIT
+		return;
+	}
+
+	if ((memcmp(m_Header.Magic, MAGIC, sizeof(MAGIC)) != 0)
+			|| (m_Header.nVersion != VERSION)
+			|| (m_Header.nUniverses == 0) || (m_Header.nUniverses > MAX_UNIVERSES)
+			|| (m_Header.nFrameSizeMax < sizeof(struct Frame)) || (m_Header.nFrameSizeMax > FRAME_SIZE_MAX)
+			|| (m_Header.nDataOffset < sizeof(struct Header)) || (m_Header.nUniverseOffset < m_Header.nDataOffset)) {
+		puts("Not a valid binary showfile");
+		ShowFileClose();
+		DEBUG_EXIT
+		return;
+	}
+
+	m_pUniverses = new uint16_t[m_Header.nUniverses];
+	assert(m_pUniverses != nullptr);
+
+	m_pLength = new uint16_t[m_Header.nUniverses];
+	assert(m_pLength != nullptr);
+
+	m_pDmxData = new uint8_t[m_Header.nUniverses * DMX_LENGTH];
+	assert(m_pDmxData != nullptr);
+
+	if (m_Header.nIndexEntries != 0) {
+		m_pIndex = new struct Index[m_Header.nIndexEntries];
+		assert(m_pIndex != nullptr);
+	}
+
+#if !(defined (__linux__) || defined (__APPLE__))
+	m_pFrameBuffer = new uint8_t[m_Header.nFrameSizeMax];
+	assert(m_pFrameBuffer != nullptr);
+#endif
+
+	if (!Read(m_Header.nUniverseOffset, m_pUniverses, m_Header.nUniverses * static_cast<uint32_t>(sizeof(uint16_t)))
+			|| ((m_pIndex != nullptr) && !Read(m_Header.nIndexOffset, m_pIndex, m_Header.nIndexEntries * static_cast<uint32_t>(sizeof(struct Index))))) {
+		puts("Binary showfile is truncated");
+		ShowFileClose();
+		DEBUG_EXIT
+		return;
+	}
+
+	memset(m_pLength, 0, m_Header.nUniverses * sizeof(uint16_t));
+	memset(m_pDmxData, 0, m_Header.nUniverses * DMX_LENGTH);
+
+	m_bValid = true;
+
+	Rewind();
+
+	DEBUG_PRINTF("nUniverses=%u, nFrames=%u, nIndexEntries=%u", m_Header.nUniverses, m_Header.nFrames, m_Header.nIndexEntries);
+	DEBUG_EXIT
+}
+
+void BinaryShowFile::ShowFileClose() {
+	DEBUG_ENTRY
+
+	m_bValid = false;
+	m_pFrame = nullptr;
+
+	delete[] m_pIndex;
+	m_pIndex = nullptr;
+
+	delete[] m_pUniverses;
+	m_pUniverses = nullptr;
+
+	delete[] m_pLength;
+	m_pLength = nullptr;
+
+	delete[] m_pDmxData;
+	m_pDmxData = nullptr;
+
+#if defined (__linux__) || defined (__APPLE__)
+	if (m_pMap != nullptr) {
+		munmap(m_pMap, m_nMapSize);
+		m_pMap = nullptr;
+		m_nMapSize = 0;
+	}
+#else
+	delete[] m_pFrameBuffer;
+	m_pFrameBuffer = nullptr;
+#endif
+
+	DEBUG_EXIT
+}
+
+bool BinaryShowFile::Read(uint32_t nOffset, void *pBuffer, uint32_t nSize) {
+#if defined (__linux__) || defined (__APPLE__)
+	if ((nOffset > m_nMapSize) || (nSize > (m_nMapSize - nOffset))) {
+		return false;
+	}
+
+	memcpy(pBuffer, &m_pMap[nOffset], nSize);
+	return true;
+#else
+	if (nOffset != m_nFilePosition) {
+		if (fseek(m_pShowFile, static_cast<long>(nOffset), SEEK_SET) != 0) {
+			m_nFilePosition = UINT32_MAX;
+			return false;
+		}
+	}
+
+	if (fread(pBuffer, 1, nSize, m_pShowFile) != nSize) {
+		m_nFilePosition = UINT32_MAX;
+		return false;
+	}
+
+	m_nFilePosition = nOffset + nSize;
+	return true;
+#endif
+}
+
+/**
+ * Returns the frame at m_nOffset, nullptr at the end of the show.
+ */
+const uint8_t *BinaryShowFile::NextFrame() {
+	if (m_nOffset >= m_Header.nUniverseOffset) {
+		return nullptr;
+	}
+
+#if defined (__linux__) || defined (__APPLE__)
+	if ((m_Header.nUniverseOffset - m_nOffset) < sizeof(struct Frame)) {
+		m_bValid = false;
+		return nullptr;
+	}
+
+	const auto *pData = &m_pMap[m_nOffset];
+	const auto nSize = reinterpret_cast<const struct Frame *>(pData)->nSize;
+#else
+	auto *pData = m_pFrameBuffer;
+
+	if (!Read(m_nOffset, pData, sizeof(struct Frame))) {
+		m_bValid = false;
+		return nullptr;
+	}
+
+	const auto nSize = reinterpret_cast<const struct Frame *>(pData)->nSize;
+#endif
+
+	if ((nSize < sizeof(struct Frame)) || (nSize > m_Header.nFrameSizeMax) || (nSize > (m_Header.nUniverseOffset - m_nOffset))) {
+		m_bValid = false;
+		return nullptr;
+	}
+
+#if !(defined (__linux__) || defined (__APPLE__))
+	if (!Read(m_nOffset + static_cast<uint32_t>(sizeof(struct Frame)), &pData[sizeof(struct Frame)], nSize - static_cast<uint32_t>(sizeof(struct Frame)))) {
+		m_bValid = false;
+		return nullptr;
+	}
+#endif
+
+	m_nOffset += nSize;
+
+	return pData;
+}
+
+void BinaryShowFile::ApplyFrame(const uint8_t *pData, bool bOutput) {
+	const auto *pFrame = reinterpret_cast<const struct Frame *>(pData);
+	const auto *pEnd = pData + pFrame->nSize;
+	const auto *p = pData + sizeof(struct Frame);
+
+	for (uint32_t nRecord = 0; nRecord < pFrame->nRecords; nRecord++) {
+		if (static_cast<uint32_t>(pEnd - p) < sizeof(struct Record)) {
+			m_bValid = false;
+			return;
+		}
+
+		const auto *pRecord = reinterpret_cast<const struct Record *>(p);
+		p += sizeof(struct Record);
+
+		const uint32_t nIndex = pRecord->nUniverseIndex;
+		const uint32_t nLength = pRecord->nLength;
+
+		if ((nIndex >= m_Header.nUniverses) || (nLength > DMX_LENGTH)) {
+			m_bValid = false;
+			return;
+		}
+
+		auto *pDmxData = &m_pDmxData[nIndex * DMX_LENGTH];
+
+		for (uint32_t nRun = 0; nRun < pRecord->nRuns; nRun++) {
+			if (static_cast<uint32_t>(pEnd - p) < sizeof(struct Run)) {
+				m_bValid = false;
+				return;
+			}
+
+			const auto *pRun = reinterpret_cast<const struct Run *>(p);
+			p += sizeof(struct Run);
+
+			const uint32_t nOffset = pRun->nOffset;
+			const uint32_t nCount = pRun->nCount;
+
+			if (((nOffset + nCount) > nLength) || (static_cast<uint32_t>(pEnd - p) < nCount)) {
+				m_bValid = false;
+				return;
+			}
+
+			memcpy(&pDmxData[nOffset], p, nCount);
+			p += nCount;
+		}
+
+		m_pLength[nIndex] = static_cast<uint16_t>(nLength);
+		m_nTouched |= (static_cast<uint64_t>(1) << nIndex);
+
+		if (bOutput && (nLength != 0)) {
+			m_pShowFileProtocolHandler->DmxOut(m_pUniverses[nIndex], pDmxData, nLength);
+		}
+	}
+
+	if (bOutput && (pFrame->nRecords != 0)) {
+		m_pShowFileProtocolHandler->DmxSync();
+	}
+}
+
+void BinaryShowFile::Rewind() {
+	m_nOffset = m_Header.nDataOffset;
+	m_pFrame = NextFrame();
+}
+
+void BinaryShowFile::ShowFileStart() {
+	DEBUG_ENTRY
+
+	if (m_bValid) {
+		Rewind();
+	}
+
+	m_nStartMillis = Hardware::Get()->Millis();
+	m_nElapsedMillis = 0;
+
+	DEBUG_EXIT
+}
+
+void BinaryShowFile::ShowFileStop() {
+	DEBUG_ENTRY
+
+	m_nElapsedMillis = Hardware::Get()->Millis() - m_nStartMillis;
+
+	DEBUG_EXIT
+}
+
+void BinaryShowFile::ShowFileResume() {
+	DEBUG_ENTRY
+
+	m_nStartMillis = Hardware::Get()->Millis() - m_nElapsedMillis;
+
+	DEBUG_EXIT
+}
+
+void BinaryShowFile::ShowFileRun() {
+	if (__builtin_expect((!m_bValid), 0)) {
+		SetStatus(showfile::Status::ENDED);
+		return;
+	}
+
+	const auto nElapsedMillis = Hardware::Get()->Millis() - m_nStartMillis;
+
+	if (m_pFrame == nullptr) {
+		if (nElapsedMillis < m_Header.nDurationMillis) {
+			return;
+		}
+
+		if (m_bDoLoop) {
+			m_nStartMillis += m_Header.nDurationMillis;
+			Rewind();
+		} else {
+			SetStatus(showfile::Status::ENDED);
+		}
+
+		return;
+	}
+
+	if (nElapsedMillis < reinterpret_cast<const struct Frame *>(m_pFrame)->nTimestampMillis) {
+		return;
+	}
+
+	ApplyFrame(m_pFrame, true);
+
+	m_pFrame = NextFrame();
+}
+
+/**
+ * Continues at the last index entry before nMillis, the frames up to nMillis are
+ * decoded without output. The key frame of the index entry holds every universe,
+ * so all universes are sent once with their state at nMillis.
+ */
+bool BinaryShowFile::ShowFileGoto(uint32_t nMillis) {
+	DEBUG_ENTRY
+	DEBUG_PRINTF("nMillis=%u", nMillis);
+
+	if (!m_bValid || (m_pIndex == nullptr) || (nMillis >= m_Header.nDurationMillis)) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	uint32_t nLow = 0;
+	uint32_t nHigh = m_Header.nIndexEntries;
+
+	while (nLow < nHigh) {
+		const auto nMid = nLow + ((nHigh - nLow) / 2);
+
+		if (m_pIndex[nMid].nTimestampMillis <= nMillis) {
+			nLow = nMid + 1;
+		} else {
+			nHigh = nMid;
+		}
+	}
+
+	const auto nEntry = (nLow == 0) ? 0 : nLow - 1;
+
+	m_nOffset = m_pIndex[nEntry].nOffset;
+	m_nTouched = 0;
+	m_pFrame = NextFrame();
+
+	while ((m_pFrame != nullptr) && (reinterpret_cast<const struct Frame *>(m_pFrame)->nTimestampMillis < nMillis)) {
+		ApplyFrame(m_pFrame, false);
+		m_pFrame = NextFrame();
+	}
+
+	if (!m_bValid) {
+		DEBUG_EXIT
+		return false;
+	}
+
+	for (uint32_t nIndex = 0; nIndex < m_Header.nUniverses; nIndex++) {
+		if (((m_nTouched >> nIndex) & 0x1) && (m_pLength[nIndex] != 0)) {
+			m_pShowFileProtocolHandler->DmxOut(m_pUniverses[nIndex], &m_pDmxData[nIndex * DMX_LENGTH], m_pLength[nIndex]);
+		}
+	}
+
+	if (m_nTouched != 0) {
+		m_pShowFileProtocolHandler->DmxSync();
+	}
+
+	m_nStartMillis = Hardware::Get()->Millis() - nMillis;
+	m_nElapsedMillis = nMillis;
+
+	DEBUG_EXIT
+	return true;
+}
+
+void BinaryShowFile::ShowFilePrint() {
+	puts("BinaryShowFile");
+
+	if (m_bValid) {
+		printf(" Universes : %u\n", m_Header.nUniverses);
+		printf(" Frames    : %u\n", m_Header.nFrames);
+		printf(" Duration  : %u ms\n", m_Header.nDurationMillis);
+		printf(" Index     : %u entries, every %u ms\n", m_Header.nIndexEntries, m_Header.nIndexIntervalMillis);
+	}
+}
@@ -0,0 +1,364 @@
+/**
+ * @file showfileconvert.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cctype>
+#include <cassert>
+
+#include "showfileconvert.h"
+#include "showfilebinary.h"
+
+#include "debug.h"
+
+using namespace showfile::binary;
+
+/**
+ * Equal slots in between two changed slots are included in the run,
+ * when this is smaller than starting a new run.
+ */
+static constexpr uint32_t RUN_MERGE_GAP = sizeof(struct Run);
+
+bool ShowFileConvert::OlaToBinary(const char *pSource, const char *pDestination, uint32_t nIndexIntervalMillis) {
+	DEBUG_ENTRY
+	assert(pSource != nullptr);
+	assert(pDestination != nullptr);
+
+	auto *pFile = fopen(pSource, "r");
+
+	if (pFile == nullptr) {
+		perror(pSource);
+		DEBUG_EXIT
+		return false;
+	}
+
+	m_pDestination = fopen(pDestination, "wb");
+
+	if (m_pDestination == nullptr) {
+		perror(pDestination);
+		fclose(pFile);
+		DEBUG_EXIT
+		return false;
+	}
+
+	memset(&m_Header, 0, sizeof(struct Header));
+	memcpy(m_Header.Magic, MAGIC, sizeof(MAGIC));
+	m_Header.nVersion = VERSION;
+	m_Header.nIndexIntervalMillis = (nIndexIntervalMillis == 0) ? INDEX_INTERVAL_MILLIS : nIndexIntervalMillis;
+	m_Header.nDataOffset = sizeof(struct Header);
+
+	m_nNextIndexMillis = 0;
+	m_nTimestampMillis = 0;
+	m_nOffset = m_Header.nDataOffset;
+	m_nFrameSize = sizeof(struct Frame);
+	m_nRecords = 0;
+	m_bKeyFrame = false;
+
+	auto bResult = (fwrite(&m_Header, sizeof(struct Header), 1, m_pDestination) == 1);
+
+	while (bResult && (fgets(m_aLine, sizeof(m_aLine), pFile) == m_aLine)) {
+		if (isdigit(m_aLine[0]) == 0) {
+			continue;
+		}
+
+		const char *p = m_aLine;
+		uint32_t k = 0;
+
+		while (isdigit(*p)) {
+			k = k * 10 + static_cast<uint32_t>(*p - '0');
+
+			if (k > UINT16_MAX) {
+				break;
+			}
+
+			p++;
+		}
+
+		if (k > UINT16_MAX) {
+			bResult = false;
+			break;
+		}
+
+		if (*p == ' ') {
+			uint32_t nLength;
+			bResult = ParseDmxData(p + 1, nLength) && AddRecord(static_cast<uint16_t>(k), nLength);
+		} else {
+			bResult = WriteFrame();
+			m_nTimestampMillis += k;
+		}
+	}
+
+	bResult = bResult && WriteFrame();
+
+	m_Header.nDurationMillis = m_nTimestampMillis;
+	m_Header.nUniverseOffset = m_nOffset;
+	m_Header.nIndexOffset = m_Header.nUniverseOffset + m_Header.nUniverses * static_cast<uint32_t>(sizeof(uint16_t));
+
+	bResult = bResult
+			&& (fwrite(m_aUniverses, sizeof(uint16_t), m_Header.nUniverses, m_pDestination) == m_Header.nUniverses)
+			&& (fwrite(m_pIndex, sizeof(struct Index), m_Header.nIndexEntries, m_pDestination) == m_Header.nIndexEntries)
+			&& (fseek(m_pDestination, 0L, SEEK_SET) == 0)
+			&& (fwrite(&m_Header, sizeof(struct Header), 1, m_pDestination) == 1);
+
+	fclose(pFile);
+
+	if (fclose(m_pDestination) != 0) {
+		bResult = false;
+	}
+
+	m_pDestination = nullptr;
+
+	printf("%s -> %s: %u universes, %u frames, %u ms, %u index entries%s\n", pSource, pDestination, m_Header.nUniverses, m_Header.nFrames, m_Header.nDurationMillis, m_Header.nIndexEntries, bResult ? "" : " [Failed]");
+
+	DEBUG_EXIT
+	return bResult;
+}
+
+bool ShowFileConvert::ParseDmxData(const char *pLine, uint32_t& nLength) {
+	const char *p = pLine;
+	nLength = 0;
+
+	while (isdigit(*p)) {
+		uint32_t k = 0;
+
+		while (isdigit(*p)) {
+			k = k * 10 + static_cast<uint32_t>(*p - '0');
+
+			if (k > 255) {
+				return false;
+			}
+
+			p++;
+		}
+
+		if (nLength == DMX_LENGTH) {
+			return false;
+		}
+
+		m_aDmxData[nLength++] = static_cast<uint8_t>(k);
+
+		if (*p == ',') {
+			p++;
+		}
+	}
+
+	return true;
+}
+
+bool ShowFileConvert::AddIndex(uint32_t nOffset) {
+	if (m_Header.nIndexEntries == m_nIndexSize) {
+		const auto nIndexSize = (m_nIndexSize == 0) ? 64 : 2 * m_nIndexSize;
+		auto *pIndex = new struct Index[nIndexSize];
+		assert(pIndex != nullptr);
+
+		if (m_pIndex != nullptr) {
+			memcpy(pIndex, m_pIndex, m_nIndexSize * sizeof(struct Index));
+			delete[] m_pIndex;
+		}
+
+		m_pIndex = pIndex;
+		m_nIndexSize = nIndexSize;
+	}
+
+	m_pIndex[m_Header.nIndexEntries].nTimestampMillis = m_nTimestampMillis;
+	m_pIndex[m_Header.nIndexEntries].nOffset = nOffset;
+	m_Header.nIndexEntries++;
+
+	// The first record of each universe after an index entry holds all slots
+	memset(m_aReference, 0, sizeof(m_aReference));
+	m_bKeyFrame = true;
+
+	while (m_nNextIndexMillis <= m_nTimestampMillis) {
+		m_nNextIndexMillis += m_Header.nIndexIntervalMillis;
+	}
+
+	return true;
+}
+
+bool ShowFileConvert::AddRecord(uint16_t nUniverse, uint32_t nLength) {
+	if ((m_nRecords == 0) && (m_nTimestampMillis >= m_nNextIndexMillis)) {
+		AddIndex(m_nOffset);
+	}
+
+	uint32_t nIndex = 0;
+
+	while ((nIndex < m_Header.nUniverses) && (m_aUniverses[nIndex] != nUniverse)) {
+		nIndex++;
+	}
+
+	if (nIndex == m_Header.nUniverses) {
+		if (nIndex == MAX_UNIVERSES) {
+			printf("More than %u universes\n", MAX_UNIVERSES);
+			return false;
+		}
+
+		m_aUniverses[nIndex] = nUniverse;
+		m_aReference[nIndex] = false;
+		m_Header.nUniverses++;
+	}
+
+	if ((m_nFrameSize + sizeof(struct Record) + sizeof(struct Run) + nLength) > sizeof(m_aFrame)) {
+		printf("Frame at %u ms is too large\n", m_nTimestampMillis);
+		return false;
+	}
+
+	auto *pRecord = reinterpret_cast<struct Record *>(&m_aFrame[m_nFrameSize]);
+	pRecord->nUniverseIndex = static_cast<uint16_t>(nIndex);
+	pRecord->nLength = static_cast<uint16_t>(nLength);
+	pRecord->nRuns = 0;
+
+	m_nFrameSize += static_cast<uint32_t>(sizeof(struct Record));
+
+	const auto nRecordDataStart = m_nFrameSize;
+	auto *pPrevious = m_aPrevious[nIndex];
+	uint32_t nSlot = 0;
+
+	while (nSlot < nLength) {
+		if (m_aReference[nIndex] && (pPrevious[nSlot] == m_aDmxData[nSlot])) {
+			nSlot++;
+			continue;
+		}
+
+		const auto nBegin = nSlot;
+		auto nEnd = nSlot + 1;	// Exclusive
+
+		if (m_aReference[nIndex]) {
+			for (auto i = nEnd; (i < nLength) && (i <= (nEnd + RUN_MERGE_GAP)); i++) {
+				if (pPrevious[i] != m_aDmxData[i]) {
+					nEnd = i + 1;
+				}
+			}
+		} else {
+			nEnd = nLength;
+		}
+
+		auto *pRun = reinterpret_cast<struct Run *>(&m_aFrame[m_nFrameSize]);
+		pRun->nOffset = static_cast<uint16_t>(nBegin);
+		pRun->nCount = static_cast<uint16_t>(nEnd - nBegin);
+		m_nFrameSize += static_cast<uint32_t>(sizeof(struct Run));
+
+		memcpy(&m_aFrame[m_nFrameSize], &m_aDmxData[nBegin], nEnd - nBegin);
+		m_nFrameSize += nEnd - nBegin;
+
+		pRecord->nRuns++;
+		nSlot = nEnd;
+
+		// The runs are larger than all slots
+		if ((m_nFrameSize - nRecordDataStart) > (sizeof(struct Run) + nLength)) {
+			m_nFrameSize = nRecordDataStart;
+			pRecord->nRuns = 0;
+			m_aReference[nIndex] = false;
+			nSlot = 0;
+		}
+	}
+
+	memcpy(pPrevious, m_aDmxData, nLength);
+	m_aReference[nIndex] = true;
+	m_aLength[nIndex] = static_cast<uint16_t>(nLength);
+
+	m_nRecords++;
+
+	return true;
+}
+
+/**
+ * Completes the key frame with the universes not recorded in it, their last slots are repeated.
+ */
+bool ShowFileConvert::AddKeyRecords() {
+	for (uint32_t nIndex = 0; nIndex < m_Header.nUniverses; nIndex++) {
+		if (m_aReference[nIndex]) {
+			continue;
+		}
+
+		const uint32_t nLength = m_aLength[nIndex];
+
+		if ((m_nFrameSize + sizeof(struct Record) + sizeof(struct Run) + nLength) > sizeof(m_aFrame)) {
+			printf("Frame at %u ms is too large\n", m_nTimestampMillis);
+			return false;
+		}
+
+		auto *pRecord = reinterpret_cast<struct Record *>(&m_aFrame[m_nFrameSize]);
+		pRecord->nUniverseIndex = static_cast<uint16_t>(nIndex);
+		pRecord->nLength = static_cast<uint16_t>(nLength);
+		pRecord->nRuns = 0;
+
+		m_nFrameSize += static_cast<uint32_t>(sizeof(struct Record));
+
+		if (nLength != 0) {
+			auto *pRun = reinterpret_cast<struct Run *>(&m_aFrame[m_nFrameSize]);
+			pRun->nOffset = 0;
+			pRun->nCount = static_cast<uint16_t>(nLength);
+			m_nFrameSize += static_cast<uint32_t>(sizeof(struct Run));
+
+			memcpy(&m_aFrame[m_nFrameSize], m_aPrevious[nIndex], nLength);
+			m_nFrameSize += nLength;
+
+			pRecord->nRuns = 1;
+		}
+
+		m_aReference[nIndex] = true;
+		m_nRecords++;
+	}
+
+	return true;
+}
+
+bool ShowFileConvert::WriteFrame() {
+	if (m_nRecords == 0) {
+		return true;
+	}
+
+	if (m_bKeyFrame) {
+		m_bKeyFrame = false;
+
+		if (!AddKeyRecords()) {
+			return false;
+		}
+	}
+
+	auto *pFrame = reinterpret_cast<struct Frame *>(m_aFrame);
+	pFrame->nTimestampMillis = m_nTimestampMillis;
+	pFrame->nSize = m_nFrameSize;
+	pFrame->nRecords = static_cast<uint16_t>(m_nRecords);
+	pFrame->nReserved = 0;
+
+	if (fwrite(m_aFrame, 1, m_nFrameSize, m_pDestination) != m_nFrameSize) {
+		perror("fwrite");
+		return false;
+	}
+
+	if (m_nFrameSize > m_Header.nFrameSizeMax) {
+		m_Header.nFrameSizeMax = m_nFrameSize;
+	}
+
+	m_Header.nFrames++;
+	m_nOffset += m_nFrameSize;
+	m_nFrameSize = sizeof(struct Frame);
+	m_nRecords = 0;
+
+	return true;
+}
@@ -55,6 +55,8 @@ void ShowFile::SetShowFile(uint32_t nShowFileNumber) {
 		ShowFileStop();
 
 		if (m_pShowFile != nullptr) {
+			ShowFileClose();
+
 			if (fclose(m_pShowFile) != 0) {
 				perror("fclose(m_pShowFile)");
 			}
@@ -72,6 +74,8 @@ void ShowFile::SetShowFile(uint32_t nShowFileNumber) {
 		if (m_pShowFile == nullptr) {
 			perror(const_cast<char *>(m_aShowFileName));
 			m_aShowFileName[0] = '\0';
+		} else {
+			ShowFileOpen();
 		}
 
 		if (m_pShowFileDisplay != nullptr) {
@@ -123,6 +127,8 @@ void ShowFile::EnableTFTP(__attribute__((unused))bool bEnableTFTP) {
 		Stop();
 
 		if (m_pShowFile != nullptr) {
+			ShowFileClose();
+
 			if (fclose(m_pShowFile) != 0) {
 				perror("fclose(m_pShowFile)");
 			}
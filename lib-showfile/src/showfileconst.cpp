@@ -26,5 +26,5 @@
 #include "showfileconst.h"
 #include "showfile.h"
 
-const char ShowFileConst::FORMAT[static_cast<int>(showfile::Formats::UNDEFINED)][SHOWFILECONST_FORMAT_NAME_LENGTH] = { "OLA", "dummy" };
+const char ShowFileConst::FORMAT[static_cast<int>(showfile::Formats::UNDEFINED)][SHOWFILECONST_FORMAT_NAME_LENGTH] = { "OLA", "dummy", "bin" };
 const char ShowFileConst::STATUS[static_cast<int>(showfile::Status::UNDEFINED)][12] = { "Idle", "Running", "Stopped", "Ended" };
@@ -53,6 +53,7 @@ namespace cmd {
 	static constexpr char MASTER[] = "master";
 	static constexpr char TFTP[] = "tftp";
 	static constexpr char DELETE[] = "delete";
+	static constexpr char GOTO[] = "goto";
 	// TouchOSC specific
 	static constexpr char RELOAD[] = "reload";
 	static constexpr char INDEX[] = "index";
@@ -69,6 +70,7 @@ namespace length {
 	static constexpr auto MASTER = sizeof(cmd::MASTER) - 1;
 	static constexpr auto TFTP = sizeof(cmd::TFTP) - 1;
 	static constexpr auto DELETE = sizeof(cmd::DELETE) - 1;
+	static constexpr auto GOTO = sizeof(cmd::GOTO) - 1;
 	// TouchOSC specific
 	static constexpr auto RELOAD = sizeof(cmd::RELOAD) - 1;
 	static constexpr auto INDEX = sizeof(cmd::INDEX) - 1;
@@ -258,6 +260,31 @@ void ShowFileOSC::Run() {
 			return;
 		}
 
+		if (memcmp(&m_pBuffer[length::PATH], cmd::GOTO, length::GOTO) == 0) {
+			OscSimpleMessage Msg(m_pBuffer, nBytesReceived);
+
+			uint32_t nMillis;
+
+			if (Msg.GetType(0) == osc::type::INT32) {
+				nMillis = static_cast<uint32_t>(Msg.GetInt(0));
+			} else if (Msg.GetType(0) == osc::type::FLOAT) { // TouchOSC, seconds
+				const auto fSeconds = Msg.GetFloat(0);
+
+				if (fSeconds < 0) {
+					return;
+				}
+
+				nMillis = static_cast<uint32_t>(fSeconds * 1000);
+			} else {
+				return;
+			}
+
+			ShowFile::Get()->Goto(nMillis);
+
+			DEBUG_PRINTF("Goto %u", nMillis);
+			return;
+		}
+
 		// TouchOSC
 		if (memcmp(&m_pBuffer[length::PATH], cmd::RELOAD, length::RELOAD) == 0) {
 
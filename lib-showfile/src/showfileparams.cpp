@@ -82,6 +82,11 @@ ShowFileParams::ShowFileParams(ShowFileParamsStore *pShowFileParamsStore): m_pSh
 #endif
 	m_showFileParams.nDisableUnicast = 0;
 	m_showFileParams.nDmxMaster = DMX_MAX_VALUE;
+#if !defined (CONFIG_SHOWFILE_LIGHTSET_ONLY)
+	m_showFileParams.nArtNetKeepAlive = artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS;
+#else
+	m_showFileParams.nArtNetKeepAlive = 0;
+#endif
 
 	DEBUG_EXIT
 }
@@ -239,6 +244,17 @@ void ShowFileParams::callbackFunction(const char *pLine) {
 		}
 		return;
 	}
+
+	if (Sscan::Uint16(pLine, ShowFileParamsConst::ARTNET_KEEP_ALIVE, nValue16) == Sscan::OK) {
+		if ((nValue16 != artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS) && (nValue16 >= artnet::controller::KEEP_ALIVE_MIN_MILLIS) && (nValue16 <= artnet::controller::KEEP_ALIVE_MAX_MILLIS)) {
+			m_showFileParams.nArtNetKeepAlive = nValue16;
+			m_showFileParams.nSetList |= showfileparams::Mask::ARTNET_KEEP_ALIVE;
+		} else {
+			m_showFileParams.nArtNetKeepAlive = artnet::controller::KEEP_ALIVE_DEFAULT_MILLIS;
+			m_showFileParams.nSetList &= ~showfileparams::Mask::ARTNET_KEEP_ALIVE;
+		}
+		return;
+	}
 #endif
 
 	if (Sscan::Uint8(pLine, ShowFileParamsConst::DMX_MASTER, nValue8) == Sscan::OK) {
@@ -255,6 +271,10 @@ void ShowFileParams::callbackFunction(const char *pLine) {
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_AUTO_START, showfileparams::Options::AUTO_START);
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_LOOP, showfileparams::Options::LOOP);
 	HandleOptions(pLine, ShowFileParamsConst::OPTION_DISABLE_SYNC, showfileparams::Options::DISABLE_SYNC);
+#if !defined (CONFIG_SHOWFILE_LIGHTSET_ONLY)
+	HandleOptions(pLine, ShowFileParamsConst::ARTNET_LENGTH_EXACT, showfileparams::Options::ARTNET_LENGTH_EXACT);
+	HandleOptions(pLine, ShowFileParamsConst::ARTNET_CHANGED_ONLY, showfileparams::Options::ARTNET_CHANGED_ONLY);
+#endif
 }
 
 void ShowFileParams::Builder(const struct TShowFileParams *ptShowFileParamss, char *pBuffer, uint32_t nLength, uint32_t& nSize) {
@@ -284,6 +304,9 @@ void ShowFileParams::Builder(const struct TShowFileParams *ptShowFileParamss, ch
 
 	builder.AddComment("Art-Net");
 	builder.Add(ShowFileParamsConst::ARTNET_DISABLE_UNICAST, static_cast<uint32_t>(m_showFileParams.nDisableUnicast), isMaskSet(showfileparams::Mask::ARTNET_UNICAST_DISABLED));
+	builder.Add(ShowFileParamsConst::ARTNET_LENGTH_EXACT, isOptionSet(showfileparams::Options::ARTNET_LENGTH_EXACT), isOptionSet(showfileparams::Options::ARTNET_LENGTH_EXACT));
+	builder.Add(ShowFileParamsConst::ARTNET_CHANGED_ONLY, isOptionSet(showfileparams::Options::ARTNET_CHANGED_ONLY), isOptionSet(showfileparams::Options::ARTNET_CHANGED_ONLY));
+	builder.Add(ShowFileParamsConst::ARTNET_KEEP_ALIVE, static_cast<uint32_t>(m_showFileParams.nArtNetKeepAlive), isMaskSet(showfileparams::Mask::ARTNET_KEEP_ALIVE));
 #endif
 
 	builder.AddComment("Options");
@@ -344,6 +367,15 @@ void ShowFileParams::Set() {
 			ArtNetController::Get()->SetUnicast(false);
 		}
 	}
+
+	if (ArtNetController::Get() != nullptr) {
+		ArtNetController::Get()->SetLengthExact(isOptionSet(showfileparams::Options::ARTNET_LENGTH_EXACT));
+		ArtNetController::Get()->SetChangedOnly(isOptionSet(showfileparams::Options::ARTNET_CHANGED_ONLY));
+
+		if (isMaskSet(showfileparams::Mask::ARTNET_KEEP_ALIVE)) {
+			ArtNetController::Get()->SetKeepAlive(m_showFileParams.nArtNetKeepAlive);
+		}
+	}
 #endif
 
 	// Options
@@ -395,6 +427,10 @@ void ShowFileParams::Dump() {
 	if (isMaskSet(showfileparams::Mask::ARTNET_UNICAST_DISABLED)) {
 		printf(" %s=%u [%s]\n", ShowFileParamsConst::ARTNET_DISABLE_UNICAST, m_showFileParams.nDisableUnicast, m_showFileParams.nDisableUnicast == 0 ? "No" : "Yes");
 	}
+
+	if (isMaskSet(showfileparams::Mask::ARTNET_KEEP_ALIVE)) {
+		printf(" %s=%u\n", ShowFileParamsConst::ARTNET_KEEP_ALIVE, m_showFileParams.nArtNetKeepAlive);
+	}
 #endif
 
 	// Options
@@ -413,6 +449,14 @@ void ShowFileParams::Dump() {
 		if (isOptionSet(showfileparams::Options::DISABLE_SYNC)) {
 			printf("  Synchronization is disabled\n");
 		}
+
+		if (isOptionSet(showfileparams::Options::ARTNET_LENGTH_EXACT)) {
+			printf("  Art-Net length exact is enabled\n");
+		}
+
+		if (isOptionSet(showfileparams::Options::ARTNET_CHANGED_ONLY)) {
+			printf("  Art-Net changed only is enabled\n");
+		}
 #endif
 	}
 
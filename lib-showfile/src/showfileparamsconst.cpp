@@ -39,3 +39,6 @@ const char ShowFileParamsConst::OPTION_DISABLE_SYNC[] = "disable_sync";
 const char ShowFileParamsConst::PROTOCOL[] = "protocol";
 const char ShowFileParamsConst::SACN_SYNC_UNIVERSE[] = "sync_universe";
 const char ShowFileParamsConst::ARTNET_DISABLE_UNICAST[] = "disable_unicast";
+const char ShowFileParamsConst::ARTNET_LENGTH_EXACT[] = "length_exact";
+const char ShowFileParamsConst::ARTNET_CHANGED_ONLY[] = "changed_only";
+const char ShowFileParamsConst::ARTNET_KEEP_ALIVE[] = "keep_alive";
@@ -28,6 +28,15 @@
 
 #include <cstdint>
 
+/*
+ * The SPI flash builds keep the store in an append-only journal spread over
+ * CONFIG_SPIFLASHSTORE_SECTORS sectors at the end of the flash.
+ * The I2C EEPROM and the GD32 internal flash keep the single sector image.
+ */
+#if !defined (CONFIG_FLASHROM_USE_I2C) && !defined (GD32)
+# define SPIFLASHSTORE_JOURNAL
+#endif
+
 namespace spiflashstore {
 enum class Store {
 	NETWORK,
@@ -99,6 +108,10 @@ public:
 private:
 	bool Init();
 	uint32_t GetStoreOffset(spiflashstore::Store tStore);
+#if defined (SPIFLASHSTORE_JOURNAL)
+	bool InitJournal();
+	bool WriteJournal();
+#endif
 
 private:
 	struct FlashStore {
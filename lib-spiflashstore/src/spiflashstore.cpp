@@ -65,20 +65,18 @@ SpiFlashStore::SpiFlashStore() {
 	assert(s_pThis == nullptr);
 	s_pThis = this;
 
-	if (FlashRom::Get()->IsDetected()) {
-		s_bHaveFlashChip = Init();
+	s_nSpiFlashStoreSize = OFFSET_STORES;
+
+	for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
+		s_nSpiFlashStoreSize += s_aStorSize[j];
 	}
 
-	if (s_bHaveFlashChip) {
-		s_nSpiFlashStoreSize = OFFSET_STORES;
+	DEBUG_PRINTF("OFFSET_STORES=%d, m_nSpiFlashStoreSize=%d", static_cast<int>(OFFSET_STORES), s_nSpiFlashStoreSize);
 
-		for (uint32_t j = 0; j < static_cast<uint32_t>(Store::LAST); j++) {
-			s_nSpiFlashStoreSize += s_aStorSize[j];
-		}
-
-		DEBUG_PRINTF("OFFSET_STORES=%d, m_nSpiFlashStoreSize=%d", static_cast<int>(OFFSET_STORES), s_nSpiFlashStoreSize);
+	assert(s_nSpiFlashStoreSize <= FlashStore::SIZE);
 
-		assert(s_nSpiFlashStoreSize <= FlashStore::SIZE);
+	if (FlashRom::Get()->IsDetected()) {
+		s_bHaveFlashChip = Init();
 	}
 
 	DEBUG_EXIT
@@ -109,9 +107,16 @@ bool SpiFlashStore::Init() {
 		return false;
 	}
 
+#if defined (SPIFLASHSTORE_JOURNAL)
+	if (!InitJournal()) {
+		DEBUG_EXIT
+		return false;
+	}
+#else
 	flashrom::result result;
 	FlashRom::Get()->Read(s_nStartAddress, FlashStore::SIZE, reinterpret_cast<uint8_t *>(&s_SpiFlashData), result);
 	assert(result == flashrom::result::OK);
+#endif
 
 	bool bSignatureOK = true;
 
@@ -190,7 +195,14 @@ void SpiFlashStore::ResetSetList(Store tStore) {
 	*pbSetList++ = 0x00;
 	*pbSetList = 0x00;
 
+#if defined (SPIFLASHSTORE_JOURNAL)
+	// A journal write in progress picks up the change itself
+	if (s_State == State::IDLE) {
+		s_State = State::CHANGED;
+	}
+#else
 	s_State = State::CHANGED;
+#endif
 }
 
 void SpiFlashStore::Update(Store tStore, uint32_t nOffset, const void *pData, uint32_t nDataLength, uint32_t nSetList, uint32_t nOffsetSetList) {
@@ -225,7 +237,11 @@ void SpiFlashStore::Update(Store tStore, uint32_t nOffset, const void *pData, ui
 	}
 
 	if (bIsChanged) {
+#if defined (SPIFLASHSTORE_JOURNAL)
+		if (s_State == State::IDLE) {
+#else
 		if ((s_State == State::IDLE) || (s_State == State::WRITING))  {
+#endif
 			s_State = State::CHANGED;
 		}
 		s_nWaitMillis = Hardware::Get()->Millis();
@@ -297,6 +313,7 @@ void SpiFlashStore::CopyTo(Store tStore, void* pData, uint32_t& nDataLength) {
 	DEBUG_EXIT
 }
 
+#if !defined (SPIFLASHSTORE_JOURNAL)
 bool SpiFlashStore::Flash() {
 	if (__builtin_expect((s_State == State::IDLE), 1)) {
 		return false;
@@ -355,6 +372,7 @@ bool SpiFlashStore::Flash() {
 	__builtin_unreachable();
 	return false;
 }
+#endif
 
 void SpiFlashStore::Dump() {
 #ifndef NDEBUG
@@ -0,0 +1,517 @@
+/**
+ * @file spiflashstorejournal.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+#include "spiflashstore.h"
+
+#if defined (SPIFLASHSTORE_JOURNAL)
+
+#include "flashrom.h"
+
+#include "hardware.h"
+
+#include "debug.h"
+
+/*
+ * Journal layout
+ *
+ * CONFIG_SPIFLASHSTORE_SECTORS sectors at the end of the flash are used as a ring.
+ * Every sector starts with a SectorHeader, followed by append-only records.
+ * A record is a RecordHeader followed by nLength bytes of the store image at nOffset.
+ *
+ * A SNAPSHOT sector starts with a record holding the complete image. The LOG
+ * sectors following it (ascending sequence numbers) hold the changed byte ranges.
+ * When the ring runs out of sectors, a new snapshot is written into the next erased
+ * sector and the older sectors are erased one by one while the store is idle.
+ */
+
+#if !defined (CONFIG_SPIFLASHSTORE_SECTORS)
+# define CONFIG_SPIFLASHSTORE_SECTORS	8
+#endif
+
+namespace spiflashstore {
+namespace journal {
+static constexpr uint32_t SECTORS = CONFIG_SPIFLASHSTORE_SECTORS;
+static constexpr uint32_t SECTOR_SIZE = 4096;
+static constexpr uint32_t ALL = (SECTORS == 32) ? 0xFFFFFFFF : ((1U << SECTORS) - 1);
+static constexpr uint8_t MAGIC[] = {'A', 'v', 'J', 0x01};
+static constexpr auto QUIET_MILLIS = 1000U;
+
+static_assert((SECTORS >= 3) && (SECTORS <= 32), "CONFIG_SPIFLASHSTORE_SECTORS must be in 3..32");
+
+enum class Type : uint32_t {
+	LOG = 0x4C4F4721, SNAPSHOT = 0x534E4150
+};
+
+struct SectorHeader {
+	uint8_t aMagic[4];
+	uint32_t nSequence;
+	Type tType;
+	uint32_t nCheck;	///< ~nSequence
+};
+
+struct RecordHeader {
+	uint16_t nOffset;
+	uint16_t nLength;	///< 0xFFFF, erased, is the end of the sector
+	uint32_t nChecksum;
+};
+
+static_assert(sizeof(SectorHeader) == 16, "");
+static_assert(sizeof(RecordHeader) == 8, "");
+
+struct Write {
+	uint32_t nAddress;
+	uint32_t nLength;
+	const uint8_t *pBuffer;
+};
+
+static uint32_t s_nHead;		///< Sector being appended to
+static uint32_t s_nHeadOffset;	///< Write pointer within s_nHead
+static uint32_t s_nTail;		///< Sector with the snapshot
+static uint32_t s_nSequence;	///< Sequence number of s_nHead
+static uint32_t s_nErased;		///< Sectors known to be erased
+static uint32_t s_nGarbage;		///< Sectors to be erased while idle
+static uint32_t s_nErase;		///< Sector being erased
+static bool s_bSnapshot;		///< There is no valid journal, the next record must be a snapshot
+
+static uint8_t s_Committed[SECTOR_SIZE];	///< The image as it is in the journal, also the scratch buffer at Init
+
+static SectorHeader s_SectorHeader;
+static RecordHeader s_RecordHeader;
+
+static Write s_Writes[3];
+static uint32_t s_nWrites;
+static uint32_t s_nWriteIndex;
+
+static uint32_t next(const uint32_t nSector) {
+	return (nSector + 1) % SECTORS;
+}
+
+static uint32_t live() {
+	if (s_bSnapshot) {
+		return 0;
+	}
+
+	uint32_t nMask = 0;
+
+	for (auto n = s_nTail; ; n = next(n)) {
+		nMask |= (1U << n);
+		if (n == s_nHead) {
+			return nMask;
+		}
+	}
+}
+
+static void update_garbage() {
+	s_nGarbage = s_bSnapshot ? 0 : (ALL & ~s_nErased & ~live());
+}
+
+/*
+ * FNV-1a over the record position and data
+ */
+static uint32_t checksum(const uint32_t nOffset, const uint32_t nLength, const uint8_t *pData) {
+	uint32_t nHash = 2166136261U;
+
+	nHash = (nHash ^ (nOffset | (nLength << 16))) * 16777619U;
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		nHash = (nHash ^ pData[i]) * 16777619U;
+	}
+
+	return nHash;
+}
+
+static bool is_valid(const SectorHeader& header) {
+	return (memcmp(header.aMagic, MAGIC, sizeof(MAGIC)) == 0) && (header.nCheck == ~header.nSequence) && ((header.tType == Type::LOG) || (header.tType == Type::SNAPSHOT));
+}
+
+/**
+ * Applies the records of the sector, which is in s_Committed, to pImage.
+ * @return The write pointer, SECTOR_SIZE when the sector is closed or has a torn record.
+ * For a snapshot sector, 0 is returned when the snapshot record is invalid.
+ */
+static uint32_t replay(uint8_t *pImage, const uint32_t nImageSize, bool bSnapshot) {
+	auto nOffset = static_cast<uint32_t>(sizeof(SectorHeader));
+
+	while ((nOffset + sizeof(RecordHeader)) < SECTOR_SIZE) {
+		RecordHeader record;
+		memcpy(&record, &s_Committed[nOffset], sizeof(RecordHeader));
+
+		if ((record.nOffset == 0xFFFF) && (record.nLength == 0xFFFF) && (record.nChecksum == 0xFFFFFFFF)) {
+			return bSnapshot ? 0 : nOffset;
+		}
+
+		const auto *pData = &s_Committed[nOffset + sizeof(RecordHeader)];
+
+		if ((record.nLength == 0)
+				|| ((record.nOffset + record.nLength) > nImageSize)
+				|| ((nOffset + sizeof(RecordHeader) + record.nLength) > SECTOR_SIZE)
+				|| (record.nChecksum != checksum(record.nOffset, record.nLength, pData))
+				|| (bSnapshot && ((record.nOffset != 0) || (record.nLength != nImageSize)))) {
+			DEBUG_PRINTF("Invalid record at %u", nOffset);
+			return bSnapshot ? 0 : SECTOR_SIZE;
+		}
+
+		memcpy(&pImage[record.nOffset], pData, record.nLength);
+
+		nOffset += static_cast<uint32_t>(sizeof(RecordHeader)) + record.nLength;
+		bSnapshot = false;
+	}
+
+	return bSnapshot ? 0 : SECTOR_SIZE;
+}
+}  // namespace journal
+}  // namespace spiflashstore
+
+using namespace spiflashstore;
+
+bool SpiFlashStore::InitJournal() {
+	DEBUG_ENTRY
+	using namespace journal;
+
+	// A snapshot holds the complete image in a single record
+	assert((sizeof(SectorHeader) + sizeof(RecordHeader) + s_nSpiFlashStoreSize) <= SECTOR_SIZE);
+
+	if ((sizeof(SectorHeader) + sizeof(RecordHeader) + s_nSpiFlashStoreSize) > SECTOR_SIZE) {
+		DEBUG_PUTS("The store does not fit in a journal sector");
+		DEBUG_EXIT
+		return false;
+	}
+
+	const auto nFlashSize = FlashRom::Get()->GetSize();
+
+	if (nFlashSize < ((SECTORS + 1) * SECTOR_SIZE)) {
+		DEBUG_PUTS("Flash is too small for the journal");
+		DEBUG_EXIT
+		return false;
+	}
+
+	s_nStartAddress = nFlashSize - (SECTORS * SECTOR_SIZE);
+
+	flashrom::result result;
+	SectorHeader aHeader[SECTORS];
+	uint32_t nValid = 0;
+
+	for (uint32_t n = 0; n < SECTORS; n++) {
+		FlashRom::Get()->Read(s_nStartAddress + n * SECTOR_SIZE, sizeof(SectorHeader), reinterpret_cast<uint8_t *>(&aHeader[n]), result);
+		assert(result == flashrom::result::OK);
+
+		if (is_valid(aHeader[n])) {
+			nValid |= (1U << n);
+		}
+	}
+
+	/*
+	 * The newest snapshot with a valid image, followed by the LOG sectors with consecutive sequence numbers
+	 */
+
+	s_bSnapshot = true;
+
+	uint32_t nTried = 0;
+
+	for (;;) {
+		uint32_t nSnapshot = SECTORS;
+
+		for (uint32_t n = 0; n < SECTORS; n++) {
+			if ((nValid & ~nTried & (1U << n)) && (aHeader[n].tType == Type::SNAPSHOT)) {
+				if ((nSnapshot == SECTORS) || (aHeader[n].nSequence > aHeader[nSnapshot].nSequence)) {
+					nSnapshot = n;
+				}
+			}
+		}
+
+		if (nSnapshot == SECTORS) {
+			break;
+		}
+
+		nTried |= (1U << nSnapshot);
+
+		FlashRom::Get()->Read(s_nStartAddress + nSnapshot * SECTOR_SIZE, SECTOR_SIZE, s_Committed, result);
+		assert(result == flashrom::result::OK);
+
+		const auto nOffset = replay(s_SpiFlashData, s_nSpiFlashStoreSize, true);
+
+		if (nOffset == 0) {
+			DEBUG_PRINTF("Snapshot in sector %u is invalid", nSnapshot);
+			continue;
+		}
+
+		s_bSnapshot = false;
+		s_nTail = nSnapshot;
+		s_nHead = nSnapshot;
+		s_nHeadOffset = nOffset;
+		s_nSequence = aHeader[nSnapshot].nSequence;
+
+		for (auto n = next(nSnapshot); n != nSnapshot; n = next(n)) {
+			if (!(nValid & (1U << n)) || (aHeader[n].tType != Type::LOG) || (aHeader[n].nSequence != (s_nSequence + 1))) {
+				break;
+			}
+
+			FlashRom::Get()->Read(s_nStartAddress + n * SECTOR_SIZE, SECTOR_SIZE, s_Committed, result);
+			assert(result == flashrom::result::OK);
+
+			s_nHead = n;
+			s_nHeadOffset = replay(s_SpiFlashData, s_nSpiFlashStoreSize, false);
+			s_nSequence++;
+		}
+
+		break;
+	}
+
+	/*
+	 * The sectors outside the journal are either erased or garbage
+	 */
+
+	const auto nLive = live();
+	s_nErased = 0;
+
+	for (uint32_t n = 0; n < SECTORS; n++) {
+		if (nLive & (1U << n)) {
+			continue;
+		}
+
+		FlashRom::Get()->Read(s_nStartAddress + n * SECTOR_SIZE, SECTOR_SIZE, s_Committed, result);
+		assert(result == flashrom::result::OK);
+
+		uint32_t i;
+		for (i = 0; (i < SECTOR_SIZE) && (s_Committed[i] == 0xFF); i++)
+			;
+
+		if (i == SECTOR_SIZE) {
+			s_nErased |= (1U << n);
+		}
+	}
+
+	if (s_bSnapshot) {
+		/*
+		 * No journal, migrate the single sector image in the last sector.
+		 * It is erased only after the first snapshot has been written.
+		 */
+		DEBUG_PUTS("No journal");
+
+		FlashRom::Get()->Read(nFlashSize - SECTOR_SIZE, SECTOR_SIZE, reinterpret_cast<uint8_t *>(&s_SpiFlashData), result);
+		assert(result == flashrom::result::OK);
+
+		s_nHead = SECTORS - 1;
+		s_nTail = SECTORS - 1;
+		s_nSequence = 0;
+		s_nHeadOffset = SECTOR_SIZE;
+		s_State = State::CHANGED;
+	}
+
+	memcpy(s_Committed, s_SpiFlashData, s_nSpiFlashStoreSize);
+	update_garbage();
+
+	s_nWrites = 0;
+	s_nWriteIndex = 0;
+
+	DEBUG_PRINTF("s_nTail=%u, s_nHead=%u, s_nHeadOffset=%u, s_nSequence=%u, s_nErased=%x, s_nGarbage=%x", s_nTail, s_nHead, s_nHeadOffset, s_nSequence, s_nErased, s_nGarbage);
+	DEBUG_EXIT
+	return true;
+}
+
+/**
+ * One step of the journal writer, called from Flash() in State::WRITING.
+ * @return false when the journal is in sync with the store image.
+ */
+bool SpiFlashStore::WriteJournal() {
+	using namespace journal;
+
+	flashrom::result result;
+
+	if (s_nWriteIndex < s_nWrites) {
+		const auto& write = s_Writes[s_nWriteIndex];
+
+		if (FlashRom::Get()->Write(write.nAddress, write.nLength, write.pBuffer, result)) {
+			s_nWriteIndex++;
+		}
+
+		assert(result == flashrom::result::OK);
+		return true;
+	}
+
+	s_nWrites = 0;
+	s_nWriteIndex = 0;
+
+	/*
+	 * The next changed range, equal runs shorter than a record header are included
+	 */
+
+	uint32_t nBegin = 0;
+	uint32_t nEnd = 0;
+
+	if (!s_bSnapshot) {
+		while ((nBegin < s_nSpiFlashStoreSize) && (s_SpiFlashData[nBegin] == s_Committed[nBegin])) {
+			nBegin++;
+		}
+
+		if (nBegin == s_nSpiFlashStoreSize) {
+			return false;
+		}
+
+		nEnd = nBegin + 1;
+		uint32_t nEqual = 0;
+
+		for (auto i = nEnd; (i < s_nSpiFlashStoreSize) && (nEqual <= sizeof(RecordHeader)); i++) {
+			if (s_SpiFlashData[i] == s_Committed[i]) {
+				nEqual++;
+			} else {
+				nEqual = 0;
+				nEnd = i + 1;
+			}
+		}
+	}
+
+	auto bSnapshot = s_bSnapshot;
+
+	if (bSnapshot || ((s_nHeadOffset + sizeof(RecordHeader) + (nEnd - nBegin)) > SECTOR_SIZE)) {
+		const auto nNext = next(s_nHead);
+
+		if (!(s_nErased & (1U << nNext))) {
+			// All spare sectors are in use, erase now
+			s_nErase = nNext;
+			s_State = State::ERASING;
+			return true;
+		}
+
+		// Compact when opening a LOG sector would leave no erased sector for the next snapshot
+		if (!bSnapshot) {
+			const auto nLive = ((s_nHead + SECTORS - s_nTail) % SECTORS) + 1;
+			bSnapshot = (nLive >= (SECTORS - 1));
+		}
+
+		s_nHead = nNext;
+		s_nSequence++;
+		s_nErased &= ~(1U << nNext);
+
+		memcpy(s_SectorHeader.aMagic, MAGIC, sizeof(MAGIC));
+		s_SectorHeader.nSequence = s_nSequence;
+		s_SectorHeader.tType = bSnapshot ? Type::SNAPSHOT : Type::LOG;
+		s_SectorHeader.nCheck = ~s_nSequence;
+
+		s_Writes[s_nWrites++] = { s_nStartAddress + nNext * SECTOR_SIZE, sizeof(SectorHeader), reinterpret_cast<const uint8_t *>(&s_SectorHeader) };
+		s_nHeadOffset = sizeof(SectorHeader);
+
+		if (bSnapshot) {
+			DEBUG_PRINTF("Snapshot into sector %u", nNext);
+			s_nTail = nNext;
+			s_bSnapshot = false;
+			nBegin = 0;
+			nEnd = s_nSpiFlashStoreSize;
+		}
+
+		update_garbage();
+	}
+
+	memcpy(&s_Committed[nBegin], &s_SpiFlashData[nBegin], nEnd - nBegin);
+
+	s_RecordHeader.nOffset = static_cast<uint16_t>(nBegin);
+	s_RecordHeader.nLength = static_cast<uint16_t>(nEnd - nBegin);
+	s_RecordHeader.nChecksum = checksum(nBegin, nEnd - nBegin, &s_Committed[nBegin]);
+
+	const auto nAddress = s_nStartAddress + s_nHead * SECTOR_SIZE + s_nHeadOffset;
+
+	s_Writes[s_nWrites++] = { nAddress, sizeof(RecordHeader), reinterpret_cast<const uint8_t *>(&s_RecordHeader) };
+	s_Writes[s_nWrites++] = { nAddress + static_cast<uint32_t>(sizeof(RecordHeader)), nEnd - nBegin, &s_Committed[nBegin] };
+
+	s_nHeadOffset += static_cast<uint32_t>(sizeof(RecordHeader)) + nEnd - nBegin;
+
+	DEBUG_PRINTF("Record %u:%u at %x", nBegin, nEnd - nBegin, nAddress);
+	return true;
+}
+
+bool SpiFlashStore::Flash() {
+	if (__builtin_expect((s_State == State::IDLE), 1)) {
+		using namespace journal;
+
+		// Erase the sectors released by the last compaction, one at a time
+		if (__builtin_expect((s_nGarbage == 0), 1) || ((Hardware::Get()->Millis() - s_nWaitMillis) < QUIET_MILLIS)) {
+			return false;
+		}
+
+		s_nErase = static_cast<uint32_t>(__builtin_ctz(s_nGarbage));
+		s_State = State::ERASING;
+		return true;
+	}
+
+	switch (s_State) {
+	case State::CHANGED:
+		s_nWaitMillis = Hardware::Get()->Millis();
+		s_State = State::CHANGED_WAITING;
+		return true;
+	case State::CHANGED_WAITING:
+		if ((Hardware::Get()->Millis() - s_nWaitMillis) < 100) {
+			return true;
+		}
+		s_State = State::WRITING;
+		return true;
+		break;
+	case State::ERASING: {
+		flashrom::result result;
+		if (FlashRom::Get()->Erase(s_nStartAddress + journal::s_nErase * journal::SECTOR_SIZE, journal::SECTOR_SIZE, result)) {
+			journal::s_nErased |= (1U << journal::s_nErase);
+			journal::update_garbage();
+			s_nWaitMillis = Hardware::Get()->Millis();
+			s_State = State::ERASED_WAITING;
+		}
+		assert(result == flashrom::result::OK);
+		return true;
+	}
+		break;
+	case State::ERASED_WAITING:
+		if ((Hardware::Get()->Millis() - s_nWaitMillis) < 100) {
+			return true;
+		}
+		s_State = State::ERASED;
+		return true;
+		break;
+	case State::ERASED:
+		// Changes made while erasing are written now
+		s_State = State::WRITING;
+		return true;
+		break;
+	case State::WRITING:
+		if (WriteJournal()) {
+			return true;
+		}
+		s_State = State::IDLE;
+		return false;
+		break;
+	default:
+		assert(0);
+		__builtin_unreachable();
+		break;
+	}
+
+	assert(0);
+	__builtin_unreachable();
+	return false;
+}
+
+#endif
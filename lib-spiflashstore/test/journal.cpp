@@ -0,0 +1,437 @@
+/**
+ * @file journal.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Runs the SPI flash store journal (spiflashstorejournal.cpp) on a flash in memory.
+ * The flash behaves as NOR flash: an erase sets all bits, a write only clears bits.
+ * A power cut is a byte budget for the writes, the flash is dead when it is used up.
+ *
+ * - A write cut at every byte of a record, including between the header and the payload
+ * - Wrapping around all journal sectors, with the snapshots and the erases
+ * - The migration from the single sector image of the previous releases
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "spiflashstore.h"
+#include "flashrom.h"
+#include "hardware.h"
+
+using namespace spiflashstore;
+
+namespace flash {
+static constexpr uint32_t SECTOR_SIZE = 4096;
+static constexpr uint32_t SECTORS = 16;
+static constexpr uint32_t SIZE = SECTORS * SECTOR_SIZE;
+static constexpr uint32_t JOURNAL_SECTORS = 8;
+static constexpr uint32_t JOURNAL = SIZE - (JOURNAL_SECTORS * SECTOR_SIZE);
+
+static uint8_t s_Data[SIZE];
+static int32_t s_nBudget = -1;		///< Bytes that can be written before the power cut, -1 is no cut
+static uint32_t s_nWritten;
+static uint32_t s_nOverwrites;		///< Writes to bytes that are not erased
+}  // namespace flash
+
+static uint32_t s_nMillis;
+
+/*
+ * The flash driver and the hardware used by the store
+ */
+
+FlashRom *FlashRom::s_pThis;
+
+FlashRom::FlashRom() {
+	s_pThis = this;
+	m_IsDetected = true;
+}
+
+FlashRom::~FlashRom() {
+	s_pThis = nullptr;
+}
+
+uint32_t FlashRom::GetSize() const {
+	return flash::SIZE;
+}
+
+uint32_t FlashRom::GetSectorSize() const {
+	return flash::SECTOR_SIZE;
+}
+
+bool FlashRom::Read(uint32_t nOffset, uint32_t nLength, uint8_t *pBuffer, flashrom::result& nResult) {
+	nResult = ((nOffset + nLength) <= flash::SIZE) ? flashrom::result::OK : flashrom::result::ERROR;
+
+	if (nResult == flashrom::result::OK) {
+		memcpy(pBuffer, &flash::s_Data[nOffset], nLength);
+	}
+
+	return true;
+}
+
+bool FlashRom::Erase(uint32_t nOffset, uint32_t nLength, flashrom::result& nResult) {
+	nResult = (((nOffset + nLength) <= flash::SIZE) && ((nOffset % flash::SECTOR_SIZE) == 0) && ((nLength % flash::SECTOR_SIZE) == 0)) ? flashrom::result::OK : flashrom::result::ERROR;
+
+	if ((nResult == flashrom::result::OK) && (flash::s_nBudget != 0)) {
+		memset(&flash::s_Data[nOffset], 0xFF, nLength);
+	}
+
+	return true;
+}
+
+bool FlashRom::Write(uint32_t nOffset, uint32_t nLength, const uint8_t *pBuffer, flashrom::result& nResult) {
+	nResult = ((nOffset + nLength) <= flash::SIZE) ? flashrom::result::OK : flashrom::result::ERROR;
+
+	for (uint32_t i = 0; (nResult == flashrom::result::OK) && (i < nLength) && (flash::s_nBudget != 0); i++) {
+		if ((flash::s_Data[nOffset + i] != 0xFF) && (flash::s_Data[nOffset + i] != pBuffer[i])) {
+			flash::s_nOverwrites++;
+		}
+
+		flash::s_Data[nOffset + i] &= pBuffer[i];
+		flash::s_nWritten++;
+
+		if (flash::s_nBudget > 0) {
+			flash::s_nBudget--;
+		}
+	}
+
+	return true;
+}
+
+Hardware *Hardware::s_pThis;
+
+Hardware::Hardware() {
+	s_pThis = this;
+}
+
+uint32_t Hardware::Millis() {
+	return s_nMillis;
+}
+
+/*
+ * The harness
+ */
+
+static uint32_t s_errors;
+
+static void check(const char *pName, uint32_t n, bool isOk) {
+	if (!isOk) {
+		if (s_errors < 10) {
+			printf("%s n=%u\n", pName, n);
+		}
+		s_errors++;
+	}
+}
+
+static constexpr uint32_t STORES = static_cast<uint32_t>(Store::LAST);
+static constexpr uint32_t MAX_IMAGE = 4096;
+
+struct Image {
+	uint8_t data[MAX_IMAGE];
+	uint32_t nLength;
+};
+
+/*
+ * The contents of all stores
+ */
+static void get_image(Image& image) {
+	image.nLength = 0;
+
+	for (uint32_t j = 0; j < STORES; j++) {
+		uint32_t nLength;
+		SpiFlashStore::Get()->CopyTo(static_cast<Store>(j), &image.data[image.nLength], nLength);
+		image.nLength += nLength;
+	}
+}
+
+static bool operator==(const Image& a, const Image& b) {
+	return (a.nLength == b.nLength) && (memcmp(a.data, b.data, a.nLength) == 0);
+}
+
+static uint32_t get_store_size(Store store) {
+	static uint8_t buffer[MAX_IMAGE];
+	uint32_t nLength;
+	SpiFlashStore::Get()->CopyTo(store, buffer, nLength);
+	return nLength;
+}
+
+/*
+ * The statics of the store are kept over a reboot, as in the firmware.
+ * The previous instance is abandoned, its destructor would write the journal.
+ */
+static SpiFlashStore *boot() {
+	alignas(SpiFlashStore) static uint8_t storage[sizeof(SpiFlashStore)];
+
+	flash::s_nBudget = -1;
+
+	return new (storage) SpiFlashStore;
+}
+
+/*
+ * Runs the writer until the journal is in sync and the garbage is erased
+ */
+static void flush(SpiFlashStore *pStore) {
+	for (uint32_t i = 0; i < 400; i++) {
+		s_nMillis += 10;
+		pStore->Flash();
+	}
+}
+
+/*
+ * A contiguous range of a store where every byte changes, so it is a single record.
+ * The long ranges are in the large stores.
+ */
+static void update(SpiFlashStore *pStore, uint32_t nMaxLength) {
+	static uint8_t buffer[MAX_IMAGE];
+
+	Store store;
+	uint32_t nStoreSize;
+
+	do {
+		store = static_cast<Store>(static_cast<uint32_t>(rand()) % STORES);
+		nStoreSize = get_store_size(store);
+	} while ((nMaxLength >= 512) && (nStoreSize < 480));
+
+	const auto nLength = 1U + static_cast<uint32_t>(rand()) % (nMaxLength < nStoreSize ? nMaxLength : nStoreSize);
+	const auto nOffset = static_cast<uint32_t>(rand()) % (nStoreSize - nLength + 1U);
+
+	pStore->Copy(store, buffer, nLength, nOffset, false);
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		buffer[i] = static_cast<uint8_t>(buffer[i] ^ (1U + static_cast<uint32_t>(rand()) % 255));
+	}
+
+	pStore->Update(store, nOffset, buffer, nLength);
+}
+
+static uint32_t get_max_sequence() {
+	uint32_t nMax = 0;
+
+	for (uint32_t n = 0; n < flash::JOURNAL_SECTORS; n++) {
+		const auto *pSector = &flash::s_Data[flash::JOURNAL + n * flash::SECTOR_SIZE];
+		uint32_t nSequence, nCheck;
+
+		memcpy(&nSequence, &pSector[4], sizeof(uint32_t));
+		memcpy(&nCheck, &pSector[12], sizeof(uint32_t));
+
+		if ((memcmp(pSector, "AvJ\x01", 4) == 0) && (nCheck == ~nSequence) && (nSequence > nMax)) {
+			nMax = nSequence;
+		}
+	}
+
+	return nMax;
+}
+
+/*
+ * Updates until the ring has wrapped around all sectors a few times, a reboot after every update
+ */
+static void test_wrap() {
+	memset(flash::s_Data, 0xFF, sizeof(flash::s_Data));
+
+	auto *pStore = boot();
+	flush(pStore);
+
+	Image expected, image;
+
+	for (uint32_t n = 0; get_max_sequence() < (4 * flash::JOURNAL_SECTORS); n++) {
+		update(pStore, (n % 8) == 0 ? 1024 : 64);
+		get_image(expected);
+		flush(pStore);
+
+		pStore = boot();
+		get_image(image);
+
+		check("wrap image", n, image == expected);
+
+		if (n > 10000) {
+			check("wrap does not advance", n, false);
+			break;
+		}
+	}
+
+	check("wrap overwrites", flash::s_nOverwrites, flash::s_nOverwrites == 0);
+}
+
+/*
+ * For a series of updates, until the ring has wrapped, the power is cut at every byte the writer writes.
+ * After the reboot the image is the one before or the one after the update, never a mix.
+ * Then the journal must still take updates.
+ */
+static void test_cut() {
+	static uint8_t saved[flash::SIZE];
+
+	memset(flash::s_Data, 0xFF, sizeof(flash::s_Data));
+
+	auto *pStore = boot();
+	flush(pStore);
+
+	Image before, after, expected, image;
+
+	for (uint32_t n = 0; get_max_sequence() < (2 * flash::JOURNAL_SECTORS + 2); n++) {
+		memcpy(saved, flash::s_Data, sizeof(saved));
+		const auto nMillis = s_nMillis;
+		const auto nSeed = static_cast<uint32_t>(rand());
+
+		/* The bytes written for this update, without a cut */
+		get_image(before);
+		srand(nSeed);
+		update(pStore, (n % 2) == 0 ? 1024 : 128);
+		get_image(after);
+
+		flash::s_nWritten = 0;
+		flush(pStore);
+		const auto nWritten = flash::s_nWritten;
+
+		for (uint32_t nCut = 0; nCut < nWritten; nCut++) {
+			memcpy(flash::s_Data, saved, sizeof(saved));
+			s_nMillis = nMillis;
+
+			pStore = boot();
+			srand(nSeed);
+			update(pStore, (n % 2) == 0 ? 1024 : 128);
+
+			flash::s_nBudget = static_cast<int32_t>(nCut);
+			flush(pStore);
+
+			pStore = boot();
+			get_image(image);
+
+			check("cut image", nCut, (image == before) || (image == after));
+
+			/* The journal continues after the torn record */
+			update(pStore, 64);
+			get_image(expected);
+			flush(pStore);
+
+			pStore = boot();
+			get_image(image);
+
+			check("cut continue", nCut, image == expected);
+		}
+
+		/* The next update starts from the uncut journal */
+		memcpy(flash::s_Data, saved, sizeof(saved));
+		s_nMillis = nMillis;
+		pStore = boot();
+		srand(nSeed);
+		update(pStore, (n % 2) == 0 ? 1024 : 128);
+		flush(pStore);
+	}
+
+	check("cut overwrites", flash::s_nOverwrites, flash::s_nOverwrites == 0);
+}
+
+/*
+ * The previous releases kept a single image in the last sector of the flash.
+ * One of the other sectors at the end of the flash holds old data.
+ */
+static void test_migration(bool bCut) {
+	memset(flash::s_Data, 0xFF, sizeof(flash::s_Data));
+
+	static const uint8_t signature[] = {'A', 'v', 'V', 0x10};
+	auto *pLegacy = &flash::s_Data[flash::SIZE - flash::SECTOR_SIZE];
+
+	memcpy(pLegacy, signature, sizeof(signature));
+
+	for (uint32_t i = 16; i < 4064; i++) {
+		pLegacy[i] = static_cast<uint8_t>(rand());
+	}
+
+	for (uint32_t i = 0; i < flash::SECTOR_SIZE; i++) {
+		flash::s_Data[flash::JOURNAL + 2 * flash::SECTOR_SIZE + i] = static_cast<uint8_t>(i);
+	}
+
+	static uint8_t saved[flash::SIZE];
+	memcpy(saved, flash::s_Data, sizeof(saved));
+
+	auto *pStore = boot();
+
+	Image legacy, image;
+	get_image(legacy);
+
+	/* The stores of the legacy image, the first store starts at offset 32 */
+	check("migration legacy", 0, memcmp(legacy.data, &pLegacy[32], legacy.nLength) == 0);
+
+	flash::s_nWritten = 0;
+	flush(pStore);
+	const auto nWritten = flash::s_nWritten;
+
+	pStore = boot();
+	get_image(image);
+
+	check("migration image", 0, image == legacy);
+
+	/* A power cut while the first snapshot is written, the legacy image is still there */
+	for (uint32_t nCut = 0; bCut && (nCut < nWritten); nCut++) {
+		memcpy(flash::s_Data, saved, sizeof(saved));
+
+		pStore = boot();
+		flash::s_nBudget = static_cast<int32_t>(nCut);
+		flush(pStore);
+
+		pStore = boot();
+		get_image(image);
+
+		check("migration cut", nCut, image == legacy);
+	}
+
+	/* The legacy sector becomes part of the ring */
+	Image expected;
+
+	for (uint32_t n = 0; get_max_sequence() < (2 * flash::JOURNAL_SECTORS); n++) {
+		update(pStore, 512);
+		get_image(expected);
+		flush(pStore);
+
+		pStore = boot();
+		get_image(image);
+
+		check("migration update", n, image == expected);
+	}
+
+	check("migration signature", 0, memcmp(pLegacy, signature, sizeof(signature)) != 0);
+	check("migration overwrites", flash::s_nOverwrites, flash::s_nOverwrites == 0);
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	srand(1);
+
+	Hardware hardware;
+	FlashRom flashRom;
+
+	test_wrap();
+	test_cut();
+	test_migration(false);
+	test_migration(true);
+
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
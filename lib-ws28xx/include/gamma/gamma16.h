@@ -0,0 +1,218 @@
+/**
+ * @file gamma16.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef GAMMA_GAMMA16_H_
+#define GAMMA_GAMMA16_H_
+
+#include <cstdint>
+
+/*
+ * Entry i is the 8.8 fixed point output for the input i/255, full scale is 0xFF00.
+ * The last entry is repeated, so that gamma::apply16() can always read entry i + 1.
+ */
+
+// gamma=1.0
+static constexpr uint16_t gamma16_10[257] = {
+	    0,   256,   512,   768,  1024,  1280,  1536,  1792,  2048,  2304,  2560,  2816,
+	 3072,  3328,  3584,  3840,  4096,  4352,  4608,  4864,  5120,  5376,  5632,  5888,
+	 6144,  6400,  6656,  6912,  7168,  7424,  7680,  7936,  8192,  8448,  8704,  8960,
+	 9216,  9472,  9728,  9984, 10240, 10496, 10752, 11008, 11264, 11520, 11776, 12032,
+	12288, 12544, 12800, 13056, 13312, 13568, 13824, 14080, 14336, 14592, 14848, 15104,
+	15360, 15616, 15872, 16128, 16384, 16640, 16896, 17152, 17408, 17664, 17920, 18176,
+	18432, 18688, 18944, 19200, 19456, 19712, 19968, 20224, 20480, 20736, 20992, 21248,
+	21504, 21760, 22016, 22272, 22528, 22784, 23040, 23296, 23552, 23808, 24064, 24320,
+	24576, 24832, 25088, 25344, 25600, 25856, 26112, 26368, 26624, 26880, 27136, 27392,
+	27648, 27904, 28160, 28416, 28672, 28928, 29184, 29440, 29696, 29952, 30208, 30464,
+	30720, 30976, 31232, 31488, 31744, 32000, 32256, 32512, 32768, 33024, 33280, 33536,
+	33792, 34048, 34304, 34560, 34816, 35072, 35328, 35584, 35840, 36096, 36352, 36608,
+	36864, 37120, 37376, 37632, 37888, 38144, 38400, 38656, 38912, 39168, 39424, 39680,
+	39936, 40192, 40448, 40704, 40960, 41216, 41472, 41728, 41984, 42240, 42496, 42752,
+	43008, 43264, 43520, 43776, 44032, 44288, 44544, 44800, 45056, 45312, 45568, 45824,
+	46080, 46336, 46592, 46848, 47104, 47360, 47616, 47872, 48128, 48384, 48640, 48896,
+	49152, 49408, 49664, 49920, 50176, 50432, 50688, 50944, 51200, 51456, 51712, 51968,
+	52224, 52480, 52736, 52992, 53248, 53504, 53760, 54016, 54272, 54528, 54784, 55040,
+	55296, 55552, 55808, 56064, 56320, 56576, 56832, 57088, 57344, 57600, 57856, 58112,
+	58368, 58624, 58880, 59136, 59392, 59648, 59904, 60160, 60416, 60672, 60928, 61184,
+	61440, 61696, 61952, 62208, 62464, 62720, 62976, 63232, 63488, 63744, 64000, 64256,
+	64512, 64768, 65024, 65280, 65280
+};
+
+// gamma=2.0
+static constexpr uint16_t gamma16_20[257] = {
+	    0,     1,     4,     9,    16,    25,    36,    49,    64,    81,   100,   121,
+	  145,   170,   197,   226,   257,   290,   325,   362,   402,   443,   486,   531,
+	  578,   627,   679,   732,   787,   844,   904,   965,  1028,  1093,  1161,  1230,
+	 1301,  1374,  1450,  1527,  1606,  1688,  1771,  1856,  1944,  2033,  2124,  2218,
+	 2313,  2410,  2510,  2611,  2715,  2820,  2927,  3037,  3148,  3262,  3377,  3495,
+	 3614,  3736,  3859,  3985,  4112,  4242,  4373,  4507,  4642,  4780,  4919,  5061,
+	 5204,  5350,  5497,  5647,  5799,  5952,  6108,  6265,  6425,  6587,  6750,  6916,
+	 7084,  7253,  7425,  7599,  7774,  7952,  8132,  8313,  8497,  8683,  8871,  9060,
+	 9252,  9446,  9642,  9839, 10039, 10241, 10445, 10651, 10858, 11068, 11280, 11494,
+	11710, 11928, 12147, 12369, 12593, 12819, 13047, 13277, 13509, 13743, 13979, 14217,
+	14456, 14698, 14942, 15188, 15436, 15686, 15938, 16192, 16448, 16706, 16966, 17228,
+	17492, 17758, 18026, 18296, 18569, 18843, 19119, 19397, 19677, 19959, 20243, 20529,
+	20817, 21107, 21400, 21694, 21990, 22288, 22588, 22890, 23195, 23501, 23809, 24119,
+	24431, 24746, 25062, 25380, 25700, 26023, 26347, 26673, 27001, 27332, 27664, 27998,
+	28335, 28673, 29013, 29356, 29700, 30046, 30395, 30745, 31097, 31452, 31808, 32167,
+	32527, 32889, 33254, 33620, 33989, 34359, 34732, 35106, 35483, 35861, 36242, 36624,
+	37009, 37395, 37784, 38174, 38567, 38961, 39358, 39756, 40157, 40559, 40964, 41371,
+	41779, 42190, 42602, 43017, 43434, 43852, 44273, 44696, 45120, 45547, 45976, 46406,
+	46839, 47274, 47710, 48149, 48590, 49033, 49477, 49924, 50373, 50824, 51276, 51731,
+	52188, 52647, 53107, 53570, 54035, 54502, 54971, 55442, 55914, 56389, 56866, 57345,
+	57826, 58309, 58794, 59281, 59769, 60260, 60753, 61248, 61745, 62244, 62745, 63248,
+	63753, 64260, 64769, 65280, 65280
+};
+
+// gamma=2.1
+static constexpr uint16_t gamma16_21[257] = {
+	    0,     1,     2,     6,    11,    17,    25,    34,    45,    58,    73,    89,
+	  106,   126,   147,   170,   195,   221,   250,   280,   311,   345,   380,   418,
+	  457,   497,   540,   585,   631,   679,   729,   781,   835,   891,   949,  1008,
+	 1070,  1133,  1198,  1266,  1335,  1406,  1479,  1554,  1630,  1709,  1790,  1873,
+	 1957,  2044,  2132,  2223,  2316,  2410,  2507,  2605,  2705,  2808,  2912,  3019,
+	 3127,  3238,  3350,  3465,  3581,  3700,  3820,  3943,  4067,  4194,  4323,  4453,
+	 4586,  4721,  4858,  4997,  5138,  5281,  5426,  5573,  5722,  5873,  6026,  6182,
+	 6339,  6499,  6660,  6824,  6990,  7158,  7327,  7500,  7674,  7850,  8028,  8209,
+	 8391,  8576,  8762,  8951,  9142,  9335,  9530,  9728,  9927, 10128, 10332, 10538,
+	10746, 10956, 11168, 11382, 11599, 11817, 12038, 12261, 12486, 12713, 12942, 13173,
+	13407, 13643, 13880, 14120, 14363, 14607, 14853, 15102, 15353, 15606, 15861, 16118,
+	16378, 16639, 16903, 17169, 17437, 17708, 17980, 18255, 18532, 18811, 19092, 19375,
+	19661, 19949, 20239, 20531, 20825, 21122, 21421, 21722, 22025, 22330, 22638, 22948,
+	23260, 23574, 23891, 24209, 24530, 24853, 25178, 25506, 25836, 26167, 26502, 26838,
+	27177, 27517, 27860, 28206, 28553, 28903, 29255, 29609, 29966, 30324, 30685, 31048,
+	31414, 31781, 32151, 32523, 32898, 33274, 33653, 34034, 34417, 34803, 35191, 35581,
+	35973, 36368, 36765, 37164, 37565, 37969, 38374, 38783, 39193, 39606, 40021, 40438,
+	40857, 41279, 41703, 42129, 42558, 42989, 43422, 43857, 44295, 44735, 45177, 45621,
+	46068, 46517, 46968, 47422, 47878, 48336, 48796, 49259, 49724, 50191, 50661, 51133,
+	51607, 52084, 52562, 53043, 53527, 54012, 54500, 54991, 55483, 55978, 56475, 56975,
+	57476, 57980, 58487, 58996, 59506, 60020, 60535, 61053, 61574, 62096, 62621, 63148,
+	63678, 64209, 64744, 65280, 65280
+};
+
+// gamma=2.2
+static constexpr uint16_t gamma16_22[257] = {
+	    0,     0,     2,     4,     7,    11,    17,    24,    32,    42,    53,    65,
+	   78,    94,   110,   128,   148,   169,   191,   216,   241,   269,   298,   328,
+	  360,   394,   430,   467,   506,   547,   589,   633,   679,   726,   776,   827,
+	  880,   934,   991,  1049,  1109,  1171,  1235,  1300,  1368,  1437,  1508,  1581,
+	 1656,  1733,  1812,  1893,  1975,  2060,  2146,  2235,  2325,  2417,  2512,  2608,
+	 2706,  2806,  2908,  3013,  3119,  3227,  3337,  3450,  3564,  3680,  3798,  3919,
+	 4041,  4166,  4292,  4421,  4552,  4685,  4819,  4956,  5096,  5237,  5380,  5525,
+	 5673,  5823,  5974,  6128,  6284,  6442,  6603,  6765,  6930,  7097,  7266,  7437,
+	 7610,  7786,  7963,  8143,  8325,  8509,  8696,  8885,  9075,  9268,  9464,  9661,
+	 9861, 10063, 10267, 10474, 10682, 10893, 11107, 11322, 11540, 11760, 11982, 12207,
+	12433, 12663, 12894, 13128, 13363, 13602, 13842, 14085, 14330, 14578, 14827, 15080,
+	15334, 15591, 15850, 16111, 16375, 16641, 16909, 17180, 17453, 17729, 18006, 18287,
+	18569, 18854, 19141, 19431, 19723, 20017, 20314, 20613, 20915, 21218, 21525, 21833,
+	22144, 22458, 22774, 23092, 23413, 23736, 24062, 24390, 24720, 25053, 25388, 25726,
+	26066, 26408, 26753, 27101, 27451, 27803, 28158, 28515, 28875, 29237, 29602, 29969,
+	30338, 30710, 31085, 31462, 31841, 32223, 32608, 32995, 33384, 33776, 34170, 34567,
+	34967, 35369, 35773, 36180, 36589, 37001, 37416, 37833, 38252, 38674, 39099, 39526,
+	39956, 40388, 40823, 41260, 41700, 42142, 42587, 43034, 43484, 43937, 44392, 44849,
+	45310, 45772, 46238, 46706, 47176, 47649, 48125, 48603, 49084, 49567, 50053, 50542,
+	51033, 51526, 52023, 52522, 53023, 53527, 54034, 54543, 55055, 55570, 56087, 56607,
+	57129, 57654, 58182, 58712, 59245, 59780, 60318, 60859, 61402, 61948, 62497, 63048,
+	63602, 64159, 64718, 65280, 65280
+};
+
+// gamma=2.3
+static constexpr uint16_t gamma16_23[257] = {
+	    0,     0,     1,     2,     5,     8,    12,    17,    23,    30,    38,    47,
+	   58,    69,    82,    97,   112,   129,   147,   166,   187,   209,   233,   258,
+	  285,   313,   342,   373,   406,   440,   475,   513,   552,   592,   634,   678,
+	  723,   770,   819,   869,   921,   975,  1031,  1088,  1147,  1208,  1271,  1335,
+	 1401,  1470,  1539,  1611,  1685,  1760,  1838,  1917,  1998,  2081,  2166,  2253,
+	 2341,  2432,  2525,  2620,  2716,  2815,  2915,  3018,  3123,  3229,  3338,  3449,
+	 3561,  3676,  3793,  3912,  4033,  4156,  4281,  4408,  4538,  4669,  4803,  4939,
+	 5077,  5217,  5359,  5503,  5650,  5799,  5950,  6103,  6258,  6416,  6576,  6738,
+	 6902,  7068,  7237,  7408,  7581,  7757,  7934,  8115,  8297,  8482,  8668,  8858,
+	 9049,  9243,  9439,  9638,  9839, 10042, 10248, 10455, 10666, 10878, 11093, 11311,
+	11531, 11753, 11977, 12204, 12434, 12666, 12900, 13137, 13376, 13617, 13861, 14108,
+	14357, 14608, 14862, 15118, 15377, 15638, 15902, 16169, 16437, 16709, 16982, 17259,
+	17538, 17819, 18103, 18389, 18678, 18970, 19264, 19561, 19860, 20162, 20466, 20773,
+	21083, 21395, 21709, 22027, 22347, 22669, 22994, 23322, 23653, 23986, 24321, 24660,
+	25001, 25344, 25690, 26039, 26391, 26745, 27102, 27462, 27824, 28189, 28556, 28927,
+	29300, 29676, 30054, 30435, 30819, 31206, 31595, 31987, 32382, 32779, 33180, 33583,
+	33988, 34397, 34808, 35222, 35639, 36059, 36481, 36906, 37334, 37765, 38198, 38635,
+	39074, 39516, 39961, 40408, 40859, 41312, 41768, 42227, 42688, 43153, 43620, 44091,
+	44564, 45040, 45518, 46000, 46485, 46972, 47462, 47956, 48452, 48951, 49452, 49957,
+	50465, 50975, 51489, 52005, 52524, 53046, 53572, 54100, 54631, 55164, 55701, 56241,
+	56784, 57329, 57878, 58429, 58984, 59541, 60102, 60665, 61232, 61801, 62373, 62949,
+	63527, 64108, 64693, 65280, 65280
+};
+
+// gamma=2.4
+static constexpr uint16_t gamma16_24[257] = {
+	    0,     0,     1,     2,     3,     5,     8,    12,    16,    21,    27,    35,
+	   43,    52,    62,    73,    85,    98,   113,   128,   145,   163,   182,   203,
+	  225,   248,   272,   298,   325,   354,   384,   415,   448,   483,   518,   556,
+	  595,   635,   677,   721,   766,   812,   861,   911,   962,  1016,  1071,  1128,
+	 1186,  1246,  1308,  1372,  1437,  1504,  1573,  1644,  1717,  1791,  1868,  1946,
+	 2026,  2108,  2192,  2278,  2365,  2455,  2547,  2640,  2736,  2833,  2933,  3035,
+	 3138,  3244,  3352,  3461,  3573,  3687,  3803,  3921,  4041,  4163,  4288,  4414,
+	 4543,  4674,  4807,  4942,  5080,  5219,  5361,  5505,  5652,  5800,  5951,  6104,
+	 6259,  6417,  6577,  6739,  6904,  7071,  7240,  7411,  7585,  7761,  7940,  8121,
+	 8304,  8490,  8678,  8869,  9062,  9257,  9455,  9655,  9858, 10063, 10271, 10481,
+	10693, 10909, 11126, 11346, 11569, 11794, 12022, 12252, 12485, 12720, 12958, 13199,
+	13442, 13688, 13936, 14187, 14440, 14696, 14955, 15217, 15481, 15747, 16017, 16289,
+	16564, 16841, 17121, 17404, 17689, 17978, 18268, 18562, 18859, 19158, 19460, 19764,
+	20072, 20382, 20695, 21011, 21329, 21650, 21975, 22301, 22631, 22964, 23299, 23638,
+	23979, 24323, 24670, 25019, 25372, 25727, 26086, 26447, 26811, 27178, 27548, 27921,
+	28297, 28676, 29057, 29442, 29830, 30220, 30614, 31010, 31410, 31812, 32218, 32626,
+	33037, 33452, 33869, 34290, 34713, 35140, 35570, 36002, 36438, 36877, 37319, 37764,
+	38212, 38663, 39117, 39574, 40035, 40498, 40965, 41434, 41907, 42383, 42862, 43345,
+	43830, 44319, 44810, 45305, 45803, 46305, 46809, 47317, 47828, 48342, 48859, 49379,
+	49903, 50430, 50960, 51494, 52030, 52570, 53113, 53659, 54209, 54762, 55318, 55878,
+	56440, 57007, 57576, 58149, 58724, 59304, 59886, 60472, 61062, 61654, 62250, 62849,
+	63452, 64058, 64667, 65280, 65280
+};
+
+// gamma=2.5
+static constexpr uint16_t gamma16_25[257] = {
+	    0,     0,     0,     1,     2,     4,     6,     8,    11,    15,    20,    25,
+	   31,    38,    46,    55,    64,    75,    86,    99,   112,   127,   143,   159,
+	  177,   196,   217,   238,   261,   285,   310,   336,   364,   393,   424,   456,
+	  489,   524,   560,   597,   636,   677,   719,   762,   807,   854,   902,   952,
+	 1004,  1057,  1111,  1168,  1226,  1286,  1347,  1410,  1475,  1542,  1611,  1681,
+	 1753,  1827,  1903,  1981,  2060,  2141,  2225,  2310,  2397,  2486,  2577,  2670,
+	 2765,  2862,  2961,  3063,  3166,  3271,  3378,  3487,  3599,  3712,  3828,  3946,
+	 4066,  4188,  4312,  4438,  4567,  4698,  4831,  4966,  5104,  5244,  5386,  5530,
+	 5677,  5826,  5977,  6131,  6287,  6445,  6606,  6769,  6934,  7102,  7273,  7445,
+	 7621,  7798,  7978,  8161,  8346,  8533,  8724,  8916,  9111,  9309,  9509,  9712,
+	 9917, 10125, 10335, 10549, 10764, 10983, 11204, 11427, 11653, 11882, 12114, 12348,
+	12585, 12825, 13067, 13313, 13561, 13811, 14065, 14321, 14580, 14841, 15106, 15373,
+	15644, 15917, 16192, 16471, 16753, 17037, 17324, 17615, 17908, 18204, 18503, 18804,
+	19109, 19417, 19728, 20041, 20358, 20677, 21000, 21325, 21654, 21986, 22320, 22658,
+	22999, 23342, 23689, 24039, 24392, 24748, 25107, 25470, 25835, 26204, 26575, 26950,
+	27328, 27709, 28094, 28481, 28872, 29266, 29663, 30063, 30467, 30873, 31283, 31697,
+	32113, 32533, 32956, 33382, 33812, 34245, 34681, 35121, 35564, 36010, 36459, 36912,
+	37368, 37828, 38291, 38757, 39227, 39700, 40177, 40657, 41140, 41627, 42118, 42611,
+	43109, 43609, 44113, 44621, 45132, 45647, 46165, 46687, 47212, 47740, 48273, 48808,
+	49348, 49891, 50437, 50987, 51541, 52098, 52659, 53223, 53791, 54363, 54938, 55517,
+	56099, 56686, 57275, 57869, 58466, 59067, 59672, 60280, 60892, 61507, 62127, 62750,
+	63377, 64008, 64642, 65280, 65280
+};
+
+#endif /* GAMMA_GAMMA16_H_ */
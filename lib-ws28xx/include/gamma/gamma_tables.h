@@ -36,6 +36,7 @@
 #include "gamma24offset0.h"
 #include "gamma25offset0.h"
 #include "gamma25offset5.h"
+#include "gamma16.h"
 
 #include "pixeltype.h"
 
@@ -89,6 +90,59 @@ inline static const uint8_t *get_table(const uint32_t nValue) {
 	}
 }
 
+/**
+ * 16-bit tables for the RTZ types, see PixelConfiguration::IsEnableDithering()
+ */
+inline static const uint16_t *get_table16_default() {
+	return gamma16_22;
+}
+
+inline static const uint16_t *get_table16(const uint32_t nValue) {
+	switch (nValue) {
+	case 20:
+		return gamma16_20;
+		break;
+	case 21:
+		return gamma16_21;
+		break;
+	case 22:
+		return gamma16_22;
+		break;
+	case 23:
+		return gamma16_23;
+		break;
+	case 24:
+		return gamma16_24;
+		break;
+	case 25:
+		return gamma16_25;
+		break;
+	default:
+		return gamma16_10;
+		break;
+	}
+}
+
+/**
+ * 8-bit input, returns 8.8 fixed point
+ */
+inline static uint16_t apply16(const uint16_t *pTable, const uint8_t nValue) {
+	return pTable[nValue];
+}
+
+/**
+ * 16-bit input, returns 8.8 fixed point.
+ * The input is split in nValue / 257 and the remainder, (nValue * 0xFF01) >> 24 is nValue / 257 for all 16-bit values.
+ */
+inline static uint16_t apply16(const uint16_t *pTable, const uint16_t nValue) {
+	const auto nIndex = (static_cast<uint32_t>(nValue) * 0xFF01U) >> 24;
+	const auto nFraction = nValue - nIndex * 257U;
+	const uint32_t nLow = pTable[nIndex];
+	const uint32_t nHigh = pTable[nIndex + 1];
+
+	return static_cast<uint16_t>(nLow + (((nHigh - nLow) * nFraction * 255U) >> 16));
+}
+
 }  // namespace gamma
 
 #endif /* GAMMA_TABLES_H_ */
@@ -46,6 +46,9 @@ public:
 	void Blackout();
 	void FullOn();
 
+	void Run() {
+	}
+
 	pixel::Type GetType() const {
 		return m_PixelConfiguration.GetType();
 	}
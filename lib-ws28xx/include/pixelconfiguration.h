@@ -109,6 +109,34 @@ public:
 		return m_pGammaTable;
 	}
 
+	/**
+	 * 16-bit input, two DMX slots (coarse, fine) per colour component.
+	 * Implies dithering.
+	 */
+	void SetEnable16Bit(bool doEnable) {
+		m_bEnable16Bit = doEnable;
+	}
+
+	bool IsEnable16Bit() const {
+		return m_bEnable16Bit;
+	}
+
+	/**
+	 * Temporal dithering of the 8.8 fixed point gamma output.
+	 * RTZ types only.
+	 */
+	void SetEnableDithering(bool doEnable) {
+		m_bEnableDithering = doEnable;
+	}
+
+	bool IsEnableDithering() const {
+		return m_bEnableDithering;
+	}
+
+	const uint16_t *GetGammaTable16() const {
+		return m_pGammaTable16;
+	}
+
 	void Validate(uint32_t& nLedsPerPixel);
 
 	void Print();
@@ -132,7 +160,10 @@ private:
 	uint8_t m_nGammaValue { 0 };
 	bool m_bEnableGammaCorrection { false };
 	bool m_bIsRTZProtocol { true };
+	bool m_bEnable16Bit { false };
+	bool m_bEnableDithering { false };
 	const uint8_t *m_pGammaTable { gamma10_0 };
+	const uint16_t *m_pGammaTable16 { gamma16_10 };
 };
 
 #endif /* PIXELCONFIGURATION_H_ */
@@ -27,6 +27,7 @@
 #define SPI_WS28XXMULTI_H_
 
 #include <cstdint>
+#include <cstring>
 
 #include "pixelconfiguration.h"
 #include "gamma/gamma_tables.h"
@@ -43,14 +44,74 @@ public:
 	void SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
 	void SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite);
 
+	/**
+	 * Bulk update of a single port.
+	 * pData holds nPixels * nChannelsPerPixel slots, RGB or RGBW.
+	 */
+	void SetPixels(uint32_t nPortIndex, uint32_t nPixelIndex, const uint8_t *pData, uint32_t nPixels, uint32_t nChannelsPerPixel);
+
+	/**
+	 * Bulk update of all 8 ports in one pass.
+	 * pData[nPortIndex] holds nPixels * nChannelsPerPixel slots, nullptr is all off.
+	 */
+	void SetFrame(const uint8_t * const pData[8], uint32_t nPixelIndex, uint32_t nPixels, uint32_t nChannelsPerPixel);
+
+	/**
+	 * Bulk update of a single port with 16-bit input.
+	 * pData holds nPixels * nChannelsPerPixel components of 2 slots, coarse first.
+	 * Requires IsDithering().
+	 */
+	void SetPixels16(uint32_t nPortIndex, uint32_t nPixelIndex, const uint8_t *pData, uint32_t nPixels, uint32_t nChannelsPerPixel);
+
+	/**
+	 * The pixels are kept as 8.8 fixed point, each Update() sends the next dither frame.
+	 */
+	bool IsDithering() const {
+		return m_pDither != nullptr;
+	}
+
+	/**
+	 * Refreshes the output with the next dither frame when the previous frame has been sent.
+	 */
+	void Dither() {
+		if ((m_pDither != nullptr) && !IsUpdating()) {
+			Update();
+		}
+	}
+
+	bool IsBulkSupported(uint32_t nChannelsPerPixel) const {
+		if (nChannelsPerPixel == 4) {
+			return true;
+		}
+		return (nChannelsPerPixel == 3) && (m_PixelConfiguration.IsRTZProtocol() || (m_PixelConfiguration.GetType() == pixel::Type::WS2801));
+	}
+
+	/**
+	 * The pixel data is double-buffered, there is no need to wait
+	 * for IsUpdating() before writing pixels.
+	 */
 	bool IsUpdating() {
 		return h3_spi_dma_tx_is_active();  // returns TRUE while DMA operation is active
 	}
 
+	/**
+	 * Does not wait for the previous frame. While it is still in transmission,
+	 * the frame is started by Run().
+	 */
 	void Update();
 	void Blackout();
 	void FullOn();
 
+	void Run() {
+		if (__builtin_expect(m_bUpdatePending, 0) && !IsUpdating()) {
+			StartFrame();
+		}
+	}
+
+	bool IsUpdatePending() const {
+		return m_bUpdatePending;
+	}
+
 	pixel::Type GetType() const {
 		return m_PixelConfiguration.GetType();
 	}
@@ -78,13 +139,34 @@ private:
 	bool SetupCPLD();
 	void SetupBuffers();
 	void SetColour(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nColour1, uint8_t nColour2, uint8_t nColour3);
+	void SetupDither(uint32_t nLedsPerPixel);
+	void EncodeDither();
+	void StartFrame();
+
+	/*
+	 * Same double-buffering scheme as WS28xx::PrepareBuffer()
+	 */
+	void PrepareBuffer() {
+		if (__builtin_expect(m_bBufferSync, 0)) {
+			memcpy(m_pBuffer, m_pFrontBuffer, m_nBufSize);
+			m_bBufferSync = false;
+		}
+		m_bBufferChanged = true;
+	}
 
 private:
 	PixelConfiguration m_PixelConfiguration;
 	bool m_hasCPLD { false };
+	bool m_bBufferSync { false };
+	bool m_bBufferChanged { false };
+	bool m_bUpdatePending { false };
 	uint32_t m_nBufSize { 0 };
 	uint8_t *m_pBuffer { nullptr };
+	uint8_t *m_pFrontBuffer { nullptr };
 	uint8_t *m_pBlackoutBuffer { nullptr };
+	uint16_t *m_pDither { nullptr };
+	uint32_t m_nDitherBlocks { 0 };
+	uint32_t m_nDitherFrame { 0 };
 	JamSTAPLDisplay *m_pJamSTAPLDisplay { nullptr };
 
 	static WS28xxMulti *s_pThis;
@@ -27,6 +27,7 @@
 #define WS28XX_H_
 
 #include <cstdint>
+#include <cstring>
 
 #include "pixelconfiguration.h"
 
@@ -52,10 +53,25 @@ public:
 	}
 #endif
 
+	/**
+	 * With DMA, does not wait for the previous frame. While it is still in transmission,
+	 * the frame is started by Run().
+	 */
 	void Update();
 	void Blackout();
 	void FullOn();
 
+#if defined ( USE_SPI_DMA )
+	void Run() {
+		if (__builtin_expect(m_bUpdatePending, 0) && !IsUpdating()) {
+			StartFrame();
+		}
+	}
+#else
+	void Run() {
+	}
+#endif
+
 	pixel::Type GetType() const {
 		return m_PixelConfiguration.GetType();
 	}
@@ -74,13 +90,38 @@ public:
 
 private:
 	void SetupBuffers();
+#if defined (USE_SPI_DMA)
+	void StartFrame();
+#endif
 	void SetColorWS28xx(uint32_t nOffset, uint8_t nValue);
 
+	/*
+	 * With DMA the pixel data is double-buffered. The pixels are written into
+	 * the back buffer (m_pBuffer) while the front buffer is being transmitted.
+	 * Update() swaps the buffers. The back buffer is brought up to date with
+	 * the front buffer before the first write after a swap.
+	 */
+	void PrepareBuffer() {
+#if defined (USE_SPI_DMA)
+		if (__builtin_expect(m_bBufferSync, 0)) {
+			memcpy(m_pBuffer, m_pFrontBuffer, m_nBufSize);
+			m_bBufferSync = false;
+		}
+		m_bBufferChanged = true;
+#endif
+	}
+
 private:
 	PixelConfiguration m_PixelConfiguration;
 	uint32_t m_nBufSize;
 	uint8_t *m_pBuffer { nullptr };
 	uint8_t *m_pBlackoutBuffer { nullptr };
+#if defined (USE_SPI_DMA)
+	uint8_t *m_pFrontBuffer { nullptr };
+	bool m_bBufferSync { false };
+	bool m_bBufferChanged { false };
+	bool m_bUpdatePending { false };
+#endif
 
 	static WS28xx *s_pThis;
 };
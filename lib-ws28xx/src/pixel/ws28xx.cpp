@@ -42,6 +42,8 @@ using namespace pixel;
 void WS28xx::SetPixel(uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
 	assert(nPixelIndex < m_PixelConfiguration.GetCount());
 
+	PrepareBuffer();
+
 	const auto pGammaTable = m_PixelConfiguration.GetGammaTable();
 
 	nRed = pGammaTable[nRed];
@@ -141,6 +143,8 @@ void WS28xx::SetPixel(uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_
 	assert(nPixelIndex < m_PixelConfiguration.GetCount());
 	assert(m_PixelConfiguration.GetType() == Type::SK6812W);
 
+	PrepareBuffer();
+
 	const auto pGammaTable = m_PixelConfiguration.GetGammaTable();
 
 	nRed = pGammaTable[nRed];
@@ -114,6 +114,25 @@ void PixelConfiguration::Validate(uint32_t& nLedsPerPixel) {
 		m_pGammaTable = gamma10_0;
 	}
 
+	if (!m_bIsRTZProtocol) {
+		m_bEnable16Bit = false;
+		m_bEnableDithering = false;
+	}
+
+	if (m_bEnable16Bit) {
+		m_bEnableDithering = true;
+	}
+
+	if (m_bEnableGammaCorrection) {
+		if (m_nGammaValue == 0) {
+			m_pGammaTable16 = gamma::get_table16_default();
+		} else {
+			m_pGammaTable16 = gamma::get_table16(m_nGammaValue);
+		}
+	} else {
+		m_pGammaTable16 = gamma16_10;
+	}
+
 	DEBUG_EXIT
 }
 
@@ -134,6 +153,7 @@ void PixelConfiguration::Print() {
 		printf(" Mapping : %s [%d]\n", PixelType::GetMap(m_map), static_cast<int>(m_map));
 		printf(" T0H     : %.2f [0x%X]\n", PixelType::ConvertTxH(m_nLowCode), m_nLowCode);
 		printf(" T1H     : %.2f [0x%X]\n", PixelType::ConvertTxH(m_nHighCode), m_nHighCode);
+		printf(" Input   : %s%s\n", m_bEnable16Bit ? "16-bit" : "8-bit", m_bEnableDithering ? " [Dithering]" : "");
 	} else {
 		if ((m_type == Type::APA102) || (m_type == Type::SK9822)){
 			printf(" GlobalBrightness: %u\n", m_nGlobalBrightness);
@@ -105,10 +105,12 @@ void WS28xx::SetupBuffers() {
 	m_pBuffer = const_cast<uint8_t*>(FUNC_PREFIX (spi_dma_tx_prepare(&nSize)));
 	assert(m_pBuffer != nullptr);
 
-	const auto nSizeHalf = nSize / 2;
-	assert(m_nBufSize <= nSizeHalf);
+	// Back, front and blackout buffer
+	const auto nSizeThird = (nSize / 3) & static_cast<uint32_t>(~3);
+	assert(m_nBufSize <= nSizeThird);
 
-	m_pBlackoutBuffer = m_pBuffer + (nSizeHalf & static_cast<uint32_t>(~3));
+	m_pFrontBuffer = m_pBuffer + nSizeThird;
+	m_pBlackoutBuffer = m_pFrontBuffer + nSizeThird;
 #else
 	assert(m_pBuffer == nullptr);
 	m_pBuffer = new uint8_t[m_nBufSize];
@@ -142,63 +144,67 @@ void WS28xx::SetupBuffers() {
 	}
 
 	memcpy(m_pBlackoutBuffer, m_pBuffer, m_nBufSize);
+#if defined( USE_SPI_DMA )
+	memcpy(m_pFrontBuffer, m_pBuffer, m_nBufSize);
+	m_bBufferChanged = false;
+#endif
 
 	DEBUG_EXIT
 }
 
 void WS28xx::Update() {
 #if defined( USE_SPI_DMA )
-	assert(!IsUpdating());
-	FUNC_PREFIX(spi_dma_tx_start(m_pBuffer, m_nBufSize));
+	// Only the previous frame can still be in transmission, then Run() starts this frame
+	if (FUNC_PREFIX(spi_dma_tx_is_active())) {
+		m_bUpdatePending = true;
+		return;
+	}
+
+	StartFrame();
 #else
 	FUNC_PREFIX(spi_writenb(reinterpret_cast<char *>(m_pBuffer), m_nBufSize));
 #endif
 }
 
+#if defined( USE_SPI_DMA )
+void WS28xx::StartFrame() {
+	m_bUpdatePending = false;
+
+	if (m_bBufferChanged) {
+		auto *pBuffer = m_pFrontBuffer;
+		m_pFrontBuffer = m_pBuffer;
+		m_pBuffer = pBuffer;
+		m_bBufferChanged = false;
+		m_bBufferSync = true;
+	}
+
+	FUNC_PREFIX(spi_dma_tx_start(m_pFrontBuffer, m_nBufSize));
+}
+#endif
+
 void WS28xx::Blackout() {
 	DEBUG_ENTRY
 
 #if defined( USE_SPI_DMA )
+	// The pending frame is superseded by the blackout
+	m_bUpdatePending = false;
+
 	// Can be called any time.
 	do {
 		asm volatile ("isb" ::: "memory");
 	} while (FUNC_PREFIX(spi_dma_tx_is_active()));
-#endif
-
-	auto *pBuffer = m_pBuffer;
-	m_pBuffer = m_pBlackoutBuffer;
-
-	const auto type = m_PixelConfiguration.GetType();
-	const auto nCount = m_PixelConfiguration.GetCount();
-
-	if ((type == Type::APA102) || (type == Type::SK9822) || (type == Type::P9813)) {
-		memset(m_pBuffer, 0, 4);
 
-		for (uint32_t nPixelIndex = 0; nPixelIndex < nCount; nPixelIndex++) {
-			SetPixel(nPixelIndex, 0, 0, 0);
-		}
+	// The blackout buffer is prepared in SetupBuffers(), the front and back buffer are untouched.
+	FUNC_PREFIX(spi_dma_tx_start(m_pBlackoutBuffer, m_nBufSize));
 
-		if ((type == Type::APA102) || (type == Type::SK9822)) {
-			memset(&m_pBuffer[m_nBufSize - 4], 0xFF, 4);
-		} else {
-			memset(&m_pBuffer[m_nBufSize - 4], 0, 4);
-		}
-	} else {
-		m_pBuffer[0] = 0x00;
-		memset(&m_pBuffer[1], type == Type::WS2801 ? 0 : m_PixelConfiguration.GetLowCode(), m_nBufSize);
-	}
-
-	Update();
-
-#if defined( USE_SPI_DMA )
 	// A blackout may not be interrupted.
 	do {
 		asm volatile ("isb" ::: "memory");
 	} while (FUNC_PREFIX(spi_dma_tx_is_active()));
+#else
+	FUNC_PREFIX(spi_writenb(reinterpret_cast<char *>(m_pBlackoutBuffer), m_nBufSize));
 #endif
 
-	m_pBuffer = pBuffer;
-
 	DEBUG_EXIT
 }
 
@@ -212,6 +218,8 @@ void WS28xx::FullOn() {
 	} while (FUNC_PREFIX(spi_dma_tx_is_active()));
 #endif
 
+	PrepareBuffer();
+
 	const auto type = m_PixelConfiguration.GetType();
 	const auto nCount = m_PixelConfiguration.GetCount();
 
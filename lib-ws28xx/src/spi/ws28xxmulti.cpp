@@ -87,10 +87,17 @@ WS28xxMulti::WS28xxMulti(PixelConfiguration& pixelConfiguration): m_PixelConfigu
 
 	SetupBuffers();
 
+	if (m_PixelConfiguration.IsEnableDithering()) {
+		SetupDither(nLedsPerPixel);
+	}
+
 	printf("Board: %s\n", m_hasCPLD ? "CPLD" : "74-logic");
 }
 
 WS28xxMulti::~WS28xxMulti() {
+	delete[] m_pDither;
+	m_pDither = nullptr;
+
 	m_pBlackoutBuffer = nullptr;
 	m_pBuffer = nullptr;
 
@@ -105,10 +112,12 @@ void WS28xxMulti::SetupBuffers() {
 	m_pBuffer = const_cast<uint8_t*>(FUNC_PREFIX(spi_dma_tx_prepare(&nSize)));
 	assert(m_pBuffer != nullptr);
 
-	const uint32_t nSizeHalf = nSize / 2;
-	assert(m_nBufSize <= nSizeHalf);
+	// Back, front and blackout buffer
+	const auto nSizeThird = (nSize / 3) & static_cast<uint32_t>(~3);
+	assert(m_nBufSize <= nSizeThird);
 
-	m_pBlackoutBuffer = m_pBuffer + (nSizeHalf & static_cast<uint32_t>(~3));
+	m_pFrontBuffer = m_pBuffer + nSizeThird;
+	m_pBlackoutBuffer = m_pFrontBuffer + nSizeThird;
 
 	const auto type = m_PixelConfiguration.GetType();
 	const auto nCount = m_PixelConfiguration.GetCount();
@@ -130,12 +139,16 @@ void WS28xxMulti::SetupBuffers() {
 			}
 		}
 		memcpy(m_pBlackoutBuffer, m_pBuffer, m_nBufSize);
+		memcpy(m_pFrontBuffer, m_pBuffer, m_nBufSize);
 	} else {
 		memset(m_pBuffer, 0, m_nBufSize);
+		memset(m_pFrontBuffer, 0, m_nBufSize);
 		memset(m_pBlackoutBuffer, 0, m_nBufSize);
 	}
 
-	DEBUG_PRINTF("nSize=%x, m_pBuffer=%p, m_pBlackoutBuffer=%p", nSize, m_pBuffer, m_pBlackoutBuffer);
+	m_bBufferChanged = false;
+
+	DEBUG_PRINTF("nSize=%x, m_pBuffer=%p, m_pFrontBuffer=%p, m_pBlackoutBuffer=%p", nSize, m_pBuffer, m_pFrontBuffer, m_pBlackoutBuffer);
 	DEBUG_EXIT
 }
 
@@ -240,6 +253,14 @@ void WS28xxMulti::SetColour(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t n
 }
 
 void WS28xxMulti::SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
+	if (m_pDither != nullptr) {
+		const uint8_t aData[3] = { nRed, nGreen, nBlue };
+		SetPixels(nPortIndex, nPixelIndex, aData, 1, 3);
+		return;
+	}
+
+	PrepareBuffer();
+
 	const auto pGammaTable = m_PixelConfiguration.GetGammaTable();
 
 	nRed = pGammaTable[nRed];
@@ -292,6 +313,14 @@ void WS28xxMulti::SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nR
 }
 
 void WS28xxMulti::SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite) {
+	if (m_pDither != nullptr) {
+		const uint8_t aData[4] = { nRed, nGreen, nBlue, nWhite };
+		SetPixels(nPortIndex, nPixelIndex, aData, 1, 4);
+		return;
+	}
+
+	PrepareBuffer();
+
 	const auto pGammaTable = m_PixelConfiguration.GetGammaTable();
 
 	nRed = pGammaTable[nRed];
@@ -333,14 +362,41 @@ void WS28xxMulti::SetPixel(uint32_t nPortIndex, uint32_t nPixelIndex, uint8_t nR
 }
 
 void WS28xxMulti::Update() {
-	assert(!FUNC_PREFIX(spi_dma_tx_is_active()));
+	if (m_pDither != nullptr) {
+		// The back buffer is not in transmission
+		EncodeDither();
+		m_bBufferChanged = true;
+	}
 
-	FUNC_PREFIX(spi_dma_tx_start(m_pBuffer, m_nBufSize));
+	// Only the previous frame can still be in transmission, then Run() starts this frame
+	if (FUNC_PREFIX(spi_dma_tx_is_active())) {
+		m_bUpdatePending = true;
+		return;
+	}
+
+	StartFrame();
+}
+
+void WS28xxMulti::StartFrame() {
+	m_bUpdatePending = false;
+
+	if (m_bBufferChanged) {
+		auto *pBuffer = m_pFrontBuffer;
+		m_pFrontBuffer = m_pBuffer;
+		m_pBuffer = pBuffer;
+		m_bBufferChanged = false;
+		m_bBufferSync = true;
+	}
+
+	FUNC_PREFIX(spi_dma_tx_start(m_pFrontBuffer, m_nBufSize));
 }
 
 void WS28xxMulti::Blackout() {
 	DEBUG_ENTRY
 
+	// The pending frame is superseded by the blackout
+	m_bUpdatePending = false;
+
 	// Can be called any time.
 	do {
 		asm volatile ("isb" ::: "memory");
@@ -364,9 +420,15 @@ void WS28xxMulti::FullOn() {
 		asm volatile ("isb" ::: "memory");
 	} while (FUNC_PREFIX(spi_dma_tx_is_active()));
 
+	PrepareBuffer();
+
 	const auto type = m_PixelConfiguration.GetType();
 
-	if ((type == Type::APA102) || (type == Type::SK9822) || (type == Type::P9813)) {
+	if (m_pDither != nullptr) {
+		for (uint32_t i = 0; i < m_nDitherBlocks * 8; i++) {
+			m_pDither[i] = 0xFF00;
+		}
+	} else if ((type == Type::APA102) || (type == Type::SK9822) || (type == Type::P9813)) {
 		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
 			SetPixel(nPortIndex, 0, 0, 0, 0, 0);
 
@@ -0,0 +1,356 @@
+/**
+ * @file ws28xxmultibulk.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cassert>
+
+#if defined (__ARM_NEON)
+# include <arm_neon.h>
+#endif
+
+#include "ws28xxmulti.h"
+#include "pixeltype.h"
+#include "gamma/gamma_tables.h"
+
+#include "debug.h"
+
+using namespace pixel;
+
+namespace ws28xxmulti {
+/*
+ * A nibble spread over 4 bytes, one bit per byte.
+ * The most significant bit goes into the first byte.
+ */
+static constexpr uint32_t s_Spread[16] = {
+	0x00000000, 0x01000000, 0x00010000, 0x01010000,
+	0x00000100, 0x01000100, 0x00010100, 0x01010100,
+	0x00000001, 0x01000001, 0x00010001, 0x01010001,
+	0x00000101, 0x01000101, 0x00010101, 0x01010101
+};
+
+/*
+ * The order in which the colour components of a source pixel are written into the SPI buffer.
+ */
+static void get_component_order(const Map map, const uint32_t nChannelsPerPixel, uint8_t *pOrder) {
+	if (nChannelsPerPixel == 4) {
+		// GRBW
+		pOrder[0] = 1; pOrder[1] = 0; pOrder[2] = 2; pOrder[3] = 3;
+		return;
+	}
+
+	switch (map) {
+	case Map::RGB:
+		pOrder[0] = 0; pOrder[1] = 1; pOrder[2] = 2;
+		break;
+	case Map::RBG:
+		pOrder[0] = 0; pOrder[1] = 2; pOrder[2] = 1;
+		break;
+	case Map::GBR:
+		pOrder[0] = 1; pOrder[1] = 2; pOrder[2] = 0;
+		break;
+	case Map::BRG:
+		pOrder[0] = 2; pOrder[1] = 0; pOrder[2] = 1;
+		break;
+	case Map::BGR:
+		pOrder[0] = 2; pOrder[1] = 1; pOrder[2] = 0;
+		break;
+	case Map::GRB:
+	default:
+		pOrder[0] = 1; pOrder[1] = 0; pOrder[2] = 2;
+		break;
+	}
+}
+
+/*
+ * Byte p of x is the colour value for port p.
+ * Returns 8 bytes, byte j holds bit (7 - j) of each port.
+ */
+static inline uint64_t transpose(uint64_t x) {
+	uint64_t t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return __builtin_bswap64(x);
+}
+
+#if defined (__ARM_NEON)
+static inline void transpose2(const uint64_t x0, const uint64_t x1, uint8_t *pOut) {
+	auto x = vcombine_u64(vcreate_u64(x0), vcreate_u64(x1));
+	uint64x2_t t;
+
+	t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, 7)), vdupq_n_u64(0x00AA00AA00AA00AAULL));
+	x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, 7)));
+	t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, 14)), vdupq_n_u64(0x0000CCCC0000CCCCULL));
+	x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, 14)));
+	t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, 28)), vdupq_n_u64(0x00000000F0F0F0F0ULL));
+	x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, 28)));
+
+	vst1q_u8(pOut, vrev64q_u8(vreinterpretq_u8_u64(x)));
+}
+#endif
+
+/*
+ * Two consecutive 8x8 bit blocks into the SPI buffer.
+ */
+static inline void store2(const uint64_t x0, const uint64_t x1, uint8_t *pBuffer) {
+#if defined (__ARM_NEON)
+	transpose2(x0, x1, pBuffer);
+#else
+	const auto y0 = transpose(x0);
+	const auto y1 = transpose(x1);
+	for (uint32_t j = 0; j < 8; j++) {
+		pBuffer[j] = static_cast<uint8_t>(y0 >> (j * 8));
+		pBuffer[8 + j] = static_cast<uint8_t>(y1 >> (j * 8));
+	}
+#endif
+}
+
+static inline void store1(const uint64_t x, uint8_t *pBuffer) {
+	const auto y = transpose(x);
+	for (uint32_t j = 0; j < 8; j++) {
+		pBuffer[j] = static_cast<uint8_t>(y >> (j * 8));
+	}
+}
+
+/*
+ * Ordered temporal dithering.
+ * The thresholds of a row are the 16 steps of the 8-bit fraction in bit-reversed order, with a different phase per port.
+ * Each colour component starts at its own row and advances one row per frame,
+ * so after 16 frames every component has been compared with every threshold once.
+ * The maximum 0xFF00 + 248 does not overflow 16 bits.
+ */
+static constexpr uint16_t s_Threshold[16][8] __attribute__ ((aligned (16))) = {
+	{   8, 168,  88, 248,  40, 152, 120, 200 },
+	{ 136, 104, 216,   8, 168,  88, 248,  40 },
+	{  72, 232,  56, 136, 104, 216,   8, 168 },
+	{ 200,  24, 184,  72, 232,  56, 136, 104 },
+	{  40, 152, 120, 200,  24, 184,  72, 232 },
+	{ 168,  88, 248,  40, 152, 120, 200,  24 },
+	{ 104, 216,   8, 168,  88, 248,  40, 152 },
+	{ 232,  56, 136, 104, 216,   8, 168,  88 },
+	{  24, 184,  72, 232,  56, 136, 104, 216 },
+	{ 152, 120, 200,  24, 184,  72, 232,  56 },
+	{  88, 248,  40, 152, 120, 200,  24, 184 },
+	{ 216,   8, 168,  88, 248,  40, 152, 120 },
+	{  56, 136, 104, 216,   8, 168,  88, 248 },
+	{ 184,  72, 232,  56, 136, 104, 216,   8 },
+	{ 120, 200,  24, 184,  72, 232,  56, 136 },
+	{ 248,  40, 152, 120, 200,  24, 184,  72 }
+};
+}  // namespace ws28xxmulti
+
+using namespace ws28xxmulti;
+
+void WS28xxMulti::SetPixels(uint32_t nPortIndex, uint32_t nPixelIndex, const uint8_t *pData, uint32_t nPixels, uint32_t nChannelsPerPixel) {
+	assert(nPortIndex < 8);
+	assert(pData != nullptr);
+	assert(IsBulkSupported(nChannelsPerPixel));
+	assert((reinterpret_cast<uintptr_t>(m_pBuffer) & 0x3) == 0);
+
+	uint8_t aOrder[4];
+	get_component_order(m_PixelConfiguration.GetMap(), nChannelsPerPixel, aOrder);
+
+	if (m_pDither != nullptr) {
+		const auto *pGammaTable16 = m_PixelConfiguration.GetGammaTable16();
+		auto *pDither = &m_pDither[(nPixelIndex * nChannelsPerPixel * 8U) + nPortIndex];
+
+		for (uint32_t i = 0; i < nPixels; i++) {
+			for (uint32_t c = 0; c < nChannelsPerPixel; c++) {
+				*pDither = gamma::apply16(pGammaTable16, pData[aOrder[c]]);
+				pDither += 8;
+			}
+			pData += nChannelsPerPixel;
+		}
+
+		return;
+	}
+
+	PrepareBuffer();
+
+	const auto *pGammaTable = m_PixelConfiguration.GetGammaTable();
+	const auto nMask = ~(0x01010101U << nPortIndex);
+	auto *pBuffer = reinterpret_cast<uint32_t *>(&m_pBuffer[nPixelIndex * nChannelsPerPixel * 8U]);
+
+	for (uint32_t i = 0; i < nPixels; i++) {
+		__builtin_prefetch(&pData[nChannelsPerPixel]);
+		for (uint32_t c = 0; c < nChannelsPerPixel; c++) {
+			const auto nValue = pGammaTable[pData[aOrder[c]]];
+			pBuffer[0] = (pBuffer[0] & nMask) | (s_Spread[nValue >> 4] << nPortIndex);
+			pBuffer[1] = (pBuffer[1] & nMask) | (s_Spread[nValue & 0xF] << nPortIndex);
+			pBuffer += 2;
+		}
+		pData += nChannelsPerPixel;
+	}
+}
+
+void WS28xxMulti::SetFrame(const uint8_t * const pData[8], uint32_t nPixelIndex, uint32_t nPixels, uint32_t nChannelsPerPixel) {
+	assert(pData != nullptr);
+	assert(IsBulkSupported(nChannelsPerPixel));
+
+	if (m_pDither != nullptr) {
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			if (pData[nPortIndex] != nullptr) {
+				SetPixels(nPortIndex, nPixelIndex, pData[nPortIndex], nPixels, nChannelsPerPixel);
+			} else {
+				auto *pDither = &m_pDither[(nPixelIndex * nChannelsPerPixel * 8U) + nPortIndex];
+				for (uint32_t i = 0; i < nPixels * nChannelsPerPixel; i++) {
+					*pDither = 0;
+					pDither += 8;
+				}
+			}
+		}
+		return;
+	}
+
+	PrepareBuffer();
+
+	uint8_t aOrder[4];
+	get_component_order(m_PixelConfiguration.GetMap(), nChannelsPerPixel, aOrder);
+
+	const auto *pGammaTable = m_PixelConfiguration.GetGammaTable();
+	auto *pBuffer = &m_pBuffer[nPixelIndex * nChannelsPerPixel * 8U];
+
+	/*
+	 * Each colour component of a pixel is one 8x8 bit block:
+	 * 8 ports times 8 bits. The blocks are consecutive in the SPI buffer.
+	 */
+	const auto nBlocks = nPixels * nChannelsPerPixel;
+	uint32_t nOffset = 0;
+	uint32_t nComponent = 0;
+
+	uint64_t aBlock[2];
+	uint32_t nBlockIndex = 0;
+
+	for (uint32_t nBlock = 0; nBlock < nBlocks; nBlock++) {
+		const auto nSlot = nOffset + aOrder[nComponent];
+		uint64_t x = 0;
+
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			if (pData[nPortIndex] != nullptr) {
+				x |= static_cast<uint64_t>(pGammaTable[pData[nPortIndex][nSlot]]) << (nPortIndex * 8);
+			}
+		}
+
+		if (++nComponent == nChannelsPerPixel) {
+			nComponent = 0;
+			nOffset += nChannelsPerPixel;
+		}
+
+		aBlock[nBlockIndex++] = x;
+
+		if (nBlockIndex == 2) {
+			store2(aBlock[0], aBlock[1], pBuffer);
+			pBuffer += 16;
+			nBlockIndex = 0;
+		}
+	}
+
+	if (nBlockIndex != 0) {
+		store1(aBlock[0], pBuffer);
+	}
+}
+
+void WS28xxMulti::SetPixels16(uint32_t nPortIndex, uint32_t nPixelIndex, const uint8_t *pData, uint32_t nPixels, uint32_t nChannelsPerPixel) {
+	assert(nPortIndex < 8);
+	assert(pData != nullptr);
+	assert(m_pDither != nullptr);
+	assert(((nPixelIndex + nPixels) * nChannelsPerPixel) <= m_nDitherBlocks);
+
+	uint8_t aOrder[4];
+	get_component_order(m_PixelConfiguration.GetMap(), nChannelsPerPixel, aOrder);
+
+	const auto *pGammaTable16 = m_PixelConfiguration.GetGammaTable16();
+	auto *pDither = &m_pDither[(nPixelIndex * nChannelsPerPixel * 8U) + nPortIndex];
+
+	for (uint32_t i = 0; i < nPixels; i++) {
+		for (uint32_t c = 0; c < nChannelsPerPixel; c++) {
+			const auto *pSlot = &pData[aOrder[c] * 2U];
+			*pDither = gamma::apply16(pGammaTable16, static_cast<uint16_t>((pSlot[0] << 8) | pSlot[1]));
+			pDither += 8;
+		}
+		pData += nChannelsPerPixel * 2U;
+	}
+}
+
+void WS28xxMulti::SetupDither(uint32_t nLedsPerPixel) {
+	DEBUG_ENTRY
+
+	assert(m_PixelConfiguration.IsRTZProtocol());
+
+	m_nDitherBlocks = m_PixelConfiguration.GetCount() * nLedsPerPixel;
+	m_pDither = new uint16_t[m_nDitherBlocks * 8];
+	assert(m_pDither != nullptr);
+
+	for (uint32_t i = 0; i < m_nDitherBlocks * 8; i++) {
+		m_pDither[i] = 0;
+	}
+
+	DEBUG_PRINTF("m_nDitherBlocks=%u", m_nDitherBlocks);
+	DEBUG_EXIT
+}
+
+/**
+ * The 8.8 fixed point pixels, plus the thresholds of this frame, into the back buffer.
+ * All 8 ports of a colour component are handled together, as one 8x8 bit block.
+ */
+void WS28xxMulti::EncodeDither() {
+	const auto *pDither = m_pDither;
+	auto *pBuffer = m_pBuffer;
+	auto nRow = m_nDitherFrame++;
+
+	uint64_t aBlock[2];
+	uint32_t nBlockIndex = 0;
+
+	for (uint32_t nBlock = 0; nBlock < m_nDitherBlocks; nBlock++) {
+		const auto *pThreshold = s_Threshold[nRow++ & 0xF];
+#if defined (__ARM_NEON)
+		const auto v = vaddq_u16(vld1q_u16(pDither), vld1q_u16(pThreshold));
+		aBlock[nBlockIndex++] = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(v, 8)), 0);
+#else
+		uint64_t x = 0;
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			x |= static_cast<uint64_t>((pDither[nPortIndex] + pThreshold[nPortIndex]) >> 8) << (nPortIndex * 8);
+		}
+		aBlock[nBlockIndex++] = x;
+#endif
+		pDither += 8;
+
+		if (nBlockIndex == 2) {
+			store2(aBlock[0], aBlock[1], pBuffer);
+			pBuffer += 16;
+			nBlockIndex = 0;
+		}
+	}
+
+	if (nBlockIndex != 0) {
+		store1(aBlock[0], pBuffer);
+	}
+}
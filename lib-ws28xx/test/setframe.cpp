@@ -0,0 +1,220 @@
+/**
+ * @file setframe.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Compares WS28xxMulti::SetFrame (all 8 ports in one pass) byte for byte
+ * with WS28xxMulti::SetPixels per port, with and without dithering,
+ * and times both for a full frame.
+ *
+ * Only the bulk encoders (ws28xxmultibulk.cpp) are built. The constructor and Update()
+ * below replace the ones of ws28xxmulti.cpp, there is no SPI.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "ws28xxmulti.h"
+#include "pixelconfiguration.h"
+#include "pixeltype.h"
+
+using namespace pixel;
+
+static uint8_t *s_pBuffer;
+static uint16_t *s_pDither;
+
+WS28xxMulti *WS28xxMulti::s_pThis;
+
+WS28xxMulti::WS28xxMulti(PixelConfiguration& pixelConfiguration) : m_PixelConfiguration(pixelConfiguration) {
+	s_pThis = this;
+
+	uint32_t nLedsPerPixel;
+	m_PixelConfiguration.Validate(nLedsPerPixel);
+
+	m_nBufSize = m_PixelConfiguration.GetCount() * nLedsPerPixel * 8U;
+	m_pBuffer = new uint8_t[m_nBufSize];
+	m_pFrontBuffer = m_pBuffer;
+	s_pBuffer = m_pBuffer;
+
+	for (uint32_t i = 0; i < m_nBufSize; i++) {
+		m_pBuffer[i] = static_cast<uint8_t>(i * 7);
+	}
+
+	if (m_PixelConfiguration.IsEnableDithering()) {
+		SetupDither(nLedsPerPixel);
+	}
+
+	s_pDither = m_pDither;
+}
+
+WS28xxMulti::~WS28xxMulti() {
+	delete[] m_pDither;
+	delete[] m_pBuffer;
+	s_pThis = nullptr;
+}
+
+void WS28xxMulti::Update() {
+	if (m_pDither != nullptr) {
+		EncodeDither();
+	}
+}
+
+static constexpr uint32_t COUNT = 170;
+static constexpr uint32_t MAX_CHANNELS = 4;
+
+static uint8_t s_Data[8][COUNT * MAX_CHANNELS];
+static const uint8_t s_Off[COUNT * MAX_CHANNELS] = {};
+
+static uint32_t s_errors;
+
+static void check(const char *pName, Type type, Map map, uint32_t nPixelIndex, uint32_t nPixels, bool isOk) {
+	if (!isOk) {
+		if (s_errors < 10) {
+			printf("%s type=%s map=%u pixel=%u pixels=%u\n", pName, PixelType::GetType(type), static_cast<uint32_t>(map), nPixelIndex, nPixels);
+		}
+		s_errors++;
+	}
+}
+
+static void test(Type type, Map map, bool bDithering) {
+	PixelConfiguration pixelConfiguration;
+
+	pixelConfiguration.SetType(type);
+	pixelConfiguration.SetCount(COUNT);
+	pixelConfiguration.SetMap(map);
+	pixelConfiguration.SetEnableGammaCorrection(true);
+	pixelConfiguration.SetEnableDithering(bDithering);
+
+	WS28xxMulti frame(pixelConfiguration);
+	auto *pFrameBuffer = s_pBuffer;
+	auto *pFrameDither = s_pDither;
+
+	WS28xxMulti pixels(pixelConfiguration);
+	auto *pPixelsBuffer = s_pBuffer;
+	auto *pPixelsDither = s_pDither;
+
+	const auto nChannelsPerPixel = (type == Type::SK6812W) ? 4U : 3U;
+	const auto nBufSize = COUNT * nChannelsPerPixel * 8U;
+
+	if (!frame.IsBulkSupported(nChannelsPerPixel)) {
+		return;
+	}
+
+	for (uint32_t n = 0; n < 200; n++) {
+		const uint8_t *pData[8];
+
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			for (uint32_t i = 0; i < COUNT * nChannelsPerPixel; i++) {
+				s_Data[nPortIndex][i] = static_cast<uint8_t>(rand());
+			}
+			pData[nPortIndex] = (rand() % 4) == 0 ? nullptr : s_Data[nPortIndex];
+		}
+
+		const auto nPixelIndex = static_cast<uint32_t>(rand()) % COUNT;
+		const auto nPixels = 1U + static_cast<uint32_t>(rand()) % (COUNT - nPixelIndex);
+
+		frame.SetFrame(pData, nPixelIndex, nPixels, nChannelsPerPixel);
+
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			pixels.SetPixels(nPortIndex, nPixelIndex, pData[nPortIndex] != nullptr ? pData[nPortIndex] : s_Off, nPixels, nChannelsPerPixel);
+		}
+
+		if (frame.IsDithering()) {
+			check("dither", type, map, nPixelIndex, nPixels, memcmp(pFrameDither, pPixelsDither, nBufSize * sizeof(uint16_t)) == 0);
+			frame.Update();
+			pixels.Update();
+		}
+
+		check("buffer", type, map, nPixelIndex, nPixels, memcmp(pFrameBuffer, pPixelsBuffer, nBufSize) == 0);
+	}
+}
+
+/*
+ * Microseconds per frame of 8 ports
+ */
+static void timing(Type type) {
+	static constexpr uint32_t ROUNDS = 2000;
+
+	PixelConfiguration pixelConfiguration;
+
+	pixelConfiguration.SetType(type);
+	pixelConfiguration.SetCount(COUNT);
+	pixelConfiguration.SetEnableGammaCorrection(true);
+
+	WS28xxMulti ws28xxMulti(pixelConfiguration);
+
+	const auto nChannelsPerPixel = (type == Type::SK6812W) ? 4U : 3U;
+	const uint8_t *pData[8];
+
+	for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+		pData[nPortIndex] = s_Data[nPortIndex];
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (uint32_t n = 0; n < ROUNDS; n++) {
+		for (uint32_t nPortIndex = 0; nPortIndex < 8; nPortIndex++) {
+			ws28xxMulti.SetPixels(nPortIndex, 0, pData[nPortIndex], COUNT, nChannelsPerPixel);
+		}
+	}
+
+	const auto nPixels = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / (ROUNDS * 1000);
+
+	start = std::chrono::steady_clock::now();
+
+	for (uint32_t n = 0; n < ROUNDS; n++) {
+		ws28xxMulti.SetFrame(pData, 0, COUNT, nChannelsPerPixel);
+	}
+
+	const auto nFrame = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / (ROUNDS * 1000);
+
+	printf("%s x 8 x %u: SetPixels %.1f us, SetFrame %.1f us (%.2fx)\n", PixelType::GetType(type), COUNT, nPixels, nFrame, nPixels / nFrame);
+}
+
+int main(int argc, char **argv) {
+	(void) argc;
+
+	srand(1);
+
+	const Type types[] = { Type::WS2812B, Type::SK6812W, Type::WS2801 };
+	const Map maps[] = { Map::RGB, Map::RBG, Map::GRB, Map::GBR, Map::BRG, Map::BGR };
+
+	for (const auto type : types) {
+		for (const auto map : maps) {
+			test(type, map, false);
+			test(type, map, true);
+		}
+	}
+
+	timing(Type::WS2812B);
+	timing(Type::SK6812W);
+
+	printf("%s: %u errors\n", argv[0], s_errors);
+
+	return s_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -292,6 +292,7 @@ void WS28xxDisplay7Segment::RenderSegment(bool bOnOff, uint32_t nCurrentDigitBas
 }
 
 void WS28xxDisplay7Segment::Show() {
+	m_pWS28xx->Run();
 	m_pWS28xx->Update();
 }
 
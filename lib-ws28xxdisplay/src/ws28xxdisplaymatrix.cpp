@@ -215,6 +215,9 @@ void WS28xxDisplayMatrix::Cls() {
 }
 
 void WS28xxDisplayMatrix::Show() {
+	// Starts the previous frame when it was pending
+	m_pWS28xx->Run();
+
 	if (m_bUpdateNeeded) {
 		m_bUpdateNeeded = false;
 		m_pWS28xx->Update();
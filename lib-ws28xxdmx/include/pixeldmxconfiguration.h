@@ -73,6 +73,22 @@ public:
 		return m_nDmxStartAddress;
 	}
 
+	void SetMatrixColumns(uint16_t nMatrixColumns) {
+		m_nMatrixColumns = nMatrixColumns;
+	}
+
+	uint32_t GetMatrixColumns() const {
+		return m_nMatrixColumns;
+	}
+
+	void SetMatrixZigZag(bool bMatrixZigZag) {
+		m_bMatrixZigZag = bMatrixZigZag;
+	}
+
+	bool IsMatrixZigZag() const {
+		return m_bMatrixZigZag;
+	}
+
 	void Validate(uint32_t nPortsMax, uint32_t& nLedsPerPixel, pixeldmxconfiguration::PortInfo& portInfo);
 
 	void Print();
@@ -83,6 +99,8 @@ private:
 	uint32_t m_nGroups { pixel::defaults::COUNT };
 	uint32_t m_nUniverses;
 	uint16_t m_nDmxStartAddress { 1 };
+	uint16_t m_nMatrixColumns { 0 };
+	bool m_bMatrixZigZag { false };
 };
 
 #endif /* PIXELDMXCONFIGURATION_H_ */
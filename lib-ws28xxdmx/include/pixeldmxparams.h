@@ -52,6 +52,7 @@ struct Params {
 	uint8_t nLowCode;										///< 1	  21
 	uint8_t nHighCode;										///< 1	  22
 	uint16_t nStartUniverse[pixeldmxparams::MAX_PORTS];		///< 16   38
+	uint16_t nMatrixColumns;								///< 2	  40
 }__attribute__((packed));
 
 static_assert(sizeof(struct Params) <= 64, "struct Params is too large");
@@ -70,7 +71,13 @@ struct Mask {
 	static constexpr auto LOW_CODE = (1U << 10);
 	static constexpr auto HIGH_CODE = (1U << 11);
 	static constexpr auto START_UNI_PORT_1 = (1U << 12);
+	static constexpr auto MATRIX_COLUMNS = (1U << 20);
+	static constexpr auto MATRIX_ZIGZAG = (1U << 21);
+	static constexpr auto INPUT_16BIT = (1U << 22);
+	static constexpr auto DITHERING = (1U << 23);
 };
+
+static_assert((Mask::START_UNI_PORT_1 << MAX_PORTS) <= Mask::MATRIX_COLUMNS, "START_UNI_PORT overlaps MATRIX_COLUMNS");
 }  // pixeldmxparams name
 
 class PixelDmxParamsStore {
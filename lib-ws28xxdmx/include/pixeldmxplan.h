@@ -0,0 +1,113 @@
+/**
+ * @file pixeldmxplan.h
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef PIXELDMXPLAN_H_
+#define PIXELDMXPLAN_H_
+
+#include <cstdint>
+
+#include "pixeldmxconfiguration.h"
+
+namespace pixeldmxplan {
+static constexpr uint32_t MAX_UNIVERSES = 4;
+
+/**
+ * nPixels consecutive pixels of a universe, starting at DMX slot nSlot.
+ * Pixel p goes to group (nGroupIndex + p * nStep).
+ */
+struct Run {
+	uint16_t nSlot;
+	uint16_t nGroupIndex;
+	uint16_t nPixels;
+	int16_t nStep;
+};
+}  // namespace pixeldmxplan
+
+/**
+ * The mapping from DMX slots to pixel groups, compiled once from the configuration.
+ * The render path walks the runs of a universe instead of evaluating the layout per pixel.
+ */
+class PixelDmxPlan {
+public:
+	PixelDmxPlan(const PixelDmxConfiguration& pixelDmxConfiguration, uint32_t nSlotsPerPixel, const pixeldmxconfiguration::PortInfo& portInfo, uint32_t nSlotOffset = 0);
+	~PixelDmxPlan();
+
+	const pixeldmxplan::Run *GetRuns(uint32_t nUniverse, uint32_t& nRuns) const {
+		if (nUniverse >= pixeldmxplan::MAX_UNIVERSES) {
+			nRuns = 0;
+			return nullptr;
+		}
+
+		nRuns = m_nRunIndex[nUniverse + 1] - m_nRunIndex[nUniverse];
+		return &m_pRuns[m_nRunIndex[nUniverse]];
+	}
+
+	/**
+	 * The pixels nBegin..nEnd-1 of the run have at least one slot in nFirst..nLast,
+	 * and all their slots are below nLength.
+	 */
+	bool Clip(const pixeldmxplan::Run& run, uint32_t nLength, uint32_t nFirst, uint32_t nLast, uint32_t& nBegin, uint32_t& nEnd) const {
+		const auto nSlotEnd = run.nSlot + run.nPixels * m_nSlotsPerPixel;
+
+		if ((nFirst >= nSlotEnd) || (nLast < run.nSlot) || (nLength < (run.nSlot + m_nSlotsPerPixel))) {
+			return false;
+		}
+
+		nBegin = (nFirst > run.nSlot) ? (nFirst - run.nSlot) / m_nSlotsPerPixel : 0;
+		nEnd = 1U + (nLast - run.nSlot) / m_nSlotsPerPixel;
+
+		const auto nFit = (nLength - run.nSlot) / m_nSlotsPerPixel;
+
+		if (nEnd > nFit) {
+			nEnd = nFit;
+		}
+
+		if (nEnd > run.nPixels) {
+			nEnd = run.nPixels;
+		}
+
+		return nBegin < nEnd;
+	}
+
+	void Print();
+
+private:
+	uint32_t Build(pixeldmxplan::Run *pRuns);
+	uint32_t GetGroupIndex(uint32_t nGroup) const;
+
+private:
+	uint32_t m_nSlotsPerPixel;
+	uint32_t m_nGroups;
+	uint32_t m_nUniverses;
+	uint32_t m_nSlotOffset;
+	uint32_t m_nMatrixColumns;
+	bool m_bMatrixZigZag;
+	uint32_t m_nBeginIndex[pixeldmxplan::MAX_UNIVERSES];
+	uint32_t m_nRunIndex[pixeldmxplan::MAX_UNIVERSES + 1];
+	pixeldmxplan::Run *m_pRuns { nullptr };
+};
+
+#endif /* PIXELDMXPLAN_H_ */
@@ -33,6 +33,7 @@
 
 #include "ws28xx.h"
 #include "pixeldmxconfiguration.h"
+#include "pixeldmxplan.h"
 #include "pixelpatterns.h"
 
 #include "pixeldmxhandler.h"
@@ -50,6 +51,14 @@ public:
 	void Blackout(bool bBlackout) override;
 	void FullOn() override;
 
+	/**
+	 * Starts the frame that is pending while the previous one was in transmission.
+	 * To be called from the main loop.
+	 */
+	void Run() {
+		m_pWS28xx->Run();
+	}
+
 	void Print() override {
 		m_pixelDmxConfiguration.Print();
 	}
@@ -103,6 +112,17 @@ public:
 		return s_pThis;
 	}
 
+private:
+	/**
+	 * The DMX start address only applies when all the pixels fit in one universe.
+	 */
+	uint32_t GetSlotOffset() const {
+		if (m_pixelDmxConfiguration.GetGroups() < m_PortInfo.nBeginIndexPortId1) {
+			return static_cast<uint32_t>(m_nDmxStartAddress - 1);
+		}
+		return 0;
+	}
+
 private:
 	PixelDmxConfiguration m_pixelDmxConfiguration;
 	pixeldmxconfiguration::PortInfo m_PortInfo;
@@ -112,6 +132,7 @@ private:
 	uint16_t m_nDmxFootprint;
 
 	WS28xx *m_pWS28xx { nullptr };
+	PixelDmxPlan *m_pPixelDmxPlan { nullptr };
 	PixelDmxStore *m_pWS28xxDmxStore { nullptr };
 	PixelDmxHandler *m_pPixelDmxHandler { nullptr };
 
@@ -33,12 +33,24 @@
 #include "ws28xxmulti.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixeldmxplan.h"
 #include "pixelpatterns.h"
 
 #include "pixeldmxhandler.h"
 
-namespace ws28xxdmxmulti {
+/*
+ * With ARM_ALLOW_MULTI_CORE the pixel encoding runs on a secondary core.
+ * SetDataRange copies the changed slots into a ring, the worker core renders them.
+ */
+#if defined (H3) && defined (ARM_ALLOW_MULTI_CORE)
+# define WS28XXDMXMULTI_SMP
+#endif
 
+namespace ws28xxdmxmulti {
+#if !defined (CONFIG_PIXELDMX_SMP_CORE)
+# define CONFIG_PIXELDMX_SMP_CORE	1
+#endif
+static constexpr uint32_t SMP_CORE = CONFIG_PIXELDMX_SMP_CORE;
 }  // namespace ws28xxdmxmulti
 
 class WS28xxDmxMulti final: public LightSet {
@@ -50,10 +62,32 @@ public:
 	void Stop(uint32_t nPortIndex) override;
 
 	void SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength) override;
+	void SetDataRange(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) override;
 
 	void Blackout(bool bBlackout) override;
 	void FullOn() override;
 
+	/**
+	 * Starts the frame that is pending while the previous one was in transmission.
+	 * To be called from the main loop. With SMP the worker core does this itself.
+	 */
+	void Run() {
+#if defined (WS28XXDMXMULTI_SMP)
+		if (m_bSmp && !m_bSuspended) {
+			return;
+		}
+#endif
+		m_pWS28xxMulti->Run();
+	}
+
+	/**
+	 * With SMP the output is owned by the worker core. Suspend() returns when the
+	 * worker core has stopped using the output, then the calling core can drive
+	 * WS28xxMulti directly (test patterns, reboot). Resume() hands it back.
+	 */
+	void Suspend();
+	void Resume();
+
 	void Print() override {
 		m_pixelDmxConfiguration.Print();
 	}
@@ -90,6 +124,13 @@ public:
 		return m_nChannelsPerPixel;
 	}
 
+	/**
+	 * With 16-bit input each colour component takes two slots
+	 */
+	uint32_t GetSlotsPerPixel() const {
+		return m_nSlotsPerPixel;
+	}
+
 	void SetPixelDmxHandler(PixelDmxHandler *pPixelDmxHandler) {
 		m_pPixelDmxHandler = pPixelDmxHandler;
 	}
@@ -107,16 +148,36 @@ public:
 		return 0;
 	}
 
+	static WS28xxDmxMulti *Get() {
+		return s_pThis;
+	}
+
+private:
+	void Render(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast);
+#if defined (WS28XXDMXMULTI_SMP)
+	void SmpCommand(uint32_t nCommand);
+	static void SmpWork();
+#endif
+
 private:
 	PixelDmxConfiguration m_pixelDmxConfiguration;
 	pixeldmxconfiguration::PortInfo m_PortInfo;
 	uint32_t m_nChannelsPerPixel;
+	uint32_t m_nSlotsPerPixel;
 
 	WS28xxMulti *m_pWS28xxMulti { nullptr };
+	PixelDmxPlan *m_pPixelDmxPlan { nullptr };
 	PixelDmxHandler *m_pPixelDmxHandler { nullptr };
 
 	uint32_t m_bIsStarted { 0 };
+	uint32_t m_nRenderAll { ~0U };
 	bool m_bBlackout { false };
+#if defined (WS28XXDMXMULTI_SMP)
+	bool m_bSmp { false };			///< The worker core is running
+	bool m_bSuspended { false };
+#endif
+
+	static WS28xxDmxMulti *s_pThis;
 };
 
 #endif /* WS28XXDMXMULTI_H_ */
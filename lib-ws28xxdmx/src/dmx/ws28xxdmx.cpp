@@ -33,6 +33,7 @@
 #include "lightset.h"
 
 #include "pixeldmxconfiguration.h"
+#include "pixeldmxplan.h"
 
 #include "debug.h"
 
@@ -47,6 +48,10 @@ WS28xxDmx::WS28xxDmx(PixelDmxConfiguration& pixelDmxConfiguration): m_pixelDmxCo
 	assert(s_pThis == nullptr);
 	s_pThis = this;
 
+	// The 16-bit input and dithering are implemented for the multi-port output only
+	m_pixelDmxConfiguration.SetEnable16Bit(false);
+	m_pixelDmxConfiguration.SetEnableDithering(false);
+
 	m_pixelDmxConfiguration.Validate(1 , m_nChannelsPerPixel, m_PortInfo);
 
 	m_pWS28xx = new WS28xx(m_pixelDmxConfiguration);
@@ -57,12 +62,18 @@ WS28xxDmx::WS28xxDmx(PixelDmxConfiguration& pixelDmxConfiguration): m_pixelDmxCo
 	m_nDmxStartAddress = m_pixelDmxConfiguration.GetDmxStartAddress();
 	m_nDmxFootprint = static_cast<uint16_t>(m_nChannelsPerPixel * m_pixelDmxConfiguration.GetGroups());
 
+	m_pPixelDmxPlan = new PixelDmxPlan(m_pixelDmxConfiguration, m_nChannelsPerPixel, m_PortInfo, GetSlotOffset());
+	assert(m_pPixelDmxPlan != nullptr);
+
 	DEBUG_EXIT
 }
 
 WS28xxDmx::~WS28xxDmx() {
 	DEBUG_ENTRY
 
+	delete m_pPixelDmxPlan;
+	m_pPixelDmxPlan = nullptr;
+
 	delete m_pWS28xx;
 	m_pWS28xx = nullptr;
 
@@ -97,60 +108,41 @@ void WS28xxDmx::SetData(uint32_t nPortIndex, const uint8_t *pData, uint32_t nLen
 	assert(pData != nullptr);
 	assert(nLength <= dmx::UNIVERSE_SIZE);
 
+#if !defined (USE_SPI_DMA)
 	if (m_pWS28xx->IsUpdating()) {
 		return;
 	}
+#endif
 
-	uint32_t d = 0;
-	uint32_t beginIndex, endIndex;
+	uint32_t nRuns;
+	const auto *pRun = m_pPixelDmxPlan->GetRuns(nPortIndex & 0x03, nRuns);
+	const auto nGroupingCount = m_pixelDmxConfiguration.GetGroupingCount();
 
-	const auto nGroups = m_pixelDmxConfiguration.GetGroups();
+	for (uint32_t nRun = 0; nRun < nRuns; nRun++, pRun++) {
+		uint32_t nBegin, nEnd;
 
-	switch (nPortIndex & 0x03) {
-	case 0:
-		beginIndex = 0;
-		endIndex = std::min(nGroups, (nLength / m_nChannelsPerPixel));
-		if (nGroups < m_PortInfo.nBeginIndexPortId1) {
-			d = static_cast<uint32_t>(m_pixelDmxConfiguration.GetDmxStartAddress() - 1);
+		if (!m_pPixelDmxPlan->Clip(*pRun, nLength, 0, dmx::UNIVERSE_SIZE - 1, nBegin, nEnd)) {
+			continue;
 		}
-		break;
-	case 1:
-		beginIndex = m_PortInfo.nBeginIndexPortId1;
-		endIndex = std::min(nGroups, (beginIndex + (nLength /  m_nChannelsPerPixel)));
-		break;
-	case 2:
-		beginIndex = m_PortInfo.nBeginIndexPortId2;
-		endIndex = std::min(nGroups, (beginIndex + (nLength /  m_nChannelsPerPixel)));
-		break;
-	case 3:
-		beginIndex = m_PortInfo.nBeginIndexPortId3;
-		endIndex = std::min(nGroups, (beginIndex + (nLength /  m_nChannelsPerPixel)));
-		break;
-	default:
-		__builtin_unreachable();
-		break;
-	}
 
-	const auto nGroupingCount = m_pixelDmxConfiguration.GetGroupingCount();
-
-	if (m_nChannelsPerPixel == 3) {
-		for (auto j = beginIndex; (j < endIndex) && (d < nLength); j++) {
-			auto const nPixelIndexStart = (j * nGroupingCount);
-			__builtin_prefetch(&pData[d]);
-			for (uint32_t k = 0; k < nGroupingCount; k++) {
-				m_pWS28xx->SetPixel(nPixelIndexStart + k, pData[d], pData[d + 1], pData[d + 2]);
+		const auto *pSlot = &pData[pRun->nSlot + nBegin * m_nChannelsPerPixel];
+		auto nGroupIndex = static_cast<int32_t>(pRun->nGroupIndex) + static_cast<int32_t>(nBegin) * pRun->nStep;
+
+		for (auto i = nBegin; i < nEnd; i++) {
+			const auto nPixelIndexStart = static_cast<uint32_t>(nGroupIndex) * nGroupingCount;
+			__builtin_prefetch(&pSlot[m_nChannelsPerPixel]);
+			if (m_nChannelsPerPixel == 3) {
+				for (uint32_t k = 0; k < nGroupingCount; k++) {
+					m_pWS28xx->SetPixel(nPixelIndexStart + k, pSlot[0], pSlot[1], pSlot[2]);
+				}
+			} else {
+				assert(m_nChannelsPerPixel == 4);
+				for (uint32_t k = 0; k < nGroupingCount; k++) {
+					m_pWS28xx->SetPixel(nPixelIndexStart + k, pSlot[0], pSlot[1], pSlot[2], pSlot[3]);
+				}
 			}
-			d = d + 3;
-		}
-	} else {
-		assert(m_nChannelsPerPixel == 4);
-		for (auto j = beginIndex; (j < endIndex) && (d < nLength); j++) {
-			auto const nPixelIndexStart = (j * nGroupingCount);
-			__builtin_prefetch(&pData[d]);
-			for (uint32_t k = 0; k < nGroupingCount; k++) {
-				m_pWS28xx->SetPixel(nPixelIndexStart + k, pData[d], pData[d + 1], pData[d + 2], pData[d + 3]);
-			}
-			d = d + 4;
+			pSlot += m_nChannelsPerPixel;
+			nGroupIndex += pRun->nStep;
 		}
 	}
 
@@ -200,6 +192,11 @@ bool WS28xxDmx::SetDmxStartAddress(uint16_t nDmxStartAddress) {
 	if ((nDmxStartAddress != 0) && (nDmxStartAddress <= dmx::UNIVERSE_SIZE)) {
 		m_nDmxStartAddress = nDmxStartAddress;
 
+		// The start address is part of the plan
+		delete m_pPixelDmxPlan;
+		m_pPixelDmxPlan = new PixelDmxPlan(m_pixelDmxConfiguration, m_nChannelsPerPixel, m_PortInfo, GetSlotOffset());
+		assert(m_pPixelDmxPlan != nullptr);
+
 		if (m_pWS28xxDmxStore != nullptr) {
 			m_pWS28xxDmxStore->SaveDmxStartAddress(m_nDmxStartAddress);
 		}
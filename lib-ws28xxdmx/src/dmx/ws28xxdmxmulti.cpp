@@ -24,6 +24,8 @@
  */
 
 #include <cstdint>
+#include <cstring>
+#include <cstdio>
 #include <algorithm>
 #include <cassert>
 
@@ -33,6 +35,12 @@
 
 #include "pixeldmxparams.h"
 #include "pixeldmxconfiguration.h"
+#include "pixeldmxplan.h"
+
+#if defined (WS28XXDMXMULTI_SMP)
+# include "h3_smp.h"
+# include "h3_smp_ring.h"
+#endif
 
 #include "debug.h"
 
@@ -41,30 +49,90 @@ namespace ws28xxdmxmulti {
 # define CONFIG_PIXELDMX_MAX_PORTS	8
 #endif
 static constexpr auto MAX_PORTS = CONFIG_PIXELDMX_MAX_PORTS;
+#if defined (WS28XXDMXMULTI_SMP)
+static constexpr uint32_t SMP_RING_ITEMS = 32;
+
+/*
+ * The output is owned by the worker core. Blackout and FullOn are queued
+ * as commands, in order with the pixel data.
+ */
+enum class Command : uint32_t {
+	DATA, BLACKOUT, UPDATE, FULLON, SUSPEND, RESUME
+};
+
+struct Work {
+	Command command;
+	uint32_t nPortIndex;
+	uint32_t nLength;
+	uint32_t nFirst;
+	uint32_t nLast;
+	uint8_t Data[lightset::dmx::UNIVERSE_SIZE];
+};
+#endif
 }  // namespace ws28xxdmxmulti
 
 using namespace ws28xxdmxmulti;
 using namespace pixel;
 using namespace lightset;
 
+#if defined (WS28XXDMXMULTI_SMP)
+static struct smp_ring s_Ring;
+static Work s_Work[SMP_RING_ITEMS] __attribute__ ((aligned (64)));
+static volatile bool s_bSuspended;	///< Written by the worker core only
+#endif
+
+WS28xxDmxMulti *WS28xxDmxMulti::s_pThis;
+
 WS28xxDmxMulti::WS28xxDmxMulti(PixelDmxConfiguration& pixelDmxConfiguration): m_pixelDmxConfiguration(pixelDmxConfiguration) {
 	DEBUG_ENTRY
 
+	assert(s_pThis == nullptr);
+	s_pThis = this;
+
+#if !defined (H3)
+	// The 16-bit input and dithering are implemented for the SPI DMA output only
+	m_pixelDmxConfiguration.SetEnable16Bit(false);
+	m_pixelDmxConfiguration.SetEnableDithering(false);
+#endif
+
 	m_pixelDmxConfiguration.Validate(MAX_PORTS , m_nChannelsPerPixel, m_PortInfo);
 
 	DEBUG_PRINTF("m_PortInfo.nProtocolPortIndexLast=%u", m_PortInfo.nProtocolPortIndexLast);
 
+	m_nSlotsPerPixel = m_pixelDmxConfiguration.IsEnable16Bit() ? (2 * m_nChannelsPerPixel) : m_nChannelsPerPixel;
+
+	m_pPixelDmxPlan = new PixelDmxPlan(m_pixelDmxConfiguration, m_nSlotsPerPixel, m_PortInfo);
+	assert(m_pPixelDmxPlan != nullptr);
+
 	m_pWS28xxMulti = new WS28xxMulti(pixelDmxConfiguration);
 	assert(m_pWS28xxMulti != nullptr);
 
 	m_pWS28xxMulti->Blackout();
 
+#if defined (WS28XXDMXMULTI_SMP)
+	smp_ring_init(&s_Ring, reinterpret_cast<uint8_t *>(s_Work), sizeof(s_Work[0]), SMP_RING_ITEMS);
+
+	m_bSmp = smp_work_start(SMP_CORE, SmpWork);
+
+	if (!m_bSmp) {
+		// The pixels are rendered by the calling core
+		printf("WS28xxDmxMulti: core %u is not available\n", SMP_CORE);
+	}
+#endif
+
 	DEBUG_EXIT
 }
 
 WS28xxDmxMulti::~WS28xxDmxMulti() {
+	Suspend();
+
 	delete m_pWS28xxMulti;
 	m_pWS28xxMulti = nullptr;
+
+	delete m_pPixelDmxPlan;
+	m_pPixelDmxPlan = nullptr;
+
+	s_pThis = nullptr;
 }
 
 void WS28xxDmxMulti::Start(uint32_t nPortIndex) {
@@ -76,6 +144,7 @@ void WS28xxDmxMulti::Start(uint32_t nPortIndex) {
 		}
 	}
 	m_bIsStarted |= (1U << nPortIndex);
+	m_nRenderAll |= (1U << nPortIndex);
 }
 
 void WS28xxDmxMulti::Stop(uint32_t nPortIndex) {
@@ -93,70 +162,270 @@ void WS28xxDmxMulti::Stop(uint32_t nPortIndex) {
 }
 
 void WS28xxDmxMulti::SetData(uint32_t nPortIndex, const uint8_t* pData, uint32_t nLength) {
+	SetDataRange(nPortIndex, pData, nLength, 0, dmx::UNIVERSE_SIZE - 1);
+}
+
+void WS28xxDmxMulti::SetDataRange(uint32_t nPortIndex, const uint8_t* pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) {
 	assert(pData != nullptr);
 	assert(nLength <= dmx::UNIVERSE_SIZE);
 
-	uint32_t beginIndex, endIndex;
+	if (m_nRenderAll & (1U << nPortIndex)) {
+		m_nRenderAll &= ~(1U << nPortIndex);
+		nFirst = 0;
+		nLast = dmx::UNIVERSE_SIZE - 1;
+	}
 
-#if defined (NODE_ARTNET_MULTI)  || defined (NODE_DDP_DISPLAY)
-	const auto nOutIndex = (nPortIndex / 4);
-	const auto nSwitch = nPortIndex - (nOutIndex * 4);
+	nLast = std::min(nLast, nLength - 1);
+
+#if defined (WS28XXDMXMULTI_SMP)
+	if (__builtin_expect((!m_bSmp), 0)) {
+		Render(nPortIndex, pData, nLength, nFirst, nLast);
+		return;
+	}
+
+	Work *pWork;
+
+	while ((pWork = reinterpret_cast<Work *>(smp_ring_write_begin(&s_Ring))) == nullptr) {
+		// The worker core is behind
+	}
+
+	pWork->command = Command::DATA;
+	pWork->nPortIndex = nPortIndex;
+	pWork->nLength = nLength;
+	pWork->nFirst = nFirst;
+	pWork->nLast = nLast;
+
+	if ((nLength != 0) && (nFirst <= nLast)) {
+		// Render reads whole pixels
+		const auto nBegin = (nFirst / m_nSlotsPerPixel) * m_nSlotsPerPixel;
+		const auto nEnd = std::min(((nLast / m_nSlotsPerPixel) + 1) * m_nSlotsPerPixel, nLength);
+		memcpy(&pWork->Data[nBegin], &pData[nBegin], nEnd - nBegin);
+	}
+
+	smp_ring_write_end(&s_Ring);
 #else
-	const auto nUniverses = m_pixelDmxConfiguration.GetUniverses();
-	const auto nOutIndex = (nPortIndex / nUniverses);
-	const auto nSwitch = nPortIndex - (nOutIndex * nUniverses);
+	Render(nPortIndex, pData, nLength, nFirst, nLast);
 #endif
+}
+
+#if defined (WS28XXDMXMULTI_SMP)
+/**
+ * Runs on the worker core
+ */
+void WS28xxDmxMulti::SmpWork() {
+	if (s_bSuspended) {
+		// The output is used by the other core, only Resume is handled
+		const auto *pWork = reinterpret_cast<const Work *>(smp_ring_read_begin(&s_Ring));
+
+		if (pWork == nullptr) {
+			smp_wait_event();
+			return;
+		}
+
+		if (pWork->command == Command::RESUME) {
+			s_bSuspended = false;
+		}
+
+		smp_ring_read_end(&s_Ring);
+		return;
+	}
+
+	// The output is owned by the worker core, it starts the pending frame
+	s_pThis->m_pWS28xxMulti->Run();
 
-	const auto nGroups = m_pixelDmxConfiguration.GetGroups();
+	const auto *pWork = reinterpret_cast<const Work *>(smp_ring_read_begin(&s_Ring));
+
+	if (pWork == nullptr) {
+		if (s_pThis->m_pWS28xxMulti->IsUpdatePending()) {
+			return;
+		}
+		if (s_pThis->m_pWS28xxMulti->IsDithering() && (s_pThis->m_bIsStarted != 0) && !s_pThis->m_bBlackout) {
+			// Keep the output refreshing, each frame has the next dither thresholds
+			s_pThis->m_pWS28xxMulti->Dither();
+			return;
+		}
+		smp_wait_event();
+		return;
+	}
 
-	switch (nSwitch) {
-	case 0:
-		beginIndex = 0;
-		endIndex = std::min(nGroups, (nLength / m_nChannelsPerPixel));
+	switch (pWork->command) {
+	case Command::DATA:
+		s_pThis->Render(pWork->nPortIndex, pWork->Data, pWork->nLength, pWork->nFirst, pWork->nLast);
+		break;
+	case Command::BLACKOUT:
+		s_pThis->m_bBlackout = true;
+		s_pThis->m_pWS28xxMulti->Blackout();
 		break;
-	case 1:
-		beginIndex = m_PortInfo.nBeginIndexPortId1;
-		endIndex = std::min(nGroups, (beginIndex + (nLength / m_nChannelsPerPixel)));
+	case Command::UPDATE:
+		s_pThis->m_bBlackout = false;
+		s_pThis->m_pWS28xxMulti->Update();
 		break;
-	case 2:
-		beginIndex = m_PortInfo.nBeginIndexPortId2;
-		endIndex = std::min(nGroups, (beginIndex + (nLength / m_nChannelsPerPixel)));
+	case Command::FULLON:
+		s_pThis->m_pWS28xxMulti->FullOn();
 		break;
-	case 3:
-		beginIndex = m_PortInfo.nBeginIndexPortId3;
-		endIndex = std::min(nGroups, (beginIndex + (nLength / m_nChannelsPerPixel)));
+	case Command::SUSPEND:
+		dmb();
+		s_bSuspended = true;
+		smp_send_event();
+		break;
+	case Command::RESUME:
 		break;
 	default:
+		assert(0);
 		__builtin_unreachable();
 		break;
 	}
 
+	smp_ring_read_end(&s_Ring);
+}
+
+void WS28xxDmxMulti::SmpCommand(uint32_t nCommand) {
+	Work *pWork;
+
+	while ((pWork = reinterpret_cast<Work *>(smp_ring_write_begin(&s_Ring))) == nullptr) {
+		// The worker core is behind
+	}
+
+	pWork->command = static_cast<Command>(nCommand);
+
+	smp_ring_write_end(&s_Ring);
+}
+#endif
+
+void WS28xxDmxMulti::Suspend() {
+#if defined (WS28XXDMXMULTI_SMP)
+	if (!m_bSmp || m_bSuspended) {
+		return;
+	}
+
+	m_bSuspended = true;
+
+	SmpCommand(static_cast<uint32_t>(Command::SUSPEND));
+
+	while (!s_bSuspended) {
+		// The worker core finishes the work queued before
+	}
+
+	dmb();
+#endif
+}
+
+void WS28xxDmxMulti::Resume() {
+#if defined (WS28XXDMXMULTI_SMP)
+	if (!m_bSuspended) {
+		return;
+	}
+
+	m_bSuspended = false;
+
+	dmb();
+	SmpCommand(static_cast<uint32_t>(Command::RESUME));
+
+	// The pixel buffer has been overwritten
+	m_nRenderAll = ~0U;
+#endif
+}
+
+/**
+ * The slots nFirst..nLast (nLast < nLength) of pData are encoded into the pixel buffer.
+ */
+void WS28xxDmxMulti::Render(uint32_t nPortIndex, const uint8_t* pData, uint32_t nLength, uint32_t nFirst, uint32_t nLast) {
+
+	if ((nLength == 0) || (nFirst > nLast)) {
+		// Nothing has changed, the pixel buffer is still valid
+		if (nPortIndex == m_PortInfo.nProtocolPortIndexLast) {
+#if !defined (H3)
+			while (m_pWS28xxMulti->IsUpdating()) {
+				// wait for completion
+			}
+#endif
+			m_pWS28xxMulti->Update();
+		}
+		return;
+	}
+
+#if defined (NODE_ARTNET_MULTI)  || defined (NODE_DDP_DISPLAY)
+	const auto nOutIndex = (nPortIndex / 4);
+	const auto nUniverse = nPortIndex - (nOutIndex * 4);
+#else
+	const auto nUniverses = m_pixelDmxConfiguration.GetUniverses();
+	const auto nOutIndex = (nPortIndex / nUniverses);
+	const auto nUniverse = nPortIndex - (nOutIndex * nUniverses);
+#endif
+
+#if !defined (H3)
 	while (m_pWS28xxMulti->IsUpdating()) {
 		// wait for completion
 	}
+#endif
 
-	uint32_t d = 0;
-
+	uint32_t nRuns;
+	const auto *pRun = m_pPixelDmxPlan->GetRuns(nUniverse, nRuns);
 	const auto nGroupingCount = m_pixelDmxConfiguration.GetGroupingCount();
+#if defined (H3)
+	const auto isBulk = (nGroupingCount == 1) && m_pWS28xxMulti->IsBulkSupported(m_nChannelsPerPixel);
+#endif
+
+	for (uint32_t nRun = 0; nRun < nRuns; nRun++, pRun++) {
+		if (pRun->nSlot > nLast) {
+			break;
+		}
+
+		uint32_t nBegin, nEnd;
+
+		if (!m_pPixelDmxPlan->Clip(*pRun, nLength, nFirst, nLast, nBegin, nEnd)) {
+			continue;
+		}
 
-	if (m_nChannelsPerPixel == 3) {
-		for (uint32_t j = beginIndex; (j < endIndex) && (d < nLength); j++) {
-			auto const nPixelIndexStart = (j * nGroupingCount);
-			__builtin_prefetch(&pData[d]);
-			for (uint16_t k = 0; k < nGroupingCount; k++) {
-				m_pWS28xxMulti->SetPixel(nOutIndex, nPixelIndexStart + k, pData[d], pData[d + 1], pData[d + 2]);
+		const auto *pSlot = &pData[pRun->nSlot + nBegin * m_nSlotsPerPixel];
+		auto nGroupIndex = static_cast<int32_t>(pRun->nGroupIndex) + static_cast<int32_t>(nBegin) * pRun->nStep;
+
+#if defined (H3)
+		if (m_nSlotsPerPixel != m_nChannelsPerPixel) {
+			if ((pRun->nStep == 1) && (nGroupingCount == 1)) {
+				m_pWS28xxMulti->SetPixels16(nOutIndex, static_cast<uint32_t>(nGroupIndex), pSlot, nEnd - nBegin, m_nChannelsPerPixel);
+			} else {
+				for (auto i = nBegin; i < nEnd; i++) {
+					const auto nPixelIndexStart = static_cast<uint32_t>(nGroupIndex) * nGroupingCount;
+					for (uint32_t k = 0; k < nGroupingCount; k++) {
+						m_pWS28xxMulti->SetPixels16(nOutIndex, nPixelIndexStart + k, pSlot, 1, m_nChannelsPerPixel);
+					}
+					pSlot += m_nSlotsPerPixel;
+					nGroupIndex += pRun->nStep;
+				}
 			}
-			d = d + 3;
+			continue;
 		}
-	} else {
-		assert(m_nChannelsPerPixel == 4);
-		for (uint32_t j = beginIndex; (j < endIndex) && (d < nLength); j++) {
-			auto const nPixelIndexStart = (j * nGroupingCount);
-			__builtin_prefetch(&pData[d]);
-			for (uint16_t k = 0; k < nGroupingCount; k++) {
-				m_pWS28xxMulti->SetPixel(nOutIndex, nPixelIndexStart + k, pData[d], pData[d + 1], pData[d + 2], pData[d + 3]);
+
+		if (isBulk) {
+			if (pRun->nStep == 1) {
+				m_pWS28xxMulti->SetPixels(nOutIndex, static_cast<uint32_t>(nGroupIndex), pSlot, nEnd - nBegin, m_nChannelsPerPixel);
+			} else {
+				for (auto i = nBegin; i < nEnd; i++) {
+					m_pWS28xxMulti->SetPixels(nOutIndex, static_cast<uint32_t>(nGroupIndex), pSlot, 1, m_nChannelsPerPixel);
+					pSlot += m_nChannelsPerPixel;
+					nGroupIndex--;
+				}
+			}
+			continue;
+		}
+#endif
+
+		for (auto i = nBegin; i < nEnd; i++) {
+			const auto nPixelIndexStart = static_cast<uint32_t>(nGroupIndex) * nGroupingCount;
+			__builtin_prefetch(&pSlot[m_nChannelsPerPixel]);
+			if (m_nChannelsPerPixel == 3) {
+				for (uint32_t k = 0; k < nGroupingCount; k++) {
+					m_pWS28xxMulti->SetPixel(nOutIndex, nPixelIndexStart + k, pSlot[0], pSlot[1], pSlot[2]);
+				}
+			} else {
+				assert(m_nChannelsPerPixel == 4);
+				for (uint32_t k = 0; k < nGroupingCount; k++) {
+					m_pWS28xxMulti->SetPixel(nOutIndex, nPixelIndexStart + k, pSlot[0], pSlot[1], pSlot[2], pSlot[3]);
+				}
 			}
-			d = d + 4;
+			pSlot += m_nChannelsPerPixel;
+			nGroupIndex += pRun->nStep;
 		}
 	}
 
@@ -166,6 +435,14 @@ void WS28xxDmxMulti::SetData(uint32_t nPortIndex, const uint8_t* pData, uint32_t
 }
 
 void WS28xxDmxMulti::Blackout(bool bBlackout) {
+#if defined (WS28XXDMXMULTI_SMP)
+	if (__builtin_expect((m_bSmp), 1)) {
+		// m_bBlackout is set by the worker core, when it runs the command
+		SmpCommand(static_cast<uint32_t>(bBlackout ? Command::BLACKOUT : Command::UPDATE));
+		return;
+	}
+#endif
+
 	m_bBlackout = bBlackout;
 
 	while (m_pWS28xxMulti->IsUpdating()) {
@@ -180,6 +457,16 @@ void WS28xxDmxMulti::Blackout(bool bBlackout) {
 }
 
 void WS28xxDmxMulti::FullOn() {
+	// The pixel buffer will be overwritten
+	m_nRenderAll = ~0U;
+
+#if defined (WS28XXDMXMULTI_SMP)
+	if (__builtin_expect((m_bSmp), 1)) {
+		SmpCommand(static_cast<uint32_t>(Command::FULLON));
+		return;
+	}
+#endif
+
 	while (m_pWS28xxMulti->IsUpdating()) {
 		// wait for completion
 	}
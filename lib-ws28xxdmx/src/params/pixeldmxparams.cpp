@@ -82,6 +82,7 @@ PixelDmxParams::PixelDmxParams(PixelDmxParamsStore *pPixelDmxParamsStore): m_pPi
 	m_pixelDmxParams.nLowCode = 0;
 	m_pixelDmxParams.nHighCode = 0;
 	m_pixelDmxParams.nGammaValue = 0;
+	m_pixelDmxParams.nMatrixColumns = 0;
 
 	uint16_t nStartUniverse = 1;
 
@@ -222,6 +223,44 @@ void PixelDmxParams::callbackFunction(const char *pLine) {
 		return;
 	}
 
+	if (Sscan::Uint16(pLine, DevicesParamsConst::MATRIX_COLUMNS, nValue16) == Sscan::OK) {
+		if (nValue16 > 1 && nValue16 <= std::max(max::ledcount::RGB, max::ledcount::RGBW)) {
+			m_pixelDmxParams.nMatrixColumns = nValue16;
+			m_pixelDmxParams.nSetList |= pixeldmxparams::Mask::MATRIX_COLUMNS;
+		} else {
+			m_pixelDmxParams.nMatrixColumns = 0;
+			m_pixelDmxParams.nSetList &= ~pixeldmxparams::Mask::MATRIX_COLUMNS;
+		}
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, DevicesParamsConst::MATRIX_ZIGZAG, nValue8) == Sscan::OK) {
+		if (nValue8 != 0) {
+			m_pixelDmxParams.nSetList |= pixeldmxparams::Mask::MATRIX_ZIGZAG;
+		} else {
+			m_pixelDmxParams.nSetList &= ~pixeldmxparams::Mask::MATRIX_ZIGZAG;
+		}
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, DevicesParamsConst::INPUT_16BIT, nValue8) == Sscan::OK) {
+		if (nValue8 != 0) {
+			m_pixelDmxParams.nSetList |= pixeldmxparams::Mask::INPUT_16BIT;
+		} else {
+			m_pixelDmxParams.nSetList &= ~pixeldmxparams::Mask::INPUT_16BIT;
+		}
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, DevicesParamsConst::DITHERING, nValue8) == Sscan::OK) {
+		if (nValue8 != 0) {
+			m_pixelDmxParams.nSetList |= pixeldmxparams::Mask::DITHERING;
+		} else {
+			m_pixelDmxParams.nSetList &= ~pixeldmxparams::Mask::DITHERING;
+		}
+		return;
+	}
+
 	uint32_t nValue32;
 
 	if (Sscan::Uint32(pLine, DevicesParamsConst::SPI_SPEED_HZ, nValue32) == Sscan::OK) {
@@ -345,6 +384,10 @@ void PixelDmxParams::Builder(const struct pixeldmxparams::Params *ptWS28xxParams
 		builder.Add(DevicesParamsConst::GAMMA_VALUE, static_cast<float>(m_pixelDmxParams.nGammaValue) / 10, true);
 	}
 
+	builder.AddComment("RTZ types, 16-bit implies dithering");
+	builder.Add(DevicesParamsConst::INPUT_16BIT, isMaskSet(pixeldmxparams::Mask::INPUT_16BIT));
+	builder.Add(DevicesParamsConst::DITHERING, isMaskSet(pixeldmxparams::Mask::DITHERING));
+
 	builder.AddComment("Overwrite datasheet");
 	if (!isMaskSet(pixeldmxparams::Mask::MAP)) {
 		m_pixelDmxParams.nMap = static_cast<uint8_t>(PixelType::GetMap(static_cast<pixel::Type>(m_pixelDmxParams.nType)));
@@ -373,6 +416,10 @@ void PixelDmxParams::Builder(const struct pixeldmxparams::Params *ptWS28xxParams
 	builder.AddComment("Grouping");
 	builder.Add(DevicesParamsConst::GROUPING_COUNT, m_pixelDmxParams.nGroupingCount, isMaskSet(pixeldmxparams::Mask::GROUPING_COUNT));
 
+	builder.AddComment("Matrix");
+	builder.Add(DevicesParamsConst::MATRIX_COLUMNS, m_pixelDmxParams.nMatrixColumns, isMaskSet(pixeldmxparams::Mask::MATRIX_COLUMNS));
+	builder.Add(DevicesParamsConst::MATRIX_ZIGZAG, isMaskSet(pixeldmxparams::Mask::MATRIX_ZIGZAG));
+
 	builder.AddComment("Clock based chips");
 	builder.Add(DevicesParamsConst::SPI_SPEED_HZ, m_pixelDmxParams.nSpiSpeedHz, isMaskSet(pixeldmxparams::Mask::SPI_SPEED));
 
@@ -448,6 +495,9 @@ void PixelDmxParams::Set(PixelDmxConfiguration *pPixelDmxConfiguration) {
 		}
 	}
 
+	pPixelDmxConfiguration->SetEnable16Bit(isMaskSet(pixeldmxparams::Mask::INPUT_16BIT));
+	pPixelDmxConfiguration->SetEnableDithering(isMaskSet(pixeldmxparams::Mask::DITHERING));
+
 	// Dmx
 
 	if (isMaskSet(pixeldmxparams::Mask::DMX_START_ADDRESS)) {
@@ -458,6 +508,12 @@ void PixelDmxParams::Set(PixelDmxConfiguration *pPixelDmxConfiguration) {
 		pPixelDmxConfiguration->SetGroupingCount(m_pixelDmxParams.nGroupingCount);
 	}
 
+	if (isMaskSet(pixeldmxparams::Mask::MATRIX_COLUMNS)) {
+		pPixelDmxConfiguration->SetMatrixColumns(m_pixelDmxParams.nMatrixColumns);
+	}
+
+	pPixelDmxConfiguration->SetMatrixZigZag(isMaskSet(pixeldmxparams::Mask::MATRIX_ZIGZAG));
+
 #if defined (PARAMS_INLCUDE_ALL) || defined(OUTPUT_DMX_PIXEL_MULTI)
 	if (isMaskSet(pixeldmxparams::Mask::ACTIVE_OUT)) {
 		pPixelDmxConfiguration->SetOutputPorts(m_pixelDmxParams.nActiveOutputs);
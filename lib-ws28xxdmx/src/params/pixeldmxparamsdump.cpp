@@ -81,6 +81,14 @@ void PixelDmxParams::Dump() {
 		printf(" %s=%d\n", DevicesParamsConst::GROUPING_COUNT, m_pixelDmxParams.nGroupingCount);
 	}
 
+	if (isMaskSet(Mask::MATRIX_COLUMNS)) {
+		printf(" %s=%d\n", DevicesParamsConst::MATRIX_COLUMNS, m_pixelDmxParams.nMatrixColumns);
+	}
+
+	if (isMaskSet(Mask::MATRIX_ZIGZAG)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::MATRIX_ZIGZAG);
+	}
+
 	if (isMaskSet(Mask::SPI_SPEED)) {
 		printf(" %s=%d\n", DevicesParamsConst::SPI_SPEED_HZ, m_pixelDmxParams.nSpiSpeedHz);
 	}
@@ -101,5 +109,13 @@ void PixelDmxParams::Dump() {
 		printf(" %s=1 [Yes]\n", DevicesParamsConst::GAMMA_CORRECTION);
 		printf(" %s=%1.1f [%u]\n", DevicesParamsConst::GAMMA_VALUE, static_cast<float>(m_pixelDmxParams.nGammaValue) / 10, m_pixelDmxParams.nGammaValue);
 	}
+
+	if (isMaskSet(Mask::INPUT_16BIT)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::INPUT_16BIT);
+	}
+
+	if (isMaskSet(Mask::DITHERING)) {
+		printf(" %s=1 [Yes]\n", DevicesParamsConst::DITHERING);
+	}
 #endif
 }
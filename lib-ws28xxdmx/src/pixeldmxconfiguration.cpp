@@ -65,12 +65,29 @@ void PixelDmxConfiguration::Validate(uint32_t nPortsMax, uint32_t& nLedsPerPixel
 		portInfo.nBeginIndexPortId3 = 510;
 	}
 
+	if (IsEnable16Bit()) {
+		// Two slots per colour component
+		portInfo.nBeginIndexPortId1 /= 2;
+		portInfo.nBeginIndexPortId2 /= 2;
+		portInfo.nBeginIndexPortId3 /= 2;
+
+		const auto nCountMax = portInfo.nBeginIndexPortId3 + portInfo.nBeginIndexPortId1;
+
+		if (GetCount() > nCountMax) {
+			SetCount(nCountMax);
+		}
+	}
+
 	if ((m_nGroupingCount == 0) || (m_nGroupingCount > GetCount())) {
 		m_nGroupingCount = GetCount();
 	}
 
 	m_nGroups = GetCount() / m_nGroupingCount;
 
+	if (m_nMatrixColumns > m_nGroups) {
+		m_nMatrixColumns = 0;
+	}
+
 	m_nOutputPorts = std::min(nPortsMax, m_nOutputPorts);
 	m_nUniverses = (1U + (m_nGroups  / (1U + portInfo.nBeginIndexPortId1)));
 
@@ -96,4 +113,8 @@ void PixelDmxConfiguration::Print() {
 	printf("Pixel DMX configuration\n");
 	printf(" Outputs : %d\n", m_nOutputPorts);
 	printf(" Grouping count : %d [Groups : %d]\n", m_nGroupingCount, m_nGroups);
+
+	if (m_nMatrixColumns != 0) {
+		printf(" Matrix columns : %d%s\n", m_nMatrixColumns, m_bMatrixZigZag ? " [Zig-zag]" : "");
+	}
 }
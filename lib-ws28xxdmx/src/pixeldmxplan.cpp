@@ -0,0 +1,179 @@
+/**
+ * @file pixeldmxplan.cpp
+ *
+ */
+/* Copyright (C) 2022 by Arjan van Vught mailto:info@orangepi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <cassert>
+
+#include "pixeldmxplan.h"
+#include "pixeldmxconfiguration.h"
+
+#include "lightset.h"
+
+#include "debug.h"
+
+using namespace pixeldmxplan;
+
+PixelDmxPlan::PixelDmxPlan(const PixelDmxConfiguration& pixelDmxConfiguration, uint32_t nSlotsPerPixel, const pixeldmxconfiguration::PortInfo& portInfo, uint32_t nSlotOffset):
+	m_nSlotsPerPixel(nSlotsPerPixel),
+	m_nGroups(pixelDmxConfiguration.GetGroups()),
+	m_nUniverses(std::min(MAX_UNIVERSES, pixelDmxConfiguration.GetUniverses())),
+	m_nSlotOffset(nSlotOffset),
+	m_nMatrixColumns(pixelDmxConfiguration.GetMatrixColumns()),
+	m_bMatrixZigZag(pixelDmxConfiguration.IsMatrixZigZag())
+{
+	DEBUG_ENTRY
+
+	assert((nSlotsPerPixel == 3) || (nSlotsPerPixel == 4) || (nSlotsPerPixel == 6) || (nSlotsPerPixel == 8));
+	assert(nSlotOffset < lightset::dmx::UNIVERSE_SIZE);
+
+	m_nBeginIndex[0] = 0;
+	m_nBeginIndex[1] = portInfo.nBeginIndexPortId1;
+	m_nBeginIndex[2] = portInfo.nBeginIndexPortId2;
+	m_nBeginIndex[3] = portInfo.nBeginIndexPortId3;
+
+	if (m_nMatrixColumns == 0) {
+		m_nMatrixColumns = m_nGroups;
+	}
+
+	// The first pass only counts the runs
+	const auto nRuns = Build(nullptr);
+
+	m_pRuns = new Run[nRuns];
+	assert(m_pRuns != nullptr);
+
+	Build(m_pRuns);
+
+	DEBUG_PRINTF("nRuns=%u", nRuns);
+	DEBUG_EXIT
+}
+
+PixelDmxPlan::~PixelDmxPlan() {
+	delete[] m_pRuns;
+	m_pRuns = nullptr;
+}
+
+/**
+ * The group that is driven by logical group nGroup.
+ * The logical groups fill the matrix row by row, with zig-zag wiring every odd row runs backwards.
+ * Returns m_nGroups when the position does not exist in an incomplete last row.
+ */
+uint32_t PixelDmxPlan::GetGroupIndex(uint32_t nGroup) const {
+	if (!m_bMatrixZigZag) {
+		return nGroup;
+	}
+
+	const auto nRow = nGroup / m_nMatrixColumns;
+
+	if ((nRow & 0x1) == 0) {
+		return nGroup;
+	}
+
+	const auto nColumn = nGroup - (nRow * m_nMatrixColumns);
+	const auto nGroupIndex = (nRow * m_nMatrixColumns) + (m_nMatrixColumns - 1U - nColumn);
+
+	return std::min(nGroupIndex, m_nGroups);
+}
+
+/**
+ * Consecutive pixels of a universe that go to consecutive groups, in either direction, are merged into one run.
+ * With pRuns == nullptr the runs are only counted.
+ */
+uint32_t PixelDmxPlan::Build(Run *pRuns) {
+	uint32_t nRuns = 0;
+
+	for (uint32_t nUniverse = 0; nUniverse < MAX_UNIVERSES; nUniverse++) {
+		m_nRunIndex[nUniverse] = nRuns;
+
+		if (nUniverse >= m_nUniverses) {
+			continue;
+		}
+
+		const auto nSlotOffset = (nUniverse == 0) ? m_nSlotOffset : 0;
+		const auto nBegin = m_nBeginIndex[nUniverse];
+		const auto nEnd = std::min(m_nGroups, nBegin + ((lightset::dmx::UNIVERSE_SIZE - nSlotOffset) / m_nSlotsPerPixel));
+
+		Run run;
+		bool bIsOpen = false;
+
+		for (auto nGroup = nBegin; nGroup < nEnd; nGroup++) {
+			const auto nGroupIndex = GetGroupIndex(nGroup);
+
+			if (nGroupIndex >= m_nGroups) {
+				if (bIsOpen) {
+					if (pRuns != nullptr) {
+						pRuns[nRuns] = run;
+					}
+					nRuns++;
+					bIsOpen = false;
+				}
+				continue;
+			}
+
+			if (bIsOpen) {
+				const auto nLastGroupIndex = static_cast<int32_t>(run.nGroupIndex) + (static_cast<int32_t>(run.nPixels) - 1) * run.nStep;
+				const auto nStep = static_cast<int32_t>(nGroupIndex) - nLastGroupIndex;
+
+				if ((nStep == run.nStep) || ((run.nPixels == 1) && ((nStep == 1) || (nStep == -1)))) {
+					run.nStep = static_cast<int16_t>(nStep);
+					run.nPixels++;
+					continue;
+				}
+
+				if (pRuns != nullptr) {
+					pRuns[nRuns] = run;
+				}
+				nRuns++;
+			}
+
+			run.nSlot = static_cast<uint16_t>(nSlotOffset + (nGroup - nBegin) * m_nSlotsPerPixel);
+			run.nGroupIndex = static_cast<uint16_t>(nGroupIndex);
+			run.nPixels = 1;
+			run.nStep = 1;
+			bIsOpen = true;
+		}
+
+		if (bIsOpen) {
+			if (pRuns != nullptr) {
+				pRuns[nRuns] = run;
+			}
+			nRuns++;
+		}
+	}
+
+	m_nRunIndex[MAX_UNIVERSES] = nRuns;
+
+	return nRuns;
+}
+
+void PixelDmxPlan::Print() {
+	printf("Pixel DMX plan\n");
+
+	for (uint32_t nUniverse = 0; nUniverse < m_nUniverses; nUniverse++) {
+		printf(" Universe %u : %u runs\n", nUniverse, m_nRunIndex[nUniverse + 1] - m_nRunIndex[nUniverse]);
+	}
+}
@@ -188,10 +188,15 @@ void notmain(void) {
 			for (uint32_t nPortIndex = 0; nPortIndex < artnetnode::MAX_PORTS; nPortIndex++) {
 				uint8_t nAddress;
 				if (node.GetUniverseSwitch(nPortIndex, nAddress, lightset::PortDir::OUTPUT)) {
-					pDiscovery->Full(nPortIndex);
+					pDiscovery->Discovery(nPortIndex, false);
 				}
 			}
 
+			while (pDiscovery->IsDiscoveryRunning()) {
+				hw.WatchdogFeed();
+				pDiscovery->Run();
+			}
+
 			node.SetRdmHandler(pDiscovery);
 		}
 	}
@@ -94,6 +94,7 @@
 using namespace artnet;
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	WS28xxMulti::Get()->Blackout();
 	Dmx::Get()->Blackout();
 	ArtNet4Node::Get()->Stop();
@@ -186,8 +187,14 @@ void notmain(void) {
 	}
 
 	const auto nTestPattern = static_cast<pixelpatterns::Pattern>(pixelDmxParams.GetTestPattern());
+	// The test pattern writes the pixels from this core
+	pixelDmxMulti.Suspend();
 	PixelTestPattern pixelTestPattern(nTestPattern, nActivePorts);
 
+	if (PixelTestPattern::GetPattern() == pixelpatterns::Pattern::NONE) {
+		pixelDmxMulti.Resume();
+	}
+
 	// LightSet B - DMX - 2 Universes
 
 	const auto nAddress = static_cast<uint16_t>((artnetParams.GetNet() & 0x7F) << 8) | static_cast<uint16_t>((artnetParams.GetSubnet() & 0x0F) << 4);
@@ -343,6 +350,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		node.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 #if defined (NODE_RDMNET_LLRP_ONLY)
 		llrpOnlyDevice.Run();
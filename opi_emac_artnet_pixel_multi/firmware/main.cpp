@@ -83,6 +83,7 @@
 #include "software_version.h"
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	ArtNet4Node::Get()->Stop();
 	WS28xxMulti::Get()->Blackout();
 }
@@ -177,7 +178,13 @@ void notmain(void) {
 	}
 
 	const auto nTestPattern = static_cast<pixelpatterns::Pattern>(pixelDmxParams.GetTestPattern());
+	// The test pattern writes the pixels from this core
+	pixelDmxMulti.Suspend();
 	PixelTestPattern pixelTestPattern(nTestPattern, nActivePorts);
+
+	if (PixelTestPattern::GetPattern() == pixelpatterns::Pattern::NONE) {
+		pixelDmxMulti.Resume();
+	}
 	
 	if (PixelTestPattern::GetPattern() != pixelpatterns::Pattern::NONE) {
 		node.SetOutput(nullptr);
@@ -282,6 +289,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		node.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 #if defined (NODE_RDMNET_LLRP_ONLY)
 		llrpOnlyDevice.Run();
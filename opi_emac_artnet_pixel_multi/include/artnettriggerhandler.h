@@ -30,6 +30,7 @@
 
 #include "pixelpatterns.h"
 #include "pixeltestpattern.h"
+#include "ws28xxdmxmulti.h"
 #include "displayudf.h"
 #include "artnetnode.h"
 #include "lightset.h"
@@ -49,9 +50,15 @@ public:
 			if (nShow == PixelTestPattern::Get()->GetPattern()) {
 				return;
 			}
+			// The test pattern writes the pixels from this core
+			WS28xxDmxMulti::Get()->Suspend();
+
 			const auto isSet = PixelTestPattern::Get()->SetPattern(nShow);
 
 			if(!isSet) {
+				if (PixelTestPattern::Get()->GetPattern() == pixelpatterns::Pattern::NONE) {
+					WS28xxDmxMulti::Get()->Resume();
+				}
 				return;
 			}
 
@@ -60,6 +67,7 @@ public:
 				Display::Get()->ClearLine(6);
 				Display::Get()->Printf(6, "%s:%u", PixelPatterns::GetName(nShow), static_cast<uint32_t>(nShow));
 			} else {
+				WS28xxDmxMulti::Get()->Resume();
 				m_pLightSet->Blackout(true);
 				ArtNetNode::Get()->SetOutput(m_pLightSet);
 				DisplayUdf::Get()->Show();
@@ -88,6 +88,7 @@
 #include "software_version.h"
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	WS28xxMulti::Get()->Blackout();
 	DdpDisplay::Get()->Stop();
 }
@@ -151,11 +152,17 @@ void notmain(void) {
 
 	const auto nActivePorts = pixelDmxMulti.GetOutputPorts();
 
-	ddpDisplay.SetCount(pixelDmxMulti.GetGroups(), pixelDmxMulti.GetChannelsPerPixel(), nActivePorts);
+	ddpDisplay.SetCount(pixelDmxMulti.GetGroups(), pixelDmxMulti.GetSlotsPerPixel(), nActivePorts);
 
 	const auto nTestPattern = static_cast<pixelpatterns::Pattern>(pixelDmxParams.GetTestPattern());
+	// The test pattern writes the pixels from this core
+	pixelDmxMulti.Suspend();
 	PixelTestPattern pixelTestPattern(nTestPattern, nActivePorts);
 
+	if (PixelTestPattern::GetPattern() == pixelpatterns::Pattern::NONE) {
+		pixelDmxMulti.Resume();
+	}
+
 	// LightSet B - DMX - 2 Universes
 
 	StoreDmxSend storeDmxSend;
@@ -273,6 +280,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		ddpDisplay.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
 		if (__builtin_expect((PixelTestPattern::GetPattern() != pixelpatterns::Pattern::NONE), 0)) {
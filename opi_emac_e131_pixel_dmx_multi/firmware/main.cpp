@@ -92,6 +92,7 @@
 #include "software_version.h"
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	WS28xxMulti::Get()->Blackout();
 	Dmx::Get()->Blackout();
 	E131Bridge::Get()->Stop();
@@ -180,8 +181,14 @@ void notmain(void) {
 	}
 
 	const auto nTestPattern = static_cast<pixelpatterns::Pattern>(pixelDmxParams.GetTestPattern());
+	// The test pattern writes the pixels from this core
+	pixelDmxMulti.Suspend();
 	PixelTestPattern pixelTestPattern(nTestPattern, nActivePorts);
 
+	if (PixelTestPattern::GetPattern() == pixelpatterns::Pattern::NONE) {
+		pixelDmxMulti.Resume();
+	}
+
 	// LightSet B - DMX - 2 Universes
 
 	auto bIsSet = false;
@@ -321,6 +328,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		bridge.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
 		if (__builtin_expect((PixelTestPattern::GetPattern() != pixelpatterns::Pattern::NONE), 0)) {
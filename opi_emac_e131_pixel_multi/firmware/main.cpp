@@ -82,6 +82,7 @@
 #include "software_version.h"
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	WS28xxMulti::Get()->Blackout();
 	E131Bridge::Get()->Stop();
 }
@@ -171,6 +172,8 @@ void notmain(void) {
 	PixelTestPattern *pPixelTestPattern = nullptr;
 
 	if (nTestPattern != pixelpatterns::Pattern::NONE) {
+		// The test pattern writes the pixels from this core
+		pixelDmxMulti.Suspend();
 		pPixelTestPattern = new PixelTestPattern(nTestPattern, nActivePorts);
 		bridge.SetOutput(nullptr);
 	} else {
@@ -269,6 +272,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		bridge.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 #if defined (NODE_RDMNET_LLRP_ONLY)
 		llrpOnlyDevice.Run();
@@ -203,6 +203,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		server.Run();
+		pixelDmx.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
 		if (__builtin_expect((PixelTestPattern::GetPattern() != pixelpatterns::Pattern::NONE), 0)) {
@@ -81,6 +81,7 @@
 #include "software_version.h"
 
 void Hardware::RebootHandler() {
+	WS28xxDmxMulti::Get()->Suspend();
 	WS28xxMulti::Get()->Blackout();
 	PixelPusher::Get()->Stop();
 }
@@ -145,8 +146,14 @@ void notmain(void) {
 	pp.SetCount(pixelDmxMulti.GetGroups(), nActivePorts, false);
 
 	const auto nTestPattern = static_cast<pixelpatterns::Pattern>(pixelDmxParams.GetTestPattern());
+	// The test pattern writes the pixels from this core
+	pixelDmxMulti.Suspend();
 	PixelTestPattern pixelTestPattern(nTestPattern, nActivePorts);
 
+	if (PixelTestPattern::GetPattern() == pixelpatterns::Pattern::NONE) {
+		pixelDmxMulti.Resume();
+	}
+
 	pixelDmxMulti.Print();
 
 	pp.SetOutput(&pixelDmxMulti);
@@ -242,6 +249,7 @@ void notmain(void) {
 		hw.WatchdogFeed();
 		nw.Run();
 		pp.Run();
+		pixelDmxMulti.Run();
 		remoteConfig.Run();
 		spiFlashStore.Flash();
 		if (__builtin_expect((PixelTestPattern::GetPattern() != pixelpatterns::Pattern::NONE), 0)) {
@@ -42,6 +42,7 @@
 #include "showfileprotocolartnet.h"
 // Format handlers
 #include "olashowfile.h"
+#include "binaryshowfile.h"
 
 #include "reboot.h"
 
@@ -114,8 +115,9 @@ void notmain(void) {
 	ShowFile *pShowFile = nullptr;
 
 	switch (showFileParams.GetFormat()) {
-//		case SHOWFILE_FORMAT_:
-//			break;
+		case showfile::Formats::BINARY:
+			pShowFile = new BinaryShowFile;
+			break;
 		default:
 			pShowFile = new OlaShowFile;
 			break;
@@ -245,6 +245,7 @@ void notmain(void) {
 	for (;;) {
 		hw.WatchdogFeed();
 		rdmResponder.Run();
+		pixelDmx.Run();
 		spiFlashStore.Flash();
 #if !defined(NO_EMAC)
 		nw.Run();